@@ -85,6 +85,9 @@ using quentier::FilterBySavedSearchWidget;
 #include <lib/widget/LogViewerWidget.h>
 using quentier::LogViewerWidget;
 
+#include <lib/widget/ModelDiagnosticsWidget.h>
+using quentier::ModelDiagnosticsWidget;
+
 #include <lib/widget/AboutQuentierWidget.h>
 #include <lib/widget/NotebookModelItemInfoWidget.h>
 #include <lib/widget/SavedSearchModelItemInfoWidget.h>
@@ -116,6 +119,8 @@ using quentier::LogViewerWidget;
 #include <QFile>
 #include <QFocusEvent>
 #include <QFontDatabase>
+#include <QJsonArray>
+#include <QJsonObject>
 #include <QKeySequence>
 #include <QIcon>
 #include <QLabel>
@@ -246,6 +251,7 @@ MainWindow::MainWindow(QWidget * pParentWidget) :
                                  FavoritesModel::Columns::DisplayName, this)),
     m_pDeletedNotesModel(nullptr),
     m_pFavoritesModel(nullptr),
+    m_pNoteIndex(nullptr),
     m_blankModel(),
     m_pNoteFiltersManager(nullptr),
     m_setDefaultAccountsFirstNoteAsCurrentDelayTimerId(0),
@@ -568,6 +574,10 @@ void MainWindow::connectActionsToSlots()
                      this, QNSLOT(MainWindow,onShowNoteSource));
     QObject::connect(m_pUI->ActionViewLogs, QNSIGNAL(QAction,triggered),
                      this, QNSLOT(MainWindow,onViewLogsActionTriggered));
+    QObject::connect(m_pUI->ActionViewModelDiagnostics,
+                     QNSIGNAL(QAction,triggered),
+                     this,
+                     QNSLOT(MainWindow,onViewModelDiagnosticsActionTriggered));
     QObject::connect(m_pUI->ActionAbout, QNSIGNAL(QAction,triggered),
                      this,
                      QNSLOT(MainWindow,onShowInfoAboutQuentierActionTriggered));
@@ -720,6 +730,12 @@ void MainWindow::connectToPreferencesDialogSignals(PreferencesDialog & dialog)
         this,
         &MainWindow::onRunSyncEachNumMinitesPreferenceChanged);
 
+    QObject::connect(
+        &dialog,
+        &PreferencesDialog::itemCachesMaxSizesChanged,
+        this,
+        &MainWindow::onItemCachesMaxSizesPreferenceChanged);
+
     QObject::connect(
         &dialog,
         &PreferencesDialog::noteEditorFontColorChanged,
@@ -3015,6 +3031,12 @@ void MainWindow::onDisableNativeMenuBarPreferenceChanged()
     setupDisableNativeMenuBarPreference();
 }
 
+void MainWindow::onItemCachesMaxSizesPreferenceChanged()
+{
+    QNDEBUG("MainWindow::onItemCachesMaxSizesPreferenceChanged");
+    setupItemCaches();
+}
+
 void MainWindow::onRunSyncEachNumMinitesPreferenceChanged(
     int runSyncEachNumMinutes)
 {
@@ -3192,6 +3214,79 @@ void MainWindow::onViewLogsActionTriggered()
     pLogViewerWidget->show();
 }
 
+void MainWindow::onViewModelDiagnosticsActionTriggered()
+{
+    QNDEBUG("MainWindow::onViewModelDiagnosticsActionTriggered");
+
+    ModelDiagnosticsWidget * pWidget = findChild<ModelDiagnosticsWidget*>();
+    if (pWidget) {
+        pWidget->setDiagnostics(modelDiagnostics());
+        pWidget->raise();
+        return;
+    }
+
+    pWidget = new ModelDiagnosticsWidget(this);
+    pWidget->setAttribute(Qt::WA_DeleteOnClose);
+
+    QObject::connect(pWidget,
+                     QNSIGNAL(ModelDiagnosticsWidget,refreshRequested),
+                     this,
+                     QNSLOT(MainWindow,onModelDiagnosticsRefreshRequested));
+    QObject::connect(pWidget,
+                     QNSIGNAL(ModelDiagnosticsWidget,resetRequested),
+                     this,
+                     QNSLOT(MainWindow,onModelDiagnosticsResetRequested));
+
+    pWidget->setDiagnostics(modelDiagnostics());
+    pWidget->show();
+}
+
+void MainWindow::onModelDiagnosticsRefreshRequested()
+{
+    QNDEBUG("MainWindow::onModelDiagnosticsRefreshRequested");
+
+    ModelDiagnosticsWidget * pWidget = findChild<ModelDiagnosticsWidget*>();
+    if (pWidget) {
+        pWidget->setDiagnostics(modelDiagnostics());
+    }
+}
+
+void MainWindow::onModelDiagnosticsResetRequested()
+{
+    QNDEBUG("MainWindow::onModelDiagnosticsResetRequested");
+
+    if (m_pNoteModel) {
+        m_pNoteModel->resetInstrumentation();
+    }
+
+    if (m_pDeletedNotesModel) {
+        m_pDeletedNotesModel->resetInstrumentation();
+    }
+
+    if (m_pFavoritesModel) {
+        m_pFavoritesModel->resetInstrumentation();
+    }
+
+    if (m_pNotebookModel) {
+        m_pNotebookModel->resetInstrumentation();
+    }
+
+    if (m_pTagModel) {
+        m_pTagModel->resetInstrumentation();
+    }
+
+    if (m_pSavedSearchModel) {
+        m_pSavedSearchModel->resetInstrumentation();
+    }
+
+    m_noteCache.resetStats();
+    m_notebookCache.resetStats();
+    m_tagCache.resetStats();
+    m_savedSearchCache.resetStats();
+
+    onModelDiagnosticsRefreshRequested();
+}
+
 void MainWindow::onShowInfoAboutQuentierActionTriggered()
 {
     QNDEBUG("MainWindow::onShowInfoAboutQuentierActionTriggered");
@@ -3803,10 +3898,7 @@ void MainWindow::onLocalStorageSwitchUserRequestComplete(
         return;
     }
 
-    m_notebookCache.clear();
-    m_tagCache.clear();
-    m_savedSearchCache.clear();
-    m_noteCache.clear();
+    clearItemCaches();
 
     if (m_geometryAndStatePersistingDelayTimerId != 0) {
         killTimer(m_geometryAndStatePersistingDelayTimerId);
@@ -4625,22 +4717,28 @@ void MainWindow::setupModels()
     QNDEBUG("MainWindow::setupModels");
 
     clearModels();
+    setupItemCaches();
 
     NoteModel::NoteSortingMode::type noteSortingMode = restoreNoteSortingMode();
     if (noteSortingMode == NoteModel::NoteSortingMode::None) {
         noteSortingMode = NoteModel::NoteSortingMode::ModifiedDescending;
     }
 
+    m_pNoteIndex = new NoteIndexAsync(*m_pLocalStorageManagerAsync);
+    m_pNoteIndex->moveToThread(m_pLocalStorageManagerAsync->thread());
+
     m_pNoteModel = new NoteModel(*m_pAccount, *m_pLocalStorageManagerAsync,
                                  m_noteCache, m_notebookCache, this,
                                  NoteModel::IncludedNotes::NonDeleted,
-                                 noteSortingMode);
+                                 noteSortingMode, nullptr, m_pNoteIndex);
+    m_pNoteModel->setWindowedMode(true);
     m_pFavoritesModel = new FavoritesModel(*m_pAccount,
                                            *m_pLocalStorageManagerAsync,
                                            m_noteCache, m_notebookCache,
-                                           m_tagCache, m_savedSearchCache, this);
+                                           m_tagCache, m_savedSearchCache, this,
+                                           m_pNoteIndex);
     m_pNotebookModel = new NotebookModel(*m_pAccount, *m_pLocalStorageManagerAsync,
-                                         m_notebookCache, this);
+                                         m_notebookCache, this, m_pNoteIndex);
     m_pTagModel = new TagModel(*m_pAccount, *m_pLocalStorageManagerAsync,
                                m_tagCache, this);
     m_pSavedSearchModel = new SavedSearchModel(*m_pAccount,
@@ -4649,7 +4747,9 @@ void MainWindow::setupModels()
     m_pDeletedNotesModel = new NoteModel(*m_pAccount,
                                          *m_pLocalStorageManagerAsync,
                                          m_noteCache, m_notebookCache, this,
-                                         NoteModel::IncludedNotes::Deleted);
+                                         NoteModel::IncludedNotes::Deleted,
+                                         NoteModel::NoteSortingMode::ModifiedAscending,
+                                         nullptr, m_pNoteIndex);
     m_pDeletedNotesModel->start();
 
     if (m_pNoteCountLabelController == nullptr) {
@@ -4715,6 +4815,132 @@ void MainWindow::clearModels()
         delete m_pFavoritesModel;
         m_pFavoritesModel = nullptr;
     }
+
+    if (m_pNoteIndex) {
+        m_pNoteIndex->deleteLater();
+        m_pNoteIndex = nullptr;
+    }
+}
+
+void MainWindow::setupItemCaches()
+{
+    QNDEBUG("MainWindow::setupItemCaches");
+
+    ApplicationSettings appSettings(*m_pAccount, QUENTIER_AUXILIARY_SETTINGS);
+    appSettings.beginGroup(ITEM_CACHES_SETTINGS_GROUP_NAME);
+
+    quint64 noteCacheMaxSize = itemCacheMaxSizeInBytes(
+        appSettings.value(NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY),
+        NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY,
+        DEFAULT_NOTE_CACHE_MAX_SIZE_KB);
+
+    quint64 notebookCacheMaxSize = itemCacheMaxSizeInBytes(
+        appSettings.value(NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY),
+        NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY,
+        DEFAULT_NOTEBOOK_CACHE_MAX_SIZE_KB);
+
+    quint64 tagCacheMaxSize = itemCacheMaxSizeInBytes(
+        appSettings.value(TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY),
+        TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY,
+        DEFAULT_TAG_CACHE_MAX_SIZE_KB);
+
+    quint64 savedSearchCacheMaxSize = itemCacheMaxSizeInBytes(
+        appSettings.value(SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY),
+        SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY,
+        DEFAULT_SAVED_SEARCH_CACHE_MAX_SIZE_KB);
+
+    appSettings.endGroup();
+
+    // NOTE: the count limits the caches were created with are kept: the byte
+    // budgets only bound the memory taken by the large items, like the notes
+    // with big resources, so that a few of them don't take all the memory
+    m_noteCache.setLimits(m_noteCache.maxItems(), noteCacheMaxSize);
+    m_notebookCache.setLimits(m_notebookCache.maxItems(), notebookCacheMaxSize);
+    m_tagCache.setLimits(m_tagCache.maxItems(), tagCacheMaxSize);
+    m_savedSearchCache.setLimits(m_savedSearchCache.maxItems(),
+                                 savedSearchCacheMaxSize);
+}
+
+quint64 MainWindow::itemCacheMaxSizeInBytes(
+    const QVariant & maxSizeInKbData, const QString & settingsKey,
+    const int defaultMaxSizeInKb) const
+{
+    bool conversionResult = false;
+    int maxSizeInKb = maxSizeInKbData.toInt(&conversionResult);
+    if (!conversionResult || (maxSizeInKb <= 0))
+    {
+        QNDEBUG("No valid persisted max size for " << settingsKey
+                << ", fallback to the default value of "
+                << defaultMaxSizeInKb << " Kb");
+        maxSizeInKb = defaultMaxSizeInKb;
+    }
+
+    return static_cast<quint64>(maxSizeInKb) * 1024;
+}
+
+void MainWindow::clearItemCaches()
+{
+    QNDEBUG("MainWindow::clearItemCaches");
+
+    QNDEBUG("Note cache: " << m_noteCache.stats());
+    QNDEBUG("Notebook cache: " << m_notebookCache.stats());
+    QNDEBUG("Tag cache: " << m_tagCache.stats());
+    QNDEBUG("Saved search cache: " << m_savedSearchCache.stats());
+
+    m_notebookCache.clear();
+    m_tagCache.clear();
+    m_savedSearchCache.clear();
+    m_noteCache.clear();
+
+    m_notebookCache.resetStats();
+    m_tagCache.resetStats();
+    m_savedSearchCache.resetStats();
+    m_noteCache.resetStats();
+}
+
+QJsonObject MainWindow::modelDiagnostics() const
+{
+    QJsonArray models;
+
+    if (m_pNoteModel) {
+        models.append(m_pNoteModel->instrumentation().toJson());
+    }
+
+    if (m_pDeletedNotesModel)
+    {
+        QJsonObject object = m_pDeletedNotesModel->instrumentation().toJson();
+        object[QStringLiteral("model")] =
+            QStringLiteral("NoteModel (deleted notes)");
+        models.append(object);
+    }
+
+    if (m_pFavoritesModel) {
+        models.append(m_pFavoritesModel->instrumentation().toJson());
+    }
+
+    if (m_pNotebookModel) {
+        models.append(m_pNotebookModel->instrumentation().toJson());
+    }
+
+    if (m_pTagModel) {
+        models.append(m_pTagModel->instrumentation().toJson());
+    }
+
+    if (m_pSavedSearchModel) {
+        models.append(m_pSavedSearchModel->instrumentation().toJson());
+    }
+
+    QJsonObject caches;
+    caches[QStringLiteral("Note")] = m_noteCache.stats().toJson();
+    caches[QStringLiteral("Notebook")] = m_notebookCache.stats().toJson();
+    caches[QStringLiteral("Tag")] = m_tagCache.stats().toJson();
+    caches[QStringLiteral("SavedSearch")] =
+        m_savedSearchCache.stats().toJson();
+
+    QJsonObject diagnostics;
+    diagnostics[QStringLiteral("models")] = models;
+    diagnostics[QStringLiteral("caches")] = caches;
+    return diagnostics;
 }
 
 void MainWindow::setupShowHideStartupSettings()
@@ -5023,6 +5249,7 @@ void MainWindow::setupViews()
     }
 
     pNoteListView->setNotebookItemView(pNotebooksTreeView);
+    pNoteListView->setTagItemView(m_pUI->tagsTreeView);
     QObject::connect(m_pNoteModelColumnChangeRerouter,
                      &ColumnChangeRerouter::dataChanged,
                      pNoteListView,
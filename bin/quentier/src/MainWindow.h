@@ -292,6 +292,7 @@ private Q_SLOTS:
     void onShowNoteThumbnailsPreferenceChanged();
     void onDisableNativeMenuBarPreferenceChanged();
     void onRunSyncEachNumMinitesPreferenceChanged(int runSyncEachNumMinutes);
+    void onItemCachesMaxSizesPreferenceChanged();
 
     void onPanelFontColorChanged(QColor color);
     void onPanelBackgroundColorChanged(QColor color);
@@ -309,6 +310,9 @@ private Q_SLOTS:
     void onHideRequestedFromTrayIcon();
 
     void onViewLogsActionTriggered();
+    void onViewModelDiagnosticsActionTriggered();
+    void onModelDiagnosticsRefreshRequested();
+    void onModelDiagnosticsResetRequested();
     void onShowInfoAboutQuentierActionTriggered();
 
     void onNoteEditorError(ErrorString error);
@@ -382,6 +386,14 @@ private:
     void setupModels();
     void clearModels();
 
+    void setupItemCaches();
+    quint64 itemCacheMaxSizeInBytes(
+        const QVariant & maxSizeInKbData, const QString & settingsKey,
+        const int defaultMaxSizeInKb) const;
+    void clearItemCaches();
+
+    QJsonObject modelDiagnostics() const;
+
     void setupShowHideStartupSettings();
     void setupViews();
     void clearViews();
@@ -559,6 +571,11 @@ private:
     NoteModel *             m_pDeletedNotesModel;
     FavoritesModel *        m_pFavoritesModel;
 
+    // Shared by the note models, the notebook model and the favorites model
+    // so that the notes are indexed only once; lives in the local storage
+    // thread
+    NoteIndexAsync *        m_pNoteIndex;
+
     QStandardItemModel      m_blankModel;
 
     NoteFiltersManager *    m_pNoteFiltersManager;
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FavoritedItemsListerAsync.h"
+#include "NoteSummaryListerAsync.h"
+
+#include <quentier/local_storage/LocalStorageManager.h>
+#include <quentier/logging/QuentierLogger.h>
+
+namespace quentier {
+
+FavoritedItemsListerAsync::FavoritedItemsListerAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        NoteIndexAsync * pNoteIndex, QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_pNoteIndex(pNoteIndex)
+{}
+
+FavoritedItemsListerAsync::~FavoritedItemsListerAsync()
+{}
+
+void FavoritedItemsListerAsync::onListFavoritedItemsRequest(QUuid requestId)
+{
+    QNDEBUG("FavoritedItemsListerAsync::onListFavoritedItemsRequest: "
+            << "request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Note> notes = pLocalStorageManager->listNotes(
+        LocalStorageManager::ListObjectsOption::ListFavoritedElements,
+        NoteSummaryListerAsync::noteSummaryOptions(), errorDescription,
+        0, 0, LocalStorageManager::ListNotesOrder::NoOrder,
+        LocalStorageManager::OrderDirection::Ascending, QString());
+    if (notes.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list favorited notes: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Notebook> notebooks =
+        pLocalStorageManager->listAllNotebooks(errorDescription);
+    if (notebooks.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list notebooks: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Tag> tags = pLocalStorageManager->listAllTags(errorDescription);
+    if (tags.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list tags: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<SavedSearch> savedSearches =
+        pLocalStorageManager->listAllSavedSearches(errorDescription);
+    if (savedSearches.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list saved searches: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QHash<QString, int> noteCountsPerNotebookLocalUid;
+    QHash<QString, int> noteCountsPerTagLocalUid;
+    if (!countNotesPerFavoritedItems(*pLocalStorageManager, notebooks, tags,
+                                     noteCountsPerNotebookLocalUid,
+                                     noteCountsPerTagLocalUid,
+                                     errorDescription))
+    {
+        QNWARNING("Failed to count notes per favorited notebooks and tags: "
+                  << errorDescription << ", request id = " << requestId);
+        Q_EMIT listFavoritedItemsFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<NoteModelItem> noteSummaries =
+        NoteSummaryListerAsync::notesToSummaries(notes);
+
+    QNTRACE("Listed " << noteSummaries.size() << " favorited notes, "
+            << notebooks.size() << " notebooks, " << tags.size()
+            << " tags and " << savedSearches.size()
+            << " saved searches, request id = " << requestId);
+
+    Q_EMIT listFavoritedItemsComplete(noteSummaries, notebooks, tags,
+                                      savedSearches,
+                                      noteCountsPerNotebookLocalUid,
+                                      noteCountsPerTagLocalUid, requestId);
+}
+
+LocalStorageManager * FavoritedItemsListerAsync::localStorageManager(
+    ErrorString & errorDescription)
+{
+    LocalStorageManager * pLocalStorageManager =
+        m_localStorageManagerAsync.localStorageManager();
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        errorDescription.setBase(QT_TR_NOOP("Can't list favorited items: "
+                                            "local storage is not "
+                                            "initialized yet"));
+        QNWARNING(errorDescription);
+    }
+
+    return pLocalStorageManager;
+}
+
+bool FavoritedItemsListerAsync::countNotesPerFavoritedItems(
+    LocalStorageManager & localStorageManager,
+    const QList<Notebook> & notebooks, const QList<Tag> & tags,
+    QHash<QString, int> & noteCountsPerNotebookLocalUid,
+    QHash<QString, int> & noteCountsPerTagLocalUid,
+    ErrorString & errorDescription)
+{
+    for(auto it = notebooks.constBegin(), end = notebooks.constEnd();
+        it != end; ++it)
+    {
+        if (it->isFavorited()) {
+            noteCountsPerNotebookLocalUid[it->localUid()] = 0;
+        }
+    }
+
+    for(auto it = tags.constBegin(), end = tags.constEnd(); it != end; ++it)
+    {
+        if (it->isFavorited()) {
+            noteCountsPerTagLocalUid[it->localUid()] = 0;
+        }
+    }
+
+    LocalStorageManager::NoteCountOptions options(
+        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+
+    if (!m_pNoteIndex.isNull() &&
+        m_pNoteIndex->countNotes(options, noteCountsPerNotebookLocalUid,
+                                 noteCountsPerTagLocalUid, false))
+    {
+        return true;
+    }
+
+    for(auto it = noteCountsPerNotebookLocalUid.begin(),
+        end = noteCountsPerNotebookLocalUid.end(); it != end; ++it)
+    {
+        Notebook notebook;
+        notebook.setLocalUid(it.key());
+
+        int noteCount = localStorageManager.noteCountPerNotebook(
+            notebook, errorDescription, options);
+        if (noteCount < 0) {
+            return false;
+        }
+
+        it.value() = noteCount;
+    }
+
+    for(auto it = noteCountsPerTagLocalUid.begin(),
+        end = noteCountsPerTagLocalUid.end(); it != end; ++it)
+    {
+        Tag tag;
+        tag.setLocalUid(it.key());
+
+        int noteCount = localStorageManager.noteCountPerTag(
+            tag, errorDescription, options);
+        if (noteCount < 0) {
+            return false;
+        }
+
+        it.value() = noteCount;
+    }
+
+    return true;
+}
+
+} // namespace quentier
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_FAVORITED_ITEMS_LISTER_ASYNC_H
+#define QUENTIER_LIB_MODEL_FAVORITED_ITEMS_LISTER_ASYNC_H
+
+#include "NoteIndexAsync.h"
+#include "NoteModelItem.h"
+
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/types/Notebook.h>
+#include <quentier/types/SavedSearch.h>
+#include <quentier/types/Tag.h>
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The FavoritedItemsListerAsync class lists the favorites model's items
+ * of all kinds along with their note counts within a single request
+ *
+ * The object is meant to live in the same thread as LocalStorageManagerAsync
+ * and uses the LocalStorageManager owned by the latter directly. If the note
+ * index is given and built, the notes are counted using the index instead
+ * of the local storage.
+ */
+class FavoritedItemsListerAsync: public QObject
+{
+    Q_OBJECT
+public:
+    explicit FavoritedItemsListerAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        NoteIndexAsync * pNoteIndex = nullptr,
+        QObject * parent = nullptr);
+
+    virtual ~FavoritedItemsListerAsync();
+
+Q_SIGNALS:
+    void listFavoritedItemsComplete(
+        QList<NoteModelItem> noteSummaries, QList<Notebook> notebooks,
+        QList<Tag> tags, QList<SavedSearch> savedSearches,
+        QHash<QString, int> noteCountsPerNotebookLocalUid,
+        QHash<QString, int> noteCountsPerTagLocalUid, QUuid requestId);
+
+    void listFavoritedItemsFailed(ErrorString errorDescription, QUuid requestId);
+
+public Q_SLOTS:
+    /**
+     * @brief onListFavoritedItemsRequest - lists everything the favorites
+     * model needs within a single request: summaries of favorited notes,
+     * all notebooks, tags and saved searches (the favorites model needs
+     * the non-favorited ones too for their names and restrictions) and
+     * the counts of non-deleted notes per favorited notebooks and tags
+     */
+    void onListFavoritedItemsRequest(QUuid requestId);
+
+private:
+    LocalStorageManager * localStorageManager(ErrorString & errorDescription);
+
+    bool countNotesPerFavoritedItems(
+        LocalStorageManager & localStorageManager,
+        const QList<Notebook> & notebooks, const QList<Tag> & tags,
+        QHash<QString, int> & noteCountsPerNotebookLocalUid,
+        QHash<QString, int> & noteCountsPerTagLocalUid,
+        ErrorString & errorDescription);
+
+private:
+    Q_DISABLE_COPY(FavoritedItemsListerAsync)
+
+private:
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+
+    // Might be shared with other objects and deleted before this one
+    QPointer<NoteIndexAsync>    m_pNoteIndex;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_FAVORITED_ITEMS_LISTER_ASYNC_H
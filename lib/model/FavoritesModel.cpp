@@ -22,12 +22,6 @@
 
 #include <algorithm>
 
-// Limit for the queries to the local storage
-#define NOTE_LIST_LIMIT (40)
-#define NOTEBOOK_LIST_LIMIT (40)
-#define TAG_LIST_LIMIT (40)
-#define SAVED_SEARCH_LIST_LIMIT (40)
-
 #define NUM_FAVORITES_MODEL_COLUMNS (3)
 
 namespace quentier {
@@ -37,7 +31,8 @@ FavoritesModel::FavoritesModel(
         LocalStorageManagerAsync & localStorageManagerAsync,
         NoteCache & noteCache, NotebookCache & notebookCache,
         TagCache & tagCache, SavedSearchCache & savedSearchCache,
-        QObject * parent) :
+        QObject * parent,
+        NoteIndexAsync * pNoteIndex) :
     QAbstractItemModel(parent),
     m_account(account),
     m_data(),
@@ -45,17 +40,13 @@ FavoritesModel::FavoritesModel(
     m_notebookCache(notebookCache),
     m_tagCache(tagCache),
     m_savedSearchCache(savedSearchCache),
+    m_instrumentation(QStringLiteral("FavoritesModel")),
     m_lowerCaseNotebookNames(),
     m_lowerCaseTagNames(),
     m_lowerCaseSavedSearchNames(),
-    m_listNotesOffset(0),
-    m_listNotesRequestId(),
-    m_listNotebooksOffset(0),
-    m_listNotebooksRequestId(),
-    m_listTagsOffset(0),
-    m_listTagsRequestId(),
-    m_listSavedSearchesOffset(0),
-    m_listSavedSearchesRequestId(),
+    m_pFavoritedItemsLister(
+        new FavoritedItemsListerAsync(localStorageManagerAsync, pNoteIndex)),
+    m_listFavoritedItemsRequestId(),
     m_updateNoteRequestIds(),
     m_findNoteToRestoreFailedUpdateRequestIds(),
     m_findNoteToPerformUpdateRequestIds(),
@@ -81,16 +72,18 @@ FavoritesModel::FavoritesModel(
     m_sortOrder(Qt::AscendingOrder),
     m_allItemsListed(false)
 {
+    m_pFavoritedItemsLister->moveToThread(localStorageManagerAsync.thread());
+
     createConnections(localStorageManagerAsync);
 
-    requestNotebooksList();
-    requestTagsList();
-    requestNotesList();
-    requestSavedSearchesList();
+    requestFavoritedItemsList();
 }
 
 FavoritesModel::~FavoritesModel()
-{}
+{
+    m_pFavoritedItemsLister->disconnect(this);
+    m_pFavoritedItemsLister->deleteLater();
+}
 
 void FavoritesModel::updateAccount(const Account & account)
 {
@@ -666,10 +659,8 @@ void FavoritesModel::sort(int column, Qt::SortOrder order)
         localUidsToUpdateWithColumns << std::pair<QString, int>(item.localUid(), column);
     }
 
-    std::vector<boost::reference_wrapper<const FavoritesModelItem> > items(rowIndex.begin(),
-                                                                           rowIndex.end());
-    std::sort(items.begin(), items.end(), Comparator(m_sortedColumn, m_sortOrder));
-    rowIndex.rearrange(items.begin());
+    // Sorting the random access index in place, without copying the items
+    rowIndex.sort(Comparator(m_sortedColumn, m_sortOrder));
 
     QModelIndexList replacementIndices;
     replacementIndices.reserve(std::max(localUidsToUpdateWithColumns.size(), 0));
@@ -701,6 +692,8 @@ void FavoritesModel::sort(int column, Qt::SortOrder order)
 
 void FavoritesModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onAddNoteComplete: note = " << note
             << "\nRequest id = " << requestId);
     onNoteAddedOrUpdated(note);
@@ -709,6 +702,8 @@ void FavoritesModel::onAddNoteComplete(Note note, QUuid requestId)
 void FavoritesModel::onUpdateNoteComplete(
     Note note, LocalStorageManager::UpdateNoteOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onUpdateNoteComplete: note = " << note
             << "\nUpdate resource metadata = "
             << ((options & LocalStorageManager::UpdateNoteOption::UpdateResourceMetadata)
@@ -802,6 +797,8 @@ void FavoritesModel::onUpdateNoteFailed(
     Note note, LocalStorageManager::UpdateNoteOptions options,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateNoteRequestIds.find(requestId);
     if (it == m_updateNoteRequestIds.end()) {
         return;
@@ -831,12 +828,16 @@ void FavoritesModel::onUpdateNoteFailed(
             << note.localUid() << ", request id = " << requestId);
     LocalStorageManager::GetNoteOptions getNoteOptions(
         LocalStorageManager::GetNoteOption::WithResourceMetadata);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNote"), requestId);
     Q_EMIT findNote(note, getNoteOptions, requestId);
 }
 
 void FavoritesModel::onFindNoteComplete(
     Note note, LocalStorageManager::GetNoteOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNoteToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNoteToUnfavoriteRequestIds.find(requestId);
@@ -887,6 +888,8 @@ void FavoritesModel::onFindNoteFailed(
     Note note, LocalStorageManager::GetNoteOptions options,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNoteToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNoteToUnfavoriteRequestIds.find(requestId);
@@ -923,88 +926,10 @@ void FavoritesModel::onFindNoteFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
-void FavoritesModel::onListNotesComplete(
-    LocalStorageManager::ListObjectsOptions flag,
-    LocalStorageManager::GetNoteOptions options,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, QList<Note> foundNotes, QUuid requestId)
-{
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListNotesComplete: flag = " << flag
-            << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = " << linkedNotebookGuid
-            << ", num found notes = " << foundNotes.size()
-            << ", request id = " << requestId);
-
-    for(auto it = foundNotes.begin(), end = foundNotes.end(); it != end; ++it) {
-        onNoteAddedOrUpdated(*it);
-    }
-
-    m_listNotesRequestId = QUuid();
-
-    if (!foundNotes.isEmpty()) {
-        QNTRACE("The number of found notes is greater than zero, "
-                "requesting more notes from the local storage");
-        m_listNotesOffset += static_cast<size_t>(foundNotes.size());
-        requestNotesList();
-        return;
-    }
-
-    checkAllItemsListed();
-}
-
-void FavoritesModel::onListNotesFailed(
-    LocalStorageManager::ListObjectsOptions flag,
-    LocalStorageManager::GetNoteOptions options,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
-{
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListNotesFailed: flag = " << flag
-            << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = " << linkedNotebookGuid
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
-
-    m_listNotesRequestId = QUuid();
-
-    Q_EMIT notifyError(errorDescription);
-}
-
 void FavoritesModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onExpungeNoteComplete: note = "
             << note << "\nRequest id = " << requestId);
 
@@ -1018,6 +943,8 @@ void FavoritesModel::onExpungeNoteComplete(Note note, QUuid requestId)
 
 void FavoritesModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onAddNotebookComplete: notebook = "
             << notebook << ", request id = " << requestId);
     onNotebookAddedOrUpdated(notebook);
@@ -1025,6 +952,8 @@ void FavoritesModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 
 void FavoritesModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onUpdateNotebookComplete: notebook = "
             << notebook << ", request id = " << requestId);
 
@@ -1040,6 +969,8 @@ void FavoritesModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId
 void FavoritesModel::onUpdateNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateNotebookRequestIds.find(requestId);
     if (it == m_updateNotebookRequestIds.end()) {
         return;
@@ -1055,11 +986,15 @@ void FavoritesModel::onUpdateNotebookFailed(
     Q_UNUSED(m_findNotebookToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE("Emitting the request to find a notebook: local uid = "
             << notebook.localUid() << ", request id = " << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNotebook"), requestId);
     Q_EMIT findNotebook(notebook, requestId);
 }
 
 void FavoritesModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNotebookToUnfavoriteRequestIds.find(requestId);
@@ -1100,6 +1035,8 @@ void FavoritesModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 void FavoritesModel::onFindNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt = m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findNotebookToUnfavoriteRequestIds.find(requestId);
@@ -1128,79 +1065,10 @@ void FavoritesModel::onFindNotebookFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
-void FavoritesModel::onListNotebooksComplete(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotebooksOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, QList<Notebook> foundNotebooks,
-    QUuid requestId)
-{
-    if (requestId != m_listNotebooksRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListNotebooksComplete: flag = "
-            << flag << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = "
-            << (linkedNotebookGuid.isNull()
-                ? QStringLiteral("<null>")
-                : linkedNotebookGuid)
-            << ", num found notebooks = " << foundNotebooks.size()
-            << ", request id = " << requestId);
-
-    for(auto it = foundNotebooks.begin(),
-        end = foundNotebooks.end(); it != end; ++it)
-    {
-        onNotebookAddedOrUpdated(*it);
-    }
-
-    m_listNotebooksRequestId = QUuid();
-
-    if (!foundNotebooks.isEmpty()) {
-        QNTRACE("The number of found notebooks is greater than zero, "
-                "requesting more notebooks from the local storage");
-        m_listNotebooksOffset += static_cast<size_t>(foundNotebooks.size());
-        requestNotebooksList();
-        return;
-    }
-
-    checkAllItemsListed();
-}
-
-void FavoritesModel::onListNotebooksFailed(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotebooksOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
-{
-    if (requestId != m_listNotebooksRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListNotebooksFailed: flag = "
-            << flag << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = "
-            << (linkedNotebookGuid.isNull()
-                ? QStringLiteral("<null>")
-                : linkedNotebookGuid)
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
-
-    m_listNotebooksRequestId = QUuid();
-
-    Q_EMIT notifyError(errorDescription);
-}
-
 void FavoritesModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onExpungeNotebookComplete: notebook = "
             << notebook << "\nRequest id = " << requestId);
     removeItemByLocalUid(notebook.localUid());
@@ -1208,6 +1076,8 @@ void FavoritesModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestI
 
 void FavoritesModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onAddTagComplete: tag = " << tag
             << "\nRequest id = " << requestId);
     onTagAddedOrUpdated(tag);
@@ -1215,6 +1085,8 @@ void FavoritesModel::onAddTagComplete(Tag tag, QUuid requestId)
 
 void FavoritesModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onUpdateTagComplete: tag = " << tag
             << "\nRequest id = " << requestId);
 
@@ -1230,6 +1102,8 @@ void FavoritesModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 void FavoritesModel::onUpdateTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateTagRequestIds.find(requestId);
     if (it == m_updateTagRequestIds.end()) {
         return;
@@ -1245,11 +1119,14 @@ void FavoritesModel::onUpdateTagFailed(
     Q_UNUSED(m_findTagToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE("Emitting the request to find a tag: local uid = "
             << tag.localUid() << ", request id = " << requestId);
+    m_instrumentation.recordRequestIssued(QStringLiteral("findTag"), requestId);
     Q_EMIT findTag(tag, requestId);
 }
 
 void FavoritesModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findTagToUnfavoriteRequestIds.find(requestId);
@@ -1290,6 +1167,8 @@ void FavoritesModel::onFindTagComplete(Tag tag, QUuid requestId)
 void FavoritesModel::onFindTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findTagToUnfavoriteRequestIds.find(requestId);
@@ -1318,77 +1197,11 @@ void FavoritesModel::onFindTagFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
-void FavoritesModel::onListTagsComplete(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListTagsOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, QList<Tag> foundTags, QUuid requestId)
-{
-    if (requestId != m_listTagsRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListTagsComplete: flag = " << flag
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = "
-            << (linkedNotebookGuid.isNull()
-                ? QStringLiteral("<null>")
-                : linkedNotebookGuid)
-            << ", num found tags = " << foundTags.size()
-            << ", request id = " << requestId);
-
-    for(auto it = foundTags.begin(), end = foundTags.end(); it != end; ++it) {
-        onTagAddedOrUpdated(*it);
-    }
-
-    m_listTagsRequestId = QUuid();
-
-    if (!foundTags.isEmpty()) {
-        QNTRACE("The number of found tags is greater than zero, "
-                "requesting more tags from the local storage");
-        m_listTagsOffset += static_cast<size_t>(foundTags.size());
-        requestTagsList();
-        return;
-    }
-
-    checkAllItemsListed();
-}
-
-void FavoritesModel::onListTagsFailed(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListTagsOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
-{
-    if (requestId != m_listTagsRequestId) {
-        return;
-    }
-
-    QNDEBUG("FavoritesModel::onListTagsFailed: flag = " << flag
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = "
-            << (linkedNotebookGuid.isNull()
-                ? QStringLiteral("<null>")
-                : linkedNotebookGuid)
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
-
-    m_listTagsRequestId = QUuid();
-
-    Q_EMIT notifyError(errorDescription);
-}
-
 void FavoritesModel::onExpungeTagComplete(
     Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onExpungeTagComplete: tag = "
             << tag << "\nExpunged child tag local uids: "
             << expungedChildTagLocalUids.join(QStringLiteral(", "))
@@ -1406,6 +1219,8 @@ void FavoritesModel::onExpungeTagComplete(
 void FavoritesModel::onAddSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onAddSavedSearchComplete: "
             << search << "\nRequest id = " << requestId);
     onSavedSearchAddedOrUpdated(search);
@@ -1414,6 +1229,8 @@ void FavoritesModel::onAddSavedSearchComplete(
 void FavoritesModel::onUpdateSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("FavoritesModel::onUpdateSavedSearchComplete: "
             << search << "\nRequest id = " << requestId);
 
@@ -1429,6 +1246,8 @@ void FavoritesModel::onUpdateSavedSearchComplete(
 void FavoritesModel::onUpdateSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateSavedSearchRequestIds.find(requestId);
     if (it == m_updateSavedSearchRequestIds.end()) {
         return;
@@ -1444,12 +1263,16 @@ void FavoritesModel::onUpdateSavedSearchFailed(
     Q_UNUSED(m_findSavedSearchToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE("Emitting the request to find the saved search: local uid = "
             << search.localUid() << ", request id = " << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findSavedSearch"), requestId);
     Q_EMIT findSavedSearch(search, requestId);
 }
 
 void FavoritesModel::onFindSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findSavedSearchToUnfavoriteRequestIds.find(requestId);
@@ -1490,6 +1313,8 @@ void FavoritesModel::onFindSavedSearchComplete(
 void FavoritesModel::onFindSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt = m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findSavedSearchToPerformUpdateRequestIds.find(requestId);
     auto unfavoriteIt = m_findSavedSearchToUnfavoriteRequestIds.find(requestId);
@@ -1518,81 +1343,190 @@ void FavoritesModel::onFindSavedSearchFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
-void FavoritesModel::onListSavedSearchesComplete(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListSavedSearchesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QList<SavedSearch> foundSearches, QUuid requestId)
+void FavoritesModel::onExpungeSavedSearchComplete(
+    SavedSearch search, QUuid requestId)
+{
+    m_instrumentation.recordRequestCompleted(requestId);
+
+    QNDEBUG("FavoritesModel::onExpungeSavedSearchComplete: search = "
+            << search << "\nRequest id = " << requestId);
+    removeItemByLocalUid(search.localUid());
+}
+
+void FavoritesModel::onListFavoritedItemsComplete(
+    QList<NoteModelItem> noteSummaries, QList<Notebook> notebooks,
+    QList<Tag> tags, QList<SavedSearch> savedSearches,
+    QHash<QString, int> noteCountsPerNotebookLocalUid,
+    QHash<QString, int> noteCountsPerTagLocalUid, QUuid requestId)
 {
-    if (requestId != m_listSavedSearchesRequestId) {
+    m_instrumentation.recordRequestCompleted(requestId);
+
+    if (requestId != m_listFavoritedItemsRequestId) {
         return;
     }
 
-    QNDEBUG("FavoritesModel::onListSavedSearchesComplete: flag = "
-            << flag << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", num found searches = " << foundSearches.size()
+    QNDEBUG("FavoritesModel::onListFavoritedItemsComplete: "
+            << "num favorited notes = " << noteSummaries.size()
+            << ", num notebooks = " << notebooks.size()
+            << ", num tags = " << tags.size()
+            << ", num saved searches = " << savedSearches.size()
             << ", request id = " << requestId);
 
-    for(auto it = foundSearches.begin(),
-        end = foundSearches.end(); it != end; ++it)
+    m_listFavoritedItemsRequestId = QUuid();
+
+    // Items which have been added to the model while the listing was
+    // in progress are kept unless the listing says otherwise
+    QHash<QString, FavoritesModelItem> itemsByLocalUid;
+    const FavoritesDataByIndex & rowIndex = m_data.get<ByIndex>();
+    itemsByLocalUid.reserve(static_cast<int>(rowIndex.size()) +
+                            noteSummaries.size());
+    for(auto it = rowIndex.begin(), end = rowIndex.end(); it != end; ++it) {
+        itemsByLocalUid[it->localUid()] = *it;
+    }
+
+    for(auto it = noteSummaries.constBegin(),
+        end = noteSummaries.constEnd(); it != end; ++it)
     {
-        onSavedSearchAddedOrUpdated(*it);
+        const NoteModelItem & summary = *it;
+        if (summary.notebookLocalUid().isEmpty()) {
+            QNWARNING("Skipping the note not having the notebook local uid: "
+                      << summary);
+            continue;
+        }
+
+        if (!summary.isFavorited()) {
+            Q_UNUSED(itemsByLocalUid.remove(summary.localUid()))
+            continue;
+        }
+
+        m_notebookLocalUidByNoteLocalUid[summary.localUid()] =
+            summary.notebookLocalUid();
+
+        FavoritesModelItem item;
+        noteSummaryToItem(summary, item);
+        itemsByLocalUid[summary.localUid()] = item;
     }
 
-    m_listSavedSearchesRequestId = QUuid();
+    for(auto it = notebooks.constBegin(),
+        end = notebooks.constEnd(); it != end; ++it)
+    {
+        const Notebook & notebook = *it;
+        m_notebookCache.put(notebook.localUid(), notebook);
+        updateNotebookRestrictionsData(notebook);
 
-    if (!foundSearches.isEmpty()) {
-        QNTRACE("The number of found saved searches is not empty, "
-                "requesting more saved searches from the local storage");
-        m_listSavedSearchesOffset += static_cast<size_t>(foundSearches.size());
-        requestSavedSearchesList();
-        return;
+        if (notebook.hasName()) {
+            Q_UNUSED(m_lowerCaseNotebookNames.insert(notebook.name().toLower()))
+        }
+
+        if (!notebook.hasName() || !notebook.isFavorited()) {
+            Q_UNUSED(itemsByLocalUid.remove(notebook.localUid()))
+            continue;
+        }
+
+        FavoritesModelItem & item = itemsByLocalUid[notebook.localUid()];
+        item.setType(FavoritesModelItem::Type::Notebook);
+        item.setLocalUid(notebook.localUid());
+        item.setNumNotesTargeted(
+            noteCountsPerNotebookLocalUid.value(notebook.localUid(), -1));
+        item.setDisplayName(notebook.name());
+    }
+
+    for(auto it = tags.constBegin(), end = tags.constEnd(); it != end; ++it)
+    {
+        const Tag & tag = *it;
+        m_tagCache.put(tag.localUid(), tag);
+
+        if (!tag.hasName()) {
+            Q_UNUSED(itemsByLocalUid.remove(tag.localUid()))
+            continue;
+        }
+
+        Q_UNUSED(m_lowerCaseTagNames.insert(tag.name().toLower()))
+
+        if (!tag.isFavorited()) {
+            Q_UNUSED(itemsByLocalUid.remove(tag.localUid()))
+            continue;
+        }
+
+        FavoritesModelItem & item = itemsByLocalUid[tag.localUid()];
+        item.setType(FavoritesModelItem::Type::Tag);
+        item.setLocalUid(tag.localUid());
+        item.setNumNotesTargeted(
+            noteCountsPerTagLocalUid.value(tag.localUid(), -1));
+        item.setDisplayName(tag.name());
     }
 
-    checkAllItemsListed();
+    for(auto it = savedSearches.constBegin(),
+        end = savedSearches.constEnd(); it != end; ++it)
+    {
+        const SavedSearch & search = *it;
+        m_savedSearchCache.put(search.localUid(), search);
+
+        if (!search.hasName()) {
+            Q_UNUSED(itemsByLocalUid.remove(search.localUid()))
+            continue;
+        }
+
+        Q_UNUSED(m_lowerCaseSavedSearchNames.insert(search.name().toLower()))
+
+        if (!search.isFavorited()) {
+            Q_UNUSED(itemsByLocalUid.remove(search.localUid()))
+            continue;
+        }
+
+        FavoritesModelItem & item = itemsByLocalUid[search.localUid()];
+        item.setType(FavoritesModelItem::Type::SavedSearch);
+        item.setLocalUid(search.localUid());
+        item.setNumNotesTargeted(-1);
+        item.setDisplayName(search.name());
+    }
+
+    std::vector<FavoritesModelItem> items;
+    items.reserve(static_cast<size_t>(itemsByLocalUid.size()));
+    for(auto it = itemsByLocalUid.constBegin(),
+        end = itemsByLocalUid.constEnd(); it != end; ++it)
+    {
+        items.push_back(it.value());
+    }
+
+    std::sort(items.begin(), items.end(),
+              Comparator(m_sortedColumn, m_sortOrder));
+
+    beginResetModel();
+    m_data.clear();
+    FavoritesDataByIndex & mutableRowIndex = m_data.get<ByIndex>();
+    mutableRowIndex.insert(mutableRowIndex.end(), items.begin(), items.end());
+    endResetModel();
+
+    QNDEBUG("Listed all favorites model's items");
+    m_allItemsListed = true;
+    Q_EMIT notifyAllItemsListed();
 }
 
-void FavoritesModel::onListSavedSearchesFailed(
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListSavedSearchesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
+void FavoritesModel::onListFavoritedItemsFailed(
     ErrorString errorDescription, QUuid requestId)
 {
-    if (requestId != m_listSavedSearchesRequestId) {
+    m_instrumentation.recordRequestFailed(requestId);
+
+    if (requestId != m_listFavoritedItemsRequestId) {
         return;
     }
 
-    QNDEBUG("FavoritesModel::onListSavedSearchesFailed: flag = "
-            << flag << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", error: " << errorDescription
-            << ", request id = " << requestId);
+    QNDEBUG("FavoritesModel::onListFavoritedItemsFailed: error description = "
+            << errorDescription << ", request id = " << requestId);
 
-    m_listSavedSearchesRequestId = QUuid();
+    m_listFavoritedItemsRequestId = QUuid();
 
     Q_EMIT notifyError(errorDescription);
 }
 
-void FavoritesModel::onExpungeSavedSearchComplete(
-    SavedSearch search, QUuid requestId)
-{
-    QNDEBUG("FavoritesModel::onExpungeSavedSearchComplete: search = "
-            << search << "\nRequest id = " << requestId);
-    removeItemByLocalUid(search.localUid());
-}
-
 void FavoritesModel::onGetNoteCountPerNotebookComplete(
     int noteCount, Notebook notebook,
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_notebookLocalUidToNoteCountRequestIdBimap.right.find(requestId);
@@ -1625,6 +1559,8 @@ void FavoritesModel::onGetNoteCountPerNotebookFailed(
     ErrorString errorDescription, Notebook notebook,
     LocalStorageManager::NoteCountOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_notebookLocalUidToNoteCountRequestIdBimap.right.find(requestId);
@@ -1648,6 +1584,8 @@ void FavoritesModel::onGetNoteCountPerTagComplete(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_tagLocalUidToNoteCountRequestIdBimap.right.find(requestId);
@@ -1681,6 +1619,8 @@ void FavoritesModel::onGetNoteCountPerTagFailed(
     Tag tag, LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_tagLocalUidToNoteCountRequestIdBimap.right.find(requestId);
@@ -1718,18 +1658,10 @@ void FavoritesModel::createConnections(
                      QNSLOT(LocalStorageManagerAsync,onFindNoteRequest,
                             Note,LocalStorageManager::GetNoteOptions,QUuid));
     QObject::connect(this,
-                     QNSIGNAL(FavoritesModel,listNotes,
-                              LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QUuid),
-                     &localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,onListNotesRequest,
-                            LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,QString,QUuid));
+                     QNSIGNAL(FavoritesModel,listFavoritedItems,QUuid),
+                     m_pFavoritedItemsLister,
+                     QNSLOT(FavoritedItemsListerAsync,
+                            onListFavoritedItemsRequest,QUuid));
     QObject::connect(this,
                      QNSIGNAL(FavoritesModel,updateNotebook,Notebook,QUuid),
                      &localStorageManagerAsync,
@@ -1740,18 +1672,6 @@ void FavoritesModel::createConnections(
                      &localStorageManagerAsync,
                      QNSLOT(LocalStorageManagerAsync,onFindNotebookRequest,
                             Notebook,QUuid));
-    QObject::connect(this,
-                     QNSIGNAL(FavoritesModel,listNotebooks,
-                              LocalStorageManager::ListObjectsOptions,size_t,
-                              size_t,LocalStorageManager::ListNotebooksOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QUuid),
-                     &localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,onListNotebooksRequest,
-                            LocalStorageManager::ListObjectsOptions,size_t,
-                            size_t,LocalStorageManager::ListNotebooksOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QUuid));
     QObject::connect(this,
                      QNSIGNAL(FavoritesModel,updateTag,Tag,QUuid),
                      &localStorageManagerAsync,
@@ -1761,18 +1681,6 @@ void FavoritesModel::createConnections(
                      QNSIGNAL(FavoritesModel,findTag,Tag,QUuid),
                      &localStorageManagerAsync,
                      QNSLOT(LocalStorageManagerAsync,onFindTagRequest,Tag,QUuid));
-    QObject::connect(this,
-                     QNSIGNAL(FavoritesModel,listTags,
-                              LocalStorageManager::ListObjectsOptions,size_t,
-                              size_t,LocalStorageManager::ListTagsOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QUuid),
-                     &localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,onListTagsRequest,
-                            LocalStorageManager::ListObjectsOptions,size_t,
-                            size_t,LocalStorageManager::ListTagsOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QUuid));
     QObject::connect(this,
                      QNSIGNAL(FavoritesModel,updateSavedSearch,SavedSearch,QUuid),
                      &localStorageManagerAsync,
@@ -1783,16 +1691,6 @@ void FavoritesModel::createConnections(
                      &localStorageManagerAsync,
                      QNSLOT(LocalStorageManagerAsync,onFindSavedSearchRequest,
                             SavedSearch,QUuid));
-    QObject::connect(this,
-                     QNSIGNAL(FavoritesModel,listSavedSearches,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListSavedSearchesOrder,
-                              LocalStorageManager::OrderDirection,QUuid),
-                     &localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,onListSavedSearchesRequest,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListSavedSearchesOrder,
-                            LocalStorageManager::OrderDirection,QUuid));
     QObject::connect(this,
                      QNSIGNAL(FavoritesModel,noteCountPerNotebook,
                               Notebook,LocalStorageManager::NoteCountOptions,QUuid),
@@ -1852,35 +1750,6 @@ void FavoritesModel::createConnections(
                      QNSLOT(FavoritesModel,onFindNoteFailed,
                             Note,LocalStorageManager::GetNoteOptions,
                             ErrorString,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotesComplete,
-                              LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QList<Note>,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListNotesComplete,
-                            LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,
-                            size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QList<Note>,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotesFailed,
-                              LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,ErrorString,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListNotesFailed,
-                            LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,ErrorString,QUuid));
     QObject::connect(&localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,expungeNoteComplete,
                               Note,QUuid),
@@ -1913,30 +1782,6 @@ void FavoritesModel::createConnections(
                      this,
                      QNSLOT(FavoritesModel,onFindNotebookFailed,
                             Notebook,ErrorString,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotebooksComplete,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListNotebooksOrder,
-                              LocalStorageManager::OrderDirection,QString,
-                              QList<Notebook>,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListNotebooksComplete,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListNotebooksOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QList<Notebook>,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotebooksFailed,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListNotebooksOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,ErrorString,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListNotebooksFailed,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListNotebooksOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,ErrorString,QUuid));
     QObject::connect(&localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,expungeNotebookComplete,
                               Notebook,QUuid),
@@ -1966,30 +1811,6 @@ void FavoritesModel::createConnections(
                               Tag,ErrorString,QUuid),
                      this,
                      QNSLOT(FavoritesModel,onFindTagFailed,Tag,ErrorString,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listTagsComplete,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListTagsOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QList<Tag>,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListTagsComplete,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListTagsOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QList<Tag>,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listTagsFailed,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListTagsOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,ErrorString,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListTagsFailed,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListTagsOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,ErrorString,QUuid));
     QObject::connect(&localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,expungeTagComplete,
                               Tag,QStringList,QUuid),
@@ -2026,29 +1847,6 @@ void FavoritesModel::createConnections(
                      this,
                      QNSLOT(FavoritesModel,onFindSavedSearchFailed,
                             SavedSearch,ErrorString,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listSavedSearchesComplete,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListSavedSearchesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QList<SavedSearch>,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListSavedSearchesComplete,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListSavedSearchesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QList<SavedSearch>,QUuid));
-    QObject::connect(&localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listSavedSearchesFailed,
-                              LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                              LocalStorageManager::ListSavedSearchesOrder,
-                              LocalStorageManager::OrderDirection,ErrorString,QUuid),
-                     this,
-                     QNSLOT(FavoritesModel,onListSavedSearchesFailed,
-                            LocalStorageManager::ListObjectsOptions,size_t,size_t,
-                            LocalStorageManager::ListSavedSearchesOrder,
-                            LocalStorageManager::OrderDirection,
-                            ErrorString,QUuid));
     QObject::connect(&localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,expungeSavedSearchComplete,
                               SavedSearch,QUuid),
@@ -2085,95 +1883,37 @@ void FavoritesModel::createConnections(
                      QNSLOT(FavoritesModel,onGetNoteCountPerTagFailed,
                             ErrorString,Tag,
                             LocalStorageManager::NoteCountOptions,QUuid));
-}
-
-void FavoritesModel::requestNotesList()
-{
-    QNDEBUG("FavoritesModel::requestNotesList: offset = " << m_listNotesOffset);
-
-    LocalStorageManager::ListObjectsOptions flags =
-        LocalStorageManager::ListObjectsOption::ListFavoritedElements;
-    LocalStorageManager::ListNotesOrder order =
-        LocalStorageManager::ListNotesOrder::NoOrder;
-    LocalStorageManager::OrderDirection direction =
-        LocalStorageManager::OrderDirection::Ascending;
-
-    m_listNotesRequestId = QUuid::createUuid();
-    QNTRACE("Emitting the request to list notes: offset = "
-            << m_listNotesOffset << ", request id = "
-            << m_listNotesRequestId);
-    Q_EMIT listNotes(flags, LocalStorageManager::GetNoteOptions(0),
-                     NOTE_LIST_LIMIT, m_listNotesOffset, order, direction,
-                     QString(), m_listNotesRequestId);
-}
 
-void FavoritesModel::requestNotebooksList()
-{
-    QNDEBUG("FavoritesModel::requestNotebooksList: offset = "
-            << m_listNotebooksOffset);
-
-    // NOTE: the subscription to all notebooks is necessary in order to receive
-    // the information about the restrictions for various notebooks + for
-    // the collection of notebook names to forbid any two notebooks within
-    // the account to have the same name in a case-insensitive manner
-    LocalStorageManager::ListObjectsOptions flags =
-        LocalStorageManager::ListObjectsOption::ListAll;
-    LocalStorageManager::ListNotebooksOrder order =
-        LocalStorageManager::ListNotebooksOrder::NoOrder;
-    LocalStorageManager::OrderDirection direction =
-        LocalStorageManager::OrderDirection::Ascending;
-
-    m_listNotebooksRequestId = QUuid::createUuid();
-    QNTRACE("Emitting the request to list notebooks: offset = "
-            << m_listNotebooksOffset << ", request id = "
-            << m_listNotebooksRequestId);
-    Q_EMIT listNotebooks(flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset,
-                         order, direction, QString(), m_listNotebooksRequestId);
-}
-
-void FavoritesModel::requestTagsList()
-{
-    QNDEBUG("FavoritesModel::requestTagsList: offset = " << m_listTagsOffset);
-
-    // NOTE: the subscription to all tags is necessary for the collection of tag
-    // names to forbid any two tags within the account to have the same name
-    // in a case-insensitive manner
-    LocalStorageManager::ListObjectsOptions flags =
-        LocalStorageManager::ListObjectsOption::ListAll;
-    LocalStorageManager::ListTagsOrder order =
-        LocalStorageManager::ListTagsOrder::NoOrder;
-    LocalStorageManager::OrderDirection direction =
-        LocalStorageManager::OrderDirection::Ascending;
-
-    m_listTagsRequestId = QUuid::createUuid();
-    QNTRACE("Emitting the request to list tags: offset = "
-            << m_listTagsOffset << ", request id = " << m_listTagsRequestId);
-    Q_EMIT listTags(flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction,
-                    QString(), m_listTagsRequestId);
+    // Connect favorited items lister's signals to local slots
+    QObject::connect(m_pFavoritedItemsLister,
+                     QNSIGNAL(FavoritedItemsListerAsync,
+                              listFavoritedItemsComplete,
+                              QList<NoteModelItem>,QList<Notebook>,QList<Tag>,
+                              QList<SavedSearch>,QHash<QString,int>,
+                              QHash<QString,int>,QUuid),
+                     this,
+                     QNSLOT(FavoritesModel,onListFavoritedItemsComplete,
+                            QList<NoteModelItem>,QList<Notebook>,QList<Tag>,
+                            QList<SavedSearch>,QHash<QString,int>,
+                            QHash<QString,int>,QUuid));
+    QObject::connect(m_pFavoritedItemsLister,
+                     QNSIGNAL(FavoritedItemsListerAsync,
+                              listFavoritedItemsFailed,ErrorString,QUuid),
+                     this,
+                     QNSLOT(FavoritesModel,onListFavoritedItemsFailed,
+                            ErrorString,QUuid));
 }
 
-void FavoritesModel::requestSavedSearchesList()
+void FavoritesModel::requestFavoritedItemsList()
 {
-    QNDEBUG("FavoritesModel::requestSavedSearchesList: offset = "
-            << m_listSavedSearchesOffset);
-
-    // NOTE: the subscription to all saved searches is necessary for the collection
-    // of saved search names to forbid any two saved searches within the account
-    // to have the same name in a case-insensitive manner
-    LocalStorageManager::ListObjectsOptions flags =
-        LocalStorageManager::ListObjectsOption::ListAll;
-    LocalStorageManager::ListSavedSearchesOrder order =
-        LocalStorageManager::ListSavedSearchesOrder::NoOrder;
-    LocalStorageManager::OrderDirection direction =
-        LocalStorageManager::OrderDirection::Ascending;
+    QNDEBUG("FavoritesModel::requestFavoritedItemsList");
 
-    m_listSavedSearchesRequestId = QUuid::createUuid();
-    QNTRACE("Emitting the request to list saved searches: offset = "
-            << m_listSavedSearchesOffset << ", request id = "
-            << m_listSavedSearchesRequestId);
-    Q_EMIT listSavedSearches(flags, SAVED_SEARCH_LIST_LIMIT,
-                             m_listSavedSearchesOffset, order, direction,
-                             m_listSavedSearchesRequestId);
+    m_listFavoritedItemsRequestId = QUuid::createUuid();
+    QNTRACE("Emitting the request to list favorited items: request id = "
+            << m_listFavoritedItemsRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listFavoritedItems"), m_listFavoritedItemsRequestId);
+    Q_EMIT listFavoritedItems(m_listFavoritedItemsRequestId);
 }
 
 void FavoritesModel::requestNoteCountForNotebook(
@@ -2203,6 +1943,8 @@ void FavoritesModel::requestNoteCountForNotebook(
             << ", request id = " << requestId);
     LocalStorageManager::NoteCountOptions options(
         LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("noteCountPerNotebook"), requestId);
     Q_EMIT noteCountPerNotebook(dummyNotebook, options, requestId);
 }
 
@@ -2308,6 +2050,8 @@ void FavoritesModel::requestNoteCountForTag(
             << ", request id = " << requestId);
     LocalStorageManager::NoteCountOptions options(
         LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("noteCountPerTag"), requestId);
     Q_EMIT noteCountPerTag(dummyTag, options, requestId);
 }
 
@@ -2525,11 +2269,6 @@ void FavoritesModel::removeItemByLocalUid(const QString & localUid)
 void FavoritesModel::updateItemRowWithRespectToSorting(
     const FavoritesModelItem & item)
 {
-    if (m_sortedColumn != Columns::DisplayName) {
-        // Sorting by other columns is not yet implemented
-        return;
-    }
-
     FavoritesDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
     auto localUidIt = localUidIndex.find(item.localUid());
     if (Q_UNLIKELY(localUidIt == localUidIndex.end())) {
@@ -2547,36 +2286,42 @@ void FavoritesModel::updateItemRowWithRespectToSorting(
     }
 
     int originalRow = static_cast<int>(std::distance(rowIndex.begin(), it));
-    if (Q_UNLIKELY((originalRow < 0) ||
-                   (originalRow >= static_cast<int>(m_data.size()))))
-    {
-        QNWARNING("Can't update item row with respect to sorting: "
-                  << "item's original row is beyond the acceptable "
-                  << "range: " << originalRow << ", item: " << item);
-        return;
-    }
 
-    FavoritesModelItem itemCopy(item);
-
-    beginRemoveRows(QModelIndex(), originalRow, originalRow);
-    Q_UNUSED(rowIndex.erase(it))
-    endRemoveRows();
+    // All the other items are already sorted so the item only needs to be
+    // moved if it's out of order with respect to its neighbours; it is then
+    // relocated within the random access index without being copied and
+    // the views are notified about the move of a single row
+    Comparator comparator(m_sortedColumn, m_sortOrder);
+    auto positionIt = rowIndex.end();
 
-    auto positionIter = std::lower_bound(rowIndex.begin(), rowIndex.end(), itemCopy,
-                                         Comparator(m_sortedColumn, m_sortOrder));
-    if (positionIter == rowIndex.end())
+    if ((it != rowIndex.begin()) && comparator(*it, *(it - 1)))
     {
-        int row = static_cast<int>(rowIndex.size());
-        beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(itemCopy);
-        endInsertRows();
+        positionIt = std::lower_bound(rowIndex.begin(), it, *it, comparator);
+    }
+    else if (((it + 1) != rowIndex.end()) && comparator(*(it + 1), *it))
+    {
+        positionIt = std::upper_bound(it + 1, rowIndex.end(), *it, comparator);
+    }
+    else
+    {
+        QNTRACE("The item's row doesn't need to change: " << originalRow);
         return;
     }
 
-    int row = static_cast<int>(std::distance(rowIndex.begin(), positionIter));
-    beginInsertRows(QModelIndex(), row, row);
-    Q_UNUSED(rowIndex.insert(positionIter, itemCopy))
-    endInsertRows();
+    int row = static_cast<int>(std::distance(rowIndex.begin(), positionIt));
+    QNTRACE("Moving item from row " << originalRow << " to row " << row);
+
+    beginMoveRows(QModelIndex(), originalRow, originalRow, QModelIndex(), row);
+    rowIndex.relocate(positionIt, it);
+    endMoveRows();
+}
+
+int FavoritesModel::rowForNewItem(const FavoritesModelItem & item) const
+{
+    const FavoritesDataByIndex & rowIndex = m_data.get<ByIndex>();
+    auto it = std::upper_bound(rowIndex.begin(), rowIndex.end(), item,
+                               Comparator(m_sortedColumn, m_sortOrder));
+    return static_cast<int>(std::distance(rowIndex.begin(), it));
 }
 
 void FavoritesModel::updateItemInLocalStorage(const FavoritesModelItem & item)
@@ -2611,6 +2356,8 @@ void FavoritesModel::updateNoteInLocalStorage(const FavoritesModelItem & item)
             << item.localUid() << ", title = " << item.displayName());
 
     const Note * pCachedNote = m_noteCache.get(item.localUid());
+    m_instrumentation.recordCacheLookup(QStringLiteral("Note"),
+                                         (pCachedNote != nullptr));
     if (Q_UNLIKELY(!pCachedNote))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2621,6 +2368,8 @@ void FavoritesModel::updateNoteInLocalStorage(const FavoritesModelItem & item)
                 << item.localUid() << ", request id = " << requestId);
         LocalStorageManager::GetNoteOptions options(
             LocalStorageManager::GetNoteOption::WithResourceMetadata);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findNote"), requestId);
         Q_EMIT findNote(dummy, options, requestId);
         return;
     }
@@ -2642,6 +2391,8 @@ void FavoritesModel::updateNoteInLocalStorage(const FavoritesModelItem & item)
 
     QNTRACE("Emitting the request to update the note in the local "
             << "storage: id = " << requestId << ", note: " << note);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateNote"), requestId);
     Q_EMIT updateNote(note, LocalStorageManager::UpdateNoteOptions(0), requestId);
 }
 
@@ -2651,6 +2402,8 @@ void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & ite
             << item.localUid() << ", name = " << item.displayName());
 
     const Notebook * pCachedNotebook = m_notebookCache.get(item.localUid());
+    m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"),
+                                         (pCachedNotebook != nullptr));
     if (Q_UNLIKELY(!pCachedNotebook))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2659,6 +2412,8 @@ void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & ite
         dummy.setLocalUid(item.localUid());
         QNTRACE("Emitting the request to find a notebook: local uid = "
                 << item.localUid() << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findNotebook"), requestId);
         Q_EMIT findNotebook(dummy, requestId);
         return;
     }
@@ -2681,6 +2436,8 @@ void FavoritesModel::updateNotebookInLocalStorage(const FavoritesModelItem & ite
     QNTRACE("Emitting the request to update the notebook in "
             << "the local storage: id = " << requestId
             << ", notebook: " << notebook);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateNotebook"), requestId);
     Q_EMIT updateNotebook(notebook, requestId);
 }
 
@@ -2690,6 +2447,8 @@ void FavoritesModel::updateTagInLocalStorage(const FavoritesModelItem & item)
             << item.localUid() << ", name = " << item.displayName());
 
     const Tag * pCachedTag = m_tagCache.get(item.localUid());
+    m_instrumentation.recordCacheLookup(QStringLiteral("Tag"),
+                                         (pCachedTag != nullptr));
     if (Q_UNLIKELY(!pCachedTag))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2698,6 +2457,8 @@ void FavoritesModel::updateTagInLocalStorage(const FavoritesModelItem & item)
         dummy.setLocalUid(item.localUid());
         QNTRACE("Emitting the request to find a tag: local uid = "
                 << item.localUid() << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findTag"), requestId);
         Q_EMIT findTag(dummy, requestId);
         return;
     }
@@ -2719,6 +2480,8 @@ void FavoritesModel::updateTagInLocalStorage(const FavoritesModelItem & item)
 
     QNTRACE("Emitting the request to update the tag in the local "
             << "storage: id = " << requestId << ", tag: " << tag);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateTag"), requestId);
     Q_EMIT updateTag(tag, requestId);
 }
 
@@ -2729,6 +2492,8 @@ void FavoritesModel::updateSavedSearchInLocalStorage(
             << item.localUid() << ", display name = " << item.displayName());
 
     const SavedSearch * pCachedSearch = m_savedSearchCache.get(item.localUid());
+    m_instrumentation.recordCacheLookup(QStringLiteral("SavedSearch"),
+                                         (pCachedSearch != nullptr));
     if (Q_UNLIKELY(!pCachedSearch))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2737,6 +2502,8 @@ void FavoritesModel::updateSavedSearchInLocalStorage(
         dummy.setLocalUid(item.localUid());
         QNTRACE("Emitting the request to find a saved search: local uid = "
                 << item.localUid() << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findSavedSearch"), requestId);
         Q_EMIT findSavedSearch(dummy, requestId);
         return;
     }
@@ -2759,6 +2526,8 @@ void FavoritesModel::updateSavedSearchInLocalStorage(
     QNTRACE("Emitting the request to update the saved search in "
             << "the local storage: id = " << requestId
             << ", saved search: " << search);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateSavedSearch"), requestId);
     Q_EMIT updateSavedSearch(search, requestId);
 }
 
@@ -2830,6 +2599,8 @@ void FavoritesModel::unfavoriteNote(const QString & localUid)
     QNDEBUG("FavoritesModel::unfavoriteNote: local uid = " << localUid);
 
     const Note * pCachedNote = m_noteCache.get(localUid);
+    m_instrumentation.recordCacheLookup(QStringLiteral("Note"),
+                                         (pCachedNote != nullptr));
     if (Q_UNLIKELY(!pCachedNote))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2840,6 +2611,8 @@ void FavoritesModel::unfavoriteNote(const QString & localUid)
                 << localUid << ", request id = " << requestId);
         LocalStorageManager::GetNoteOptions options(
             LocalStorageManager::GetNoteOption::WithResourceMetadata);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findNote"), requestId);
         Q_EMIT findNote(dummy, options, requestId);
         return;
     }
@@ -2861,6 +2634,8 @@ void FavoritesModel::unfavoriteNote(const QString & localUid)
     QNTRACE("Emitting the request to update the note in the local "
             << "storage: id = " << requestId
             << ", note: " << note);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateNote"), requestId);
     Q_EMIT updateNote(note, LocalStorageManager::UpdateNoteOptions(0), requestId);
 }
 
@@ -2869,6 +2644,8 @@ void FavoritesModel::unfavoriteNotebook(const QString & localUid)
     QNDEBUG("FavoritesModel::unfavoriteNotebook: local uid = " << localUid);
 
     const Notebook * pCachedNotebook = m_notebookCache.get(localUid);
+    m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"),
+                                         (pCachedNotebook != nullptr));
     if (Q_UNLIKELY(!pCachedNotebook))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2877,6 +2654,8 @@ void FavoritesModel::unfavoriteNotebook(const QString & localUid)
         dummy.setLocalUid(localUid);
         QNTRACE("Emitting the request to find a notebook: local uid = "
                 << localUid << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findNotebook"), requestId);
         Q_EMIT findNotebook(dummy, requestId);
         return;
     }
@@ -2898,6 +2677,8 @@ void FavoritesModel::unfavoriteNotebook(const QString & localUid)
     QNTRACE("Emitting the request to update the notebook in "
             << "the local storage: id = " << requestId
             << ", notebook: " << notebook);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateNotebook"), requestId);
     Q_EMIT updateNotebook(notebook, requestId);
 }
 
@@ -2906,6 +2687,8 @@ void FavoritesModel::unfavoriteTag(const QString & localUid)
     QNDEBUG("FavoritesModel::unfavoriteTag: local uid = " << localUid);
 
     const Tag * pCachedTag = m_tagCache.get(localUid);
+    m_instrumentation.recordCacheLookup(QStringLiteral("Tag"),
+                                         (pCachedTag != nullptr));
     if (Q_UNLIKELY(!pCachedTag))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2914,6 +2697,8 @@ void FavoritesModel::unfavoriteTag(const QString & localUid)
         dummy.setLocalUid(localUid);
         QNTRACE("Emitting the request to find a tag: local uid = "
                 << localUid << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findTag"), requestId);
         Q_EMIT findTag(dummy, requestId);
         return;
     }
@@ -2935,6 +2720,8 @@ void FavoritesModel::unfavoriteTag(const QString & localUid)
     QNTRACE("Emitting the request to update the tag in the local "
             << "storage: id = " << requestId
             << ", tag: " << tag);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateTag"), requestId);
     Q_EMIT updateTag(tag, requestId);
 }
 
@@ -2943,6 +2730,8 @@ void FavoritesModel::unfavoriteSavedSearch(const QString & localUid)
     QNDEBUG("FavoritesModel::unfavoriteSavedSearch: local uid = " << localUid);
 
     const SavedSearch * pCachedSearch = m_savedSearchCache.get(localUid);
+    m_instrumentation.recordCacheLookup(QStringLiteral("SavedSearch"),
+                                         (pCachedSearch != nullptr));
     if (Q_UNLIKELY(!pCachedSearch))
     {
         QUuid requestId = QUuid::createUuid();
@@ -2952,6 +2741,8 @@ void FavoritesModel::unfavoriteSavedSearch(const QString & localUid)
         QNTRACE("Emitting the request to find a saved search: "
                 << "local uid = " << localUid
                 << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findSavedSearch"), requestId);
         Q_EMIT findSavedSearch(dummy, requestId);
         return;
     }
@@ -2973,6 +2764,8 @@ void FavoritesModel::unfavoriteSavedSearch(const QString & localUid)
     QNTRACE("Emitting the request to update the saved search in "
             << "the local storage: id = " << requestId
             << ", saved search: " << search);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("updateSavedSearch"), requestId);
     Q_EMIT updateSavedSearch(search, requestId);
 }
 
@@ -2993,47 +2786,57 @@ void FavoritesModel::onNoteAddedOrUpdated(
         return;
     }
 
-    if (!note.isFavorited()) {
-        removeItemByLocalUid(note.localUid());
-        return;
+    NoteModelItem summary;
+    summary.setLocalUid(note.localUid());
+    summary.setNotebookLocalUid(note.notebookLocalUid());
+    summary.setFavorited(note.isFavorited());
+
+    if (note.hasTitle()) {
+        summary.setTitle(note.title());
+    }
+    else if (note.isFavorited() && note.hasContent()) {
+        summary.setPreviewText(note.plainText());
     }
 
-    FavoritesModelItem item;
-    item.setType(FavoritesModelItem::Type::Note);
-    item.setLocalUid(note.localUid());
-    item.setNumNotesTargeted(0);
+    onNoteSummaryAddedOrUpdated(summary);
+}
 
-    if (note.hasTitle())
-    {
-        item.setDisplayName(note.title());
+void FavoritesModel::onNoteSummaryAddedOrUpdated(const NoteModelItem & summary)
+{
+    QNDEBUG("FavoritesModel::onNoteSummaryAddedOrUpdated: note local uid = "
+            << summary.localUid());
+
+    if (summary.notebookLocalUid().isEmpty()) {
+        QNWARNING("Skipping the note not having the notebook local uid: "
+                  << summary);
+        return;
     }
-    else if (note.hasContent())
-    {
-        QString plainText = note.plainText();
-        plainText.truncate(160);
-        item.setDisplayName(plainText);
-        // NOTE: using the text preview in this way means updating the favorites
-        // item's display name would actually create the title for the note
+
+    if (!summary.isFavorited()) {
+        removeItemByLocalUid(summary.localUid());
+        return;
     }
 
-    m_notebookLocalUidByNoteLocalUid[note.localUid()] = note.notebookLocalUid();
+    FavoritesModelItem item;
+    noteSummaryToItem(summary, item);
+
+    m_notebookLocalUidByNoteLocalUid[summary.localUid()] =
+        summary.notebookLocalUid();
 
     FavoritesDataByIndex & rowIndex = m_data.get<ByIndex>();
     FavoritesDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-    auto itemIt = localUidIndex.find(note.localUid());
+    auto itemIt = localUidIndex.find(summary.localUid());
     if (itemIt == localUidIndex.end())
     {
         QNDEBUG("Detected newly favorited note");
 
         Q_EMIT aboutToAddItem();
 
-        int row = static_cast<int>(rowIndex.size());
+        int row = rowForNewItem(item);
         beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(item);
+        Q_UNUSED(rowIndex.insert(rowIndex.begin() + row, item))
         endInsertRows();
 
-        updateItemRowWithRespectToSorting(item);
-
         QModelIndex addedNoteIndex = indexForLocalUid(item.localUid());
         Q_EMIT addedItem(addedNoteIndex);
 
@@ -3067,6 +2870,27 @@ void FavoritesModel::onNoteAddedOrUpdated(
     Q_EMIT updatedItem(modelIndex);
 }
 
+void FavoritesModel::noteSummaryToItem(
+    const NoteModelItem & summary, FavoritesModelItem & item) const
+{
+    item.setType(FavoritesModelItem::Type::Note);
+    item.setLocalUid(summary.localUid());
+    item.setNumNotesTargeted(0);
+
+    if (!summary.title().isEmpty())
+    {
+        item.setDisplayName(summary.title());
+    }
+    else if (!summary.previewText().isEmpty())
+    {
+        QString plainText = summary.previewText();
+        plainText.truncate(160);
+        item.setDisplayName(plainText);
+        // NOTE: using the text preview in this way means updating the favorites
+        // item's display name would actually create the title for the note
+    }
+}
+
 void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
 {
     QNDEBUG("FavoritesModel::onNotebookAddedOrUpdated: local uid = "
@@ -3090,52 +2914,7 @@ void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
         Q_UNUSED(m_lowerCaseNotebookNames.insert(notebook.name().toLower()))
     }
 
-    if (notebook.hasGuid())
-    {
-        NotebookRestrictionsData & notebookRestrictionsData =
-            m_notebookRestrictionsData[notebook.guid()];
-
-        if (notebook.hasRestrictions())
-        {
-            const qevercloud::NotebookRestrictions & restrictions =
-                notebook.restrictions();
-
-            notebookRestrictionsData.m_canUpdateNotebook =
-                !restrictions.noUpdateNotebook.isSet() ||
-                !restrictions.noUpdateNotebook.ref();
-            notebookRestrictionsData.m_canUpdateNotes =
-                !restrictions.noUpdateNotes.isSet() ||
-                !restrictions.noUpdateNotes.ref();
-            notebookRestrictionsData.m_canUpdateTags =
-                !restrictions.noUpdateTags.isSet() ||
-                !restrictions.noUpdateTags.ref();
-        }
-        else
-        {
-            notebookRestrictionsData.m_canUpdateNotebook = true;
-            notebookRestrictionsData.m_canUpdateNotes = true;
-            notebookRestrictionsData.m_canUpdateTags = true;
-        }
-
-        QNTRACE("Updated restrictions data for notebook "
-                << notebook.localUid() << ", name "
-                << (notebook.hasName()
-                    ? QStringLiteral("\"") + notebook.name() + QStringLiteral("\"")
-                    : QStringLiteral("<not set>"))
-                << ", guid = " << notebook.guid()
-                << ": can update notebook = "
-                << (notebookRestrictionsData.m_canUpdateNotebook
-                    ? "true"
-                    : "false")
-                << ", can update notes = "
-                << (notebookRestrictionsData.m_canUpdateNotes
-                    ? "true"
-                    : "false")
-                << ", can update tags = "
-                << (notebookRestrictionsData.m_canUpdateTags
-                    ? "true"
-                    : "false"));
-    }
+    updateNotebookRestrictionsData(notebook);
 
     if (!notebook.hasName()) {
         QNTRACE("Removing/skipping the notebook without a name");
@@ -3163,13 +2942,11 @@ void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
 
         Q_EMIT aboutToAddItem();
 
-        int row = static_cast<int>(rowIndex.size());
+        int row = rowForNewItem(item);
         beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(item);
+        Q_UNUSED(rowIndex.insert(rowIndex.begin() + row, item))
         endInsertRows();
 
-        updateItemRowWithRespectToSorting(item);
-
         QModelIndex addedNotebookIndex = indexForLocalUid(item.localUid());
         Q_EMIT addedItem(addedNotebookIndex);
 
@@ -3209,6 +2986,57 @@ void FavoritesModel::onNotebookAddedOrUpdated(const Notebook & notebook)
     Q_EMIT updatedItem(modelIndex);
 }
 
+void FavoritesModel::updateNotebookRestrictionsData(const Notebook & notebook)
+{
+    if (!notebook.hasGuid()) {
+        return;
+    }
+
+    NotebookRestrictionsData & notebookRestrictionsData =
+        m_notebookRestrictionsData[notebook.guid()];
+
+    if (notebook.hasRestrictions())
+    {
+        const qevercloud::NotebookRestrictions & restrictions =
+            notebook.restrictions();
+
+        notebookRestrictionsData.m_canUpdateNotebook =
+            !restrictions.noUpdateNotebook.isSet() ||
+            !restrictions.noUpdateNotebook.ref();
+        notebookRestrictionsData.m_canUpdateNotes =
+            !restrictions.noUpdateNotes.isSet() ||
+            !restrictions.noUpdateNotes.ref();
+        notebookRestrictionsData.m_canUpdateTags =
+            !restrictions.noUpdateTags.isSet() ||
+            !restrictions.noUpdateTags.ref();
+    }
+    else
+    {
+        notebookRestrictionsData.m_canUpdateNotebook = true;
+        notebookRestrictionsData.m_canUpdateNotes = true;
+        notebookRestrictionsData.m_canUpdateTags = true;
+    }
+
+    QNTRACE("Updated restrictions data for notebook "
+            << notebook.localUid() << ", name "
+            << (notebook.hasName()
+                ? QStringLiteral("\"") + notebook.name() + QStringLiteral("\"")
+                : QStringLiteral("<not set>"))
+            << ", guid = " << notebook.guid()
+            << ": can update notebook = "
+            << (notebookRestrictionsData.m_canUpdateNotebook
+                ? "true"
+                : "false")
+            << ", can update notes = "
+            << (notebookRestrictionsData.m_canUpdateNotes
+                ? "true"
+                : "false")
+            << ", can update tags = "
+            << (notebookRestrictionsData.m_canUpdateTags
+                ? "true"
+                : "false"));
+}
+
 void FavoritesModel::onTagAddedOrUpdated(const Tag & tag)
 {
     QNTRACE("FavoritesModel::onTagAddedOrUpdated: local uid = " << tag.localUid());
@@ -3256,13 +3084,11 @@ void FavoritesModel::onTagAddedOrUpdated(const Tag & tag)
 
         Q_EMIT aboutToAddItem();
 
-        int row = static_cast<int>(rowIndex.size());
+        int row = rowForNewItem(item);
         beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(item);
+        Q_UNUSED(rowIndex.insert(rowIndex.begin() + row, item))
         endInsertRows();
 
-        updateItemRowWithRespectToSorting(item);
-
         QModelIndex addedTagIndex = indexForLocalUid(item.localUid());
         Q_EMIT addedItem(addedTagIndex);
 
@@ -3350,13 +3176,11 @@ void FavoritesModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
 
         Q_EMIT aboutToAddItem();
 
-        int row = static_cast<int>(rowIndex.size());
+        int row = rowForNewItem(item);
         beginInsertRows(QModelIndex(), row, row);
-        rowIndex.push_back(item);
+        Q_UNUSED(rowIndex.insert(rowIndex.begin() + row, item))
         endInsertRows();
 
-        updateItemRowWithRespectToSorting(item);
-
         QModelIndex addedSavedSearchIndex = indexForLocalUid(item.localUid());
         Q_EMIT addedItem(addedSavedSearchIndex);
 
@@ -3405,40 +3229,24 @@ void FavoritesModel::updateItemColumnInView(
         return;
     }
 
-    if (m_sortedColumn != column)
-    {
-        auto itemIndexIt = m_data.project<ByIndex>(itemIt);
-        if (Q_LIKELY(itemIndexIt != rowIndex.end())) {
-            int row = static_cast<int>(std::distance(rowIndex.begin(), itemIndexIt));
-            QModelIndex modelIndex = createIndex(row, column);
-            QNTRACE("Emitting dataChanged signal for row "
-                    << row << " and column " << column);
-            Q_EMIT dataChanged(modelIndex, modelIndex);
-            return;
-        }
-
+    auto itemIndexIt = m_data.project<ByIndex>(itemIt);
+    if (Q_UNLIKELY(itemIndexIt == rowIndex.end())) {
         ErrorString error(QT_TR_NOOP("Internal error: can't project the local uid "
                                      "index iterator to the random access index "
                                      "iterator within the favorites model"));
         QNWARNING(error << ", favorites model item: " << item);
         Q_EMIT notifyError(error);
-    }
-
-    updateItemRowWithRespectToSorting(item);
-}
-
-void FavoritesModel::checkAllItemsListed()
-{
-    if (m_allItemsListed) {
         return;
     }
 
-    if (m_listNotesRequestId.isNull() && m_listNotebooksRequestId.isNull() &&
-        m_listTagsRequestId.isNull() && m_listSavedSearchesRequestId.isNull())
-    {
-        QNDEBUG("Listed all favorites model's items");
-        m_allItemsListed = true;
-        Q_EMIT notifyAllItemsListed();
+    int row = static_cast<int>(std::distance(rowIndex.begin(), itemIndexIt));
+    QModelIndex modelIndex = createIndex(row, column);
+    QNTRACE("Emitting dataChanged signal for row "
+            << row << " and column " << column);
+    Q_EMIT dataChanged(modelIndex, modelIndex);
+
+    if (m_sortedColumn == column) {
+        updateItemRowWithRespectToSorting(item);
     }
 }
 
@@ -24,6 +24,8 @@
 #include "NotebookCache.h"
 #include "TagCache.h"
 #include "SavedSearchCache.h"
+#include "ModelInstrumentation.h"
+#include "FavoritedItemsListerAsync.h"
 
 #include <quentier/types/Account.h>
 #include <quentier/types/Notebook.h>
@@ -62,13 +64,19 @@ public:
         LocalStorageManagerAsync & localStorageManagerAsync,
         NoteCache & noteCache, NotebookCache & notebookCache,
         TagCache & tagCache, SavedSearchCache & savedSearchCache,
-        QObject * parent = nullptr);
+        QObject * parent = nullptr,
+        NoteIndexAsync * pNoteIndex = nullptr);
 
     virtual ~FavoritesModel();
 
     const Account & account() const { return m_account; }
     void updateAccount(const Account & account);
 
+    const ModelInstrumentation & instrumentation() const
+    { return m_instrumentation; }
+
+    void resetInstrumentation() { m_instrumentation.reset(); }
+
     struct Columns
     {
         enum type
@@ -161,44 +169,15 @@ Q_SIGNALS:
         Note note, LocalStorageManager::GetNoteOptions options,
         QUuid requestId);
 
-    void listNotes(
-        LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QUuid requestId);
-
     void updateNotebook(Notebook notebook, QUuid requestId);
     void findNotebook(Notebook notebook, QUuid requestId);
 
-    void listNotebooks(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotebooksOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QUuid requestId);
-
     void updateTag(Tag tag, QUuid requestId);
     void findTag(Tag tag, QUuid requestId);
 
-    void listTags(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListTagsOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QUuid requestId);
-
     void updateSavedSearch(SavedSearch search, QUuid requestId);
     void findSavedSearch(SavedSearch search, QUuid requestId);
 
-    void listSavedSearches(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListSavedSearchesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QUuid requestId);
-
     void noteCountPerNotebook(
         Notebook notebook, LocalStorageManager::NoteCountOptions options,
         QUuid requestId);
@@ -206,6 +185,8 @@ Q_SIGNALS:
     void noteCountPerTag(
         Tag tag, LocalStorageManager::NoteCountOptions options, QUuid requestId);
 
+    void listFavoritedItems(QUuid requestId);
+
 private Q_SLOTS:
     // Slots for response to events from local storage
 
@@ -237,23 +218,6 @@ private Q_SLOTS:
         Note note, LocalStorageManager::GetNoteOptions options,
         ErrorString errorDescription, QUuid requestId);
 
-    void onListNotesComplete(
-        LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QList<Note> foundNotes, QUuid requestId);
-
-    void onListNotesFailed(
-        LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, ErrorString errorDescription,
-        QUuid requestId);
-
     void onExpungeNoteComplete(Note note, QUuid requestId);
 
     // For notebooks:
@@ -268,22 +232,6 @@ private Q_SLOTS:
     void onFindNotebookFailed(
         Notebook notebook, ErrorString errorDescription, QUuid requestId);
 
-    void onListNotebooksComplete(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotebooksOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QList<Notebook> foundNotebooks,
-        QUuid requestId);
-
-    void onListNotebooksFailed(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotebooksOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, ErrorString errorDescription,
-        QUuid requestId);
-
     void onExpungeNotebookComplete(Notebook notebook, QUuid requestId);
 
     // For tags:
@@ -293,22 +241,6 @@ private Q_SLOTS:
     void onFindTagComplete(Tag tag, QUuid requestId);
     void onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId);
 
-    void onListTagsComplete(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListTagsOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QList<Tag> foundTags,
-        QUuid requestId);
-
-    void onListTagsFailed(
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListTagsOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, ErrorString errorDescription,
-        QUuid requestId);
-
     void onExpungeTagComplete(
         Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId);
 
@@ -324,19 +256,17 @@ private Q_SLOTS:
     void onFindSavedSearchFailed(
         SavedSearch search, ErrorString errorDescription, QUuid requestId);
 
-    void onListSavedSearchesComplete(
-        LocalStorageManager::ListObjectsOptions flag, size_t limit,
-        size_t offset, LocalStorageManager::ListSavedSearchesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QList<SavedSearch> foundSearches, QUuid requestId);
+    void onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId);
 
-    void onListSavedSearchesFailed(
-        LocalStorageManager::ListObjectsOptions flag, size_t limit,
-        size_t offset, LocalStorageManager::ListSavedSearchesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        ErrorString errorDescription, QUuid requestId);
+    // For listing items of all kinds at once:
+    void onListFavoritedItemsComplete(
+        QList<NoteModelItem> noteSummaries, QList<Notebook> notebooks,
+        QList<Tag> tags, QList<SavedSearch> savedSearches,
+        QHash<QString, int> noteCountsPerNotebookLocalUid,
+        QHash<QString, int> noteCountsPerTagLocalUid, QUuid requestId);
 
-    void onExpungeSavedSearchComplete(SavedSearch search, QUuid requestId);
+    void onListFavoritedItemsFailed(
+        ErrorString errorDescription, QUuid requestId);
 
     // For note counts:
     void onGetNoteCountPerNotebookComplete(
@@ -360,10 +290,7 @@ private Q_SLOTS:
 
 private:
     void createConnections(LocalStorageManagerAsync & localStorageManagerAsync);
-    void requestNotesList();
-    void requestNotebooksList();
-    void requestTagsList();
-    void requestSavedSearchesList();
+    void requestFavoritedItemsList();
 
     struct NoteCountRequestOption
     {
@@ -398,6 +325,7 @@ private:
 
     void removeItemByLocalUid(const QString & localUid);
     void updateItemRowWithRespectToSorting(const FavoritesModelItem & item);
+    int rowForNewItem(const FavoritesModelItem & item) const;
     void updateItemInLocalStorage(const FavoritesModelItem & item);
     void updateNoteInLocalStorage(const FavoritesModelItem & item);
     void updateNotebookInLocalStorage(const FavoritesModelItem & item);
@@ -414,15 +342,19 @@ private:
     void unfavoriteSavedSearch(const QString & localUid);
 
     void onNoteAddedOrUpdated(const Note & note, const bool tagsUpdated = true);
+    void onNoteSummaryAddedOrUpdated(const NoteModelItem & summary);
+    void noteSummaryToItem(
+        const NoteModelItem & summary, FavoritesModelItem & item) const;
+
     void onNotebookAddedOrUpdated(const Notebook & notebook);
+    void updateNotebookRestrictionsData(const Notebook & notebook);
+
     void onTagAddedOrUpdated(const Tag & tag);
     void onSavedSearchAddedOrUpdated(const SavedSearch & search);
 
     void updateItemColumnInView(const FavoritesModelItem & item,
                                 const Columns::type column);
 
-    void checkAllItemsListed();
-
 private:
     struct ByLocalUid{};
     struct ByIndex{};
@@ -483,22 +415,18 @@ private:
     NotebookCache &         m_notebookCache;
     TagCache &              m_tagCache;
     SavedSearchCache &      m_savedSearchCache;
+    ModelInstrumentation    m_instrumentation;
 
     QSet<QString>           m_lowerCaseNotebookNames;
     QSet<QString>           m_lowerCaseTagNames;
     QSet<QString>           m_lowerCaseSavedSearchNames;
 
-    size_t                  m_listNotesOffset;
-    QUuid                   m_listNotesRequestId;
-
-    size_t                  m_listNotebooksOffset;
-    QUuid                   m_listNotebooksRequestId;
-
-    size_t                  m_listTagsOffset;
-    QUuid                   m_listTagsRequestId;
+    // Lives in the local storage thread, lists favorited items of all kinds
+    // along with their note counts; favorited notes are listed in the form
+    // of note summaries
+    FavoritedItemsListerAsync * m_pFavoritedItemsLister;
 
-    size_t                  m_listSavedSearchesOffset;
-    QUuid                   m_listSavedSearchesRequestId;
+    QUuid                   m_listFavoritedItemsRequestId;
 
     QSet<QUuid>             m_updateNoteRequestIds;
     QSet<QUuid>             m_findNoteToRestoreFailedUpdateRequestIds;
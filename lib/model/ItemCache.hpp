@@ -0,0 +1,235 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_ITEM_CACHE_HPP
+#define QUENTIER_LIB_MODEL_ITEM_CACHE_HPP
+
+#include "ItemCacheStats.h"
+
+#include <QHash>
+
+#include <cstddef>
+#include <list>
+#include <utility>
+
+namespace quentier {
+
+/**
+ * @brief The ItemCache class template is the LRU cache which limits both
+ * the number of items it contains and their total size in bytes; the size
+ * of each item is estimated by the callable of CostEstimator type.
+ *
+ * The cache counts hits, misses and evictions so that its limits can be
+ * chosen using the actual usage data rather than guesses.
+ */
+template <class Key, class Value, class CostEstimator>
+class ItemCache
+{
+public:
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<Key, Value> value_type;
+
+private:
+    typedef std::list<value_type> container_type;
+
+public:
+    typedef typename container_type::const_iterator const_iterator;
+
+    /**
+     * @param maxItems          The max number of items in the cache, zero
+     *                          means no limit
+     * @param maxSizeInBytes    The max total estimated size of items in
+     *                          the cache, zero means no limit
+     */
+    explicit ItemCache(const std::size_t maxItems = 100,
+                       const quint64 maxSizeInBytes = 0) :
+        m_container(),
+        m_entriesByKey(),
+        m_costEstimator(),
+        m_maxItems(maxItems),
+        m_maxSizeInBytes(maxSizeInBytes),
+        m_sizeInBytes(0),
+        m_numHits(0),
+        m_numMisses(0),
+        m_numEvictions(0)
+    {}
+
+    bool empty() const { return m_container.empty(); }
+    std::size_t size() const { return m_container.size(); }
+    quint64 sizeInBytes() const { return m_sizeInBytes; }
+
+    std::size_t maxItems() const { return m_maxItems; }
+    quint64 maxSizeInBytes() const { return m_maxSizeInBytes; }
+
+    /**
+     * Changes the limits of the cache evicting the least recently used items
+     * if the cache doesn't fit the new limits
+     */
+    void setLimits(const std::size_t maxItems, const quint64 maxSizeInBytes)
+    {
+        m_maxItems = maxItems;
+        m_maxSizeInBytes = maxSizeInBytes;
+        evictExcessItems();
+    }
+
+    const_iterator begin() const { return m_container.cbegin(); }
+    const_iterator end() const { return m_container.cend(); }
+
+    void clear()
+    {
+        m_container.clear();
+        m_entriesByKey.clear();
+        m_sizeInBytes = 0;
+    }
+
+    void put(const Key & key, const Value & value)
+    {
+        Q_UNUSED(removeImpl(key))
+
+        quint64 cost = m_costEstimator(value);
+        m_container.push_front(value_type(key, value));
+        m_entriesByKey.insert(key, Entry(m_container.begin(), cost));
+        m_sizeInBytes += cost;
+
+        evictExcessItems();
+    }
+
+    /**
+     * @return                  The pointer to the cached item or null pointer
+     *                          if there's no such item in the cache; the item
+     *                          becomes the most recently used one
+     */
+    const Value * get(const Key & key)
+    {
+        auto it = m_entriesByKey.find(key);
+        if (it == m_entriesByKey.end()) {
+            ++m_numMisses;
+            return nullptr;
+        }
+
+        ++m_numHits;
+
+        auto containerIt = it.value().m_it;
+        if (containerIt != m_container.begin()) {
+            m_container.splice(m_container.begin(), m_container, containerIt);
+        }
+
+        return &(containerIt->second);
+    }
+
+    bool exists(const Key & key) const
+    {
+        return m_entriesByKey.contains(key);
+    }
+
+    bool remove(const Key & key)
+    {
+        return removeImpl(key);
+    }
+
+    ItemCacheStats stats() const
+    {
+        ItemCacheStats stats;
+        stats.m_numHits = m_numHits;
+        stats.m_numMisses = m_numMisses;
+        stats.m_numEvictions = m_numEvictions;
+        stats.m_numItems = static_cast<quint64>(m_container.size());
+        stats.m_sizeInBytes = m_sizeInBytes;
+        stats.m_maxItems = static_cast<quint64>(m_maxItems);
+        stats.m_maxSizeInBytes = m_maxSizeInBytes;
+        return stats;
+    }
+
+    void resetStats()
+    {
+        m_numHits = 0;
+        m_numMisses = 0;
+        m_numEvictions = 0;
+    }
+
+private:
+    struct Entry
+    {
+        Entry() : m_it(), m_cost(0) {}
+
+        Entry(const typename container_type::iterator it,
+              const quint64 cost) :
+            m_it(it),
+            m_cost(cost)
+        {}
+
+        typename container_type::iterator   m_it;
+        quint64                             m_cost;
+    };
+
+    bool removeImpl(const Key & key)
+    {
+        auto it = m_entriesByKey.find(key);
+        if (it == m_entriesByKey.end()) {
+            return false;
+        }
+
+        m_sizeInBytes -= it.value().m_cost;
+        m_container.erase(it.value().m_it);
+        Q_UNUSED(m_entriesByKey.erase(it))
+        return true;
+    }
+
+    bool exceedsLimits() const
+    {
+        if ((m_maxItems > 0) && (m_container.size() > m_maxItems)) {
+            return true;
+        }
+
+        if ((m_maxSizeInBytes > 0) && (m_sizeInBytes > m_maxSizeInBytes)) {
+            return true;
+        }
+
+        return false;
+    }
+
+    void evictExcessItems()
+    {
+        // The most recently put item is kept even if it alone exceeds
+        // the size limit, otherwise it could never be retrieved
+        while(exceedsLimits() && (m_container.size() > 1))
+        {
+            Key key = m_container.back().first;
+            Q_UNUSED(removeImpl(key))
+            ++m_numEvictions;
+        }
+    }
+
+private:
+    container_type          m_container;
+    QHash<Key, Entry>       m_entriesByKey;
+    CostEstimator           m_costEstimator;
+
+    std::size_t             m_maxItems;
+    quint64                 m_maxSizeInBytes;
+    quint64                 m_sizeInBytes;
+
+    quint64                 m_numHits;
+    quint64                 m_numMisses;
+    quint64                 m_numEvictions;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_ITEM_CACHE_HPP
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ItemCacheStats.h"
+
+namespace quentier {
+
+ItemCacheStats::ItemCacheStats() :
+    m_numHits(0),
+    m_numMisses(0),
+    m_numEvictions(0),
+    m_numItems(0),
+    m_sizeInBytes(0),
+    m_maxItems(0),
+    m_maxSizeInBytes(0)
+{}
+
+QTextStream & ItemCacheStats::print(QTextStream & strm) const
+{
+    quint64 numRequests = m_numHits + m_numMisses;
+    double hitRatio = (numRequests > 0
+                       ? static_cast<double>(m_numHits) / numRequests
+                       : 0.0);
+
+    strm << "Item cache stats: hits = " << m_numHits
+         << ", misses = " << m_numMisses
+         << ", hit ratio = " << hitRatio
+         << ", evictions = " << m_numEvictions
+         << ", items = " << m_numItems
+         << ", size in bytes = " << m_sizeInBytes
+         << ", max items = " << m_maxItems
+         << ", max size in bytes = " << m_maxSizeInBytes;
+    return strm;
+}
+
+QJsonObject ItemCacheStats::toJson() const
+{
+    QJsonObject object;
+    object[QStringLiteral("hits")] = static_cast<double>(m_numHits);
+    object[QStringLiteral("misses")] = static_cast<double>(m_numMisses);
+    object[QStringLiteral("evictions")] = static_cast<double>(m_numEvictions);
+    object[QStringLiteral("items")] = static_cast<double>(m_numItems);
+    object[QStringLiteral("sizeInBytes")] = static_cast<double>(m_sizeInBytes);
+    object[QStringLiteral("maxItems")] = static_cast<double>(m_maxItems);
+    object[QStringLiteral("maxSizeInBytes")] =
+        static_cast<double>(m_maxSizeInBytes);
+    return object;
+}
+
+} // namespace quentier
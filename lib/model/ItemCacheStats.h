@@ -0,0 +1,52 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_ITEM_CACHE_STATS_H
+#define QUENTIER_LIB_MODEL_ITEM_CACHE_STATS_H
+
+#include <quentier/utility/Printable.h>
+
+#include <QJsonObject>
+
+namespace quentier {
+
+/**
+ * @brief The ItemCacheStats struct is a snapshot of the usage counters
+ * and limits of an item cache; zero limit means the respective limit is
+ * not imposed
+ */
+struct ItemCacheStats: public Printable
+{
+    ItemCacheStats();
+
+    virtual QTextStream & print(QTextStream & strm) const override;
+
+    QJsonObject toJson() const;
+
+    quint64     m_numHits;
+    quint64     m_numMisses;
+    quint64     m_numEvictions;
+    quint64     m_numItems;
+    quint64     m_sizeInBytes;
+    quint64     m_maxItems;
+    quint64     m_maxSizeInBytes;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_ITEM_CACHE_STATS_H
@@ -18,13 +18,94 @@
 
 #include "ItemModel.h"
 
+#include <algorithm>
+
 namespace quentier {
 
 ItemModel::ItemModel(QObject * parent) :
-    QAbstractItemModel(parent)
-{}
+    QAbstractItemModel(parent),
+    m_itemNamesByLinkedNotebookGuid(),
+    m_allItemNames(),
+    m_allItemNamesValid(false)
+{
+    QObject::connect(this,
+                     QNSIGNAL(ItemModel,rowsInserted,
+                              const QModelIndex&,int,int),
+                     this,
+                     QNSLOT(ItemModel,invalidateItemNamesCache));
+    QObject::connect(this,
+                     QNSIGNAL(ItemModel,rowsRemoved,
+                              const QModelIndex&,int,int),
+                     this,
+                     QNSLOT(ItemModel,invalidateItemNamesCache));
+    QObject::connect(this,
+                     QNSIGNAL(ItemModel,rowsMoved,const QModelIndex&,int,int,
+                              const QModelIndex&,int),
+                     this,
+                     QNSLOT(ItemModel,invalidateItemNamesCache));
+    QObject::connect(this,
+                     QNSIGNAL(ItemModel,modelReset),
+                     this,
+                     QNSLOT(ItemModel,invalidateItemNamesCache));
+    QObject::connect(this,
+                     QNSIGNAL(ItemModel,dataChanged,const QModelIndex&,
+                              const QModelIndex&,const QVector<int>&),
+                     this,
+                     QNSLOT(ItemModel,onItemDataChanged,const QModelIndex&,
+                            const QModelIndex&,const QVector<int>&));
+}
 
 ItemModel::~ItemModel()
 {}
 
+QStringList ItemModel::itemNames(const QString & linkedNotebookGuid) const
+{
+    if (linkedNotebookGuid.isNull())
+    {
+        if (!m_allItemNamesValid) {
+            m_allItemNames = itemNamesImpl(linkedNotebookGuid);
+            m_allItemNamesValid = true;
+        }
+
+        return m_allItemNames;
+    }
+
+    auto it = m_itemNamesByLinkedNotebookGuid.find(linkedNotebookGuid);
+    if (it == m_itemNamesByLinkedNotebookGuid.end()) {
+        it = m_itemNamesByLinkedNotebookGuid.insert(
+            linkedNotebookGuid, itemNamesImpl(linkedNotebookGuid));
+    }
+
+    return it.value();
+}
+
+void ItemModel::sortItemNames(QStringList & itemNames)
+{
+    std::sort(itemNames.begin(), itemNames.end(),
+              [](const QString & lhs, const QString & rhs) -> bool {
+                  return lhs.compare(rhs, Qt::CaseInsensitive) < 0;
+              });
+}
+
+void ItemModel::invalidateItemNamesCache()
+{
+    m_itemNamesByLinkedNotebookGuid.clear();
+    m_allItemNames.clear();
+    m_allItemNamesValid = false;
+}
+
+void ItemModel::onItemDataChanged(
+    const QModelIndex & topLeft, const QModelIndex & bottomRight,
+    const QVector<int> & roles)
+{
+    Q_UNUSED(roles)
+
+    int column = nameColumn();
+    if ((topLeft.column() > column) || (bottomRight.column() < column)) {
+        return;
+    }
+
+    invalidateItemNamesCache();
+}
+
 } // namespace quentier
@@ -22,7 +22,9 @@
 #include <quentier/utility/Macros.h>
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QStringList>
+#include <QVector>
 
 namespace quentier {
 
@@ -81,8 +83,11 @@ public:
      *                              returned
      * @return                      The sorted list of names of the items stored
      *                              within the model
+     *
+     * The sorted lists of names are cached by the model and only recomputed
+     * after the set of items or their names have changed
      */
-    virtual QStringList itemNames(const QString & linkedNotebookGuid) const = 0;
+    QStringList itemNames(const QString & linkedNotebookGuid) const;
 
     /**
      * @brief nameColumn
@@ -118,6 +123,37 @@ Q_SIGNALS:
      * received all items from the local storage
      */
     void notifyAllItemsListed();
+
+protected:
+    /**
+     * @brief itemNamesImpl - computes the list of item names for itemNames
+     * method; the returned list is cached until the model changes
+     */
+    virtual QStringList itemNamesImpl(
+        const QString & linkedNotebookGuid) const = 0;
+
+    /**
+     * @brief sortItemNames - sorts the list of item names in case insensitive
+     * manner
+     */
+    static void sortItemNames(QStringList & itemNames);
+
+protected Q_SLOTS:
+    void invalidateItemNamesCache();
+
+private Q_SLOTS:
+    void onItemDataChanged(
+        const QModelIndex & topLeft, const QModelIndex & bottomRight,
+        const QVector<int> & roles);
+
+private:
+    // Item names for non-null linked notebook guids
+    mutable QHash<QString, QStringList>     m_itemNamesByLinkedNotebookGuid;
+
+    // Item names for null linked notebook guid; kept separately as null and
+    // empty strings are equal as hash keys
+    mutable QStringList     m_allItemNames;
+    mutable bool            m_allItemNamesValid;
 };
 
 } // namespace quentier
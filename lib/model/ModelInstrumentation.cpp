@@ -0,0 +1,175 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelInstrumentation.h"
+
+#include <algorithm>
+
+#define NSEC_TO_MSEC(nsec) (static_cast<double>(nsec) / 1000000.0)
+
+namespace quentier {
+
+ModelInstrumentation::ModelInstrumentation(const QString & modelName) :
+    m_modelName(modelName),
+    m_timer(),
+    m_cacheLookupStatsByItemType(),
+    m_requestStatsByType(),
+    m_pendingRequests()
+{
+    m_timer.start();
+}
+
+void ModelInstrumentation::recordCacheLookup(
+    const QString & itemType, const bool hit)
+{
+    CacheLookupStats & stats = m_cacheLookupStatsByItemType[itemType];
+    if (hit) {
+        ++stats.m_numHits;
+    }
+    else {
+        ++stats.m_numMisses;
+    }
+}
+
+void ModelInstrumentation::recordRequestIssued(
+    const QString & requestType, const QUuid & requestId)
+{
+    ++m_requestStatsByType[requestType].m_numIssued;
+
+    PendingRequest & request = m_pendingRequests[requestId];
+    request.m_requestType = requestType;
+    request.m_issueTimestampNsec = m_timer.nsecsElapsed();
+}
+
+void ModelInstrumentation::recordRequestCompleted(const QUuid & requestId)
+{
+    recordRequestFinished(requestId, /* success = */ true);
+}
+
+void ModelInstrumentation::recordRequestFailed(const QUuid & requestId)
+{
+    recordRequestFinished(requestId, /* success = */ false);
+}
+
+void ModelInstrumentation::clearPendingRequests()
+{
+    for(auto it = m_pendingRequests.constBegin(),
+        end = m_pendingRequests.constEnd(); it != end; ++it)
+    {
+        ++m_requestStatsByType[it.value().m_requestType].m_numAbandoned;
+    }
+
+    m_pendingRequests.clear();
+}
+
+void ModelInstrumentation::reset()
+{
+    m_cacheLookupStatsByItemType.clear();
+    m_requestStatsByType.clear();
+
+    // Pending requests are kept so that their completion is still accounted
+    // for after the reset
+    for(auto it = m_pendingRequests.constBegin(),
+        end = m_pendingRequests.constEnd(); it != end; ++it)
+    {
+        ++m_requestStatsByType[it.value().m_requestType].m_numIssued;
+    }
+}
+
+QJsonObject ModelInstrumentation::toJson() const
+{
+    QJsonObject cacheLookups;
+    for(auto it = m_cacheLookupStatsByItemType.constBegin(),
+        end = m_cacheLookupStatsByItemType.constEnd(); it != end; ++it)
+    {
+        const CacheLookupStats & stats = it.value();
+
+        QJsonObject object;
+        object[QStringLiteral("hits")] = static_cast<double>(stats.m_numHits);
+        object[QStringLiteral("misses")] =
+            static_cast<double>(stats.m_numMisses);
+        cacheLookups[it.key()] = object;
+    }
+
+    QHash<QString, int> numPendingRequestsByType;
+    for(auto it = m_pendingRequests.constBegin(),
+        end = m_pendingRequests.constEnd(); it != end; ++it)
+    {
+        ++numPendingRequestsByType[it.value().m_requestType];
+    }
+
+    QJsonObject requests;
+    for(auto it = m_requestStatsByType.constBegin(),
+        end = m_requestStatsByType.constEnd(); it != end; ++it)
+    {
+        const RequestStats & stats = it.value();
+        quint64 numFinished = stats.m_numCompleted + stats.m_numFailed;
+
+        QJsonObject object;
+        object[QStringLiteral("issued")] =
+            static_cast<double>(stats.m_numIssued);
+        object[QStringLiteral("completed")] =
+            static_cast<double>(stats.m_numCompleted);
+        object[QStringLiteral("failed")] =
+            static_cast<double>(stats.m_numFailed);
+        object[QStringLiteral("abandoned")] =
+            static_cast<double>(stats.m_numAbandoned);
+        object[QStringLiteral("pending")] =
+            numPendingRequestsByType.value(it.key(), 0);
+        object[QStringLiteral("averageLatencyMsec")] =
+            (numFinished > 0
+             ? NSEC_TO_MSEC(stats.m_totalLatencyNsec) / numFinished
+             : 0.0);
+        object[QStringLiteral("maxLatencyMsec")] =
+            NSEC_TO_MSEC(stats.m_maxLatencyNsec);
+        requests[it.key()] = object;
+    }
+
+    QJsonObject object;
+    object[QStringLiteral("model")] = m_modelName;
+    object[QStringLiteral("cacheLookups")] = cacheLookups;
+    object[QStringLiteral("localStorageRequests")] = requests;
+    return object;
+}
+
+void ModelInstrumentation::recordRequestFinished(
+    const QUuid & requestId, const bool success)
+{
+    auto it = m_pendingRequests.find(requestId);
+    if (it == m_pendingRequests.end()) {
+        return;
+    }
+
+    qint64 latencyNsec =
+        m_timer.nsecsElapsed() - it.value().m_issueTimestampNsec;
+
+    RequestStats & stats = m_requestStatsByType[it.value().m_requestType];
+    if (success) {
+        ++stats.m_numCompleted;
+    }
+    else {
+        ++stats.m_numFailed;
+    }
+
+    stats.m_totalLatencyNsec += latencyNsec;
+    stats.m_maxLatencyNsec = std::max(stats.m_maxLatencyNsec, latencyNsec);
+
+    Q_UNUSED(m_pendingRequests.erase(it))
+}
+
+} // namespace quentier
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_MODEL_INSTRUMENTATION_H
+#define QUENTIER_LIB_MODEL_MODEL_INSTRUMENTATION_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The ModelInstrumentation class collects the counters of a model's
+ * interaction with the shared item caches and the local storage: cache hits
+ * and misses per item type and the number and round-trip latency of local
+ * storage requests per request type.
+ *
+ * The request is tracked from the moment it is issued until the model
+ * receives the completion or failure notification for it; notifications
+ * for requests not issued by this model are ignored. Requests still pending
+ * when the model disconnects from the local storage can never finish so the
+ * model is expected to call clearPendingRequests at that point; such requests
+ * are accounted as abandoned.
+ */
+class ModelInstrumentation
+{
+public:
+    explicit ModelInstrumentation(const QString & modelName);
+
+    const QString & modelName() const { return m_modelName; }
+
+    void recordCacheLookup(const QString & itemType, const bool hit);
+
+    void recordRequestIssued(const QString & requestType,
+                             const QUuid & requestId);
+    void recordRequestCompleted(const QUuid & requestId);
+    void recordRequestFailed(const QUuid & requestId);
+
+    void clearPendingRequests();
+
+    void reset();
+
+    /**
+     * @return                  JSON object with the model name, cache lookup
+     *                          counters and local storage request counters;
+     *                          latencies are in milliseconds
+     */
+    QJsonObject toJson() const;
+
+private:
+    void recordRequestFinished(const QUuid & requestId, const bool success);
+
+private:
+    struct CacheLookupStats
+    {
+        CacheLookupStats() : m_numHits(0), m_numMisses(0) {}
+
+        quint64     m_numHits;
+        quint64     m_numMisses;
+    };
+
+    struct RequestStats
+    {
+        RequestStats() :
+            m_numIssued(0),
+            m_numCompleted(0),
+            m_numFailed(0),
+            m_numAbandoned(0),
+            m_totalLatencyNsec(0),
+            m_maxLatencyNsec(0)
+        {}
+
+        quint64     m_numIssued;
+        quint64     m_numCompleted;
+        quint64     m_numFailed;
+        quint64     m_numAbandoned;
+        qint64      m_totalLatencyNsec;
+        qint64      m_maxLatencyNsec;
+    };
+
+    struct PendingRequest
+    {
+        PendingRequest() : m_requestType(), m_issueTimestampNsec(0) {}
+
+        QString     m_requestType;
+        qint64      m_issueTimestampNsec;
+    };
+
+private:
+    QString                             m_modelName;
+    QElapsedTimer                       m_timer;
+
+    QHash<QString, CacheLookupStats>    m_cacheLookupStatsByItemType;
+    QHash<QString, RequestStats>        m_requestStatsByType;
+    QHash<QUuid, PendingRequest>        m_pendingRequests;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_MODEL_INSTRUMENTATION_H
@@ -21,41 +21,79 @@
 
 #include <quentier/utility/Macros.h>
 
+#include <QHash>
 #include <QString>
 
 namespace quentier {
 
-template <class NameIndexType>
-QString newItemName(
-    const NameIndexType & nameIndex, int & newItemCounter, QString baseName)
+/**
+ * The largest suffix handed out so far per uppercased base name: probing
+ * for a free name starts from it so that generating names for many new items
+ * with the same base name doesn't probe all previously generated names
+ * each time while the names with different base names (i.e. the ones
+ * generated before and after the change of the UI language) don't affect
+ * each other's suffixes
+ */
+typedef QHash<QString, int> NewItemNameCounters;
+
+/**
+ * @brief newItemNameByPredicate - generates the name for a new item
+ * of the form "Base name", "Base name (1)", "Base name (2)" etc.
+ *
+ * @param isNameTaken           Callable accepting the uppercased candidate
+ *                              name and returning true if an item with such
+ *                              name already exists
+ * @param newItemCounters       The largest suffixes generated so far per
+ *                              uppercased base name; probing starts from
+ *                              the one for the base name and it is updated
+ *                              to the suffix of the returned name
+ * @param baseName              The base part of the new item's name
+ * @return                      The first name which is not taken
+ */
+template <class IsNameTakenPredicate>
+QString newItemNameByPredicate(
+    const IsNameTakenPredicate & isNameTaken,
+    NewItemNameCounters & newItemCounters, const QString & baseName)
 {
-    if (newItemCounter != 0) {
-        baseName += QStringLiteral(" (") +
-                    QString::number(newItemCounter) +
-                    QStringLiteral(")");
-    }
+    // The suffix consists of digits and parentheses only so the uppercased
+    // candidate name can be built from the base name uppercased once
+    const QString baseNameUpper = baseName.toUpper();
+    int & newItemCounter = newItemCounters[baseNameUpper];
 
     while(true)
     {
-        auto it = nameIndex.find(baseName.toUpper());
-        if (it == nameIndex.end()) {
-            return baseName;
+        QString suffix;
+        if (newItemCounter != 0) {
+            suffix = QStringLiteral(" (") +
+                     QString::number(newItemCounter) +
+                     QStringLiteral(")");
         }
 
-        if (newItemCounter != 0) {
-            QString numPart = QStringLiteral(" (") +
-                              QString::number(newItemCounter) +
-                              QStringLiteral(")");
-            baseName.chop(numPart.length());
+        if (!isNameTaken(baseNameUpper + suffix)) {
+            return baseName + suffix;
         }
 
         ++newItemCounter;
-        baseName += QStringLiteral(" (") +
-                    QString::number(newItemCounter) +
-                    QStringLiteral(")");
     }
 }
 
+/**
+ * @brief newItemName - generates the name for a new item using the index
+ * of uppercased names of existing items which must provide find and end
+ * methods
+ */
+template <class NameIndexType>
+QString newItemName(
+    const NameIndexType & nameIndex, NewItemNameCounters & newItemCounters,
+    const QString & baseName)
+{
+    return newItemNameByPredicate(
+        [&nameIndex](const QString & nameUpper) -> bool {
+            return nameIndex.find(nameUpper) != nameIndex.end();
+        },
+        newItemCounters, baseName);
+}
+
 } // namespace quentier
 
 #endif // QUENTIER_LIB_MODEL_NEW_ITEM_NAME_GENERATOR_HPP
@@ -19,12 +19,64 @@
 #ifndef QUENTIER_LIB_MODEL_NOTE_CACHE_H
 #define QUENTIER_LIB_MODEL_NOTE_CACHE_H
 
-#include <quentier/utility/LRUCache.hpp>
+#include "ItemCache.hpp"
+
 #include <quentier/types/Note.h>
+#include <quentier/types/Resource.h>
 
 namespace quentier {
 
-typedef LRUCache<QString, Note> NoteCache;
+/**
+ * @brief The NoteCacheCostEstimator struct estimates the memory occupied
+ * by the note: its content and the binary data of its resources dominate
+ * the size of all the rest
+ */
+struct NoteCacheCostEstimator
+{
+    quint64 operator()(const Note & note) const
+    {
+        quint64 cost = sizeof(Note);
+
+        if (note.hasTitle()) {
+            cost += static_cast<quint64>(note.title().size()) * sizeof(QChar);
+        }
+
+        if (note.hasContent()) {
+            cost += static_cast<quint64>(note.content().size()) *
+                    sizeof(QChar);
+        }
+
+        if (!note.hasResources()) {
+            return cost;
+        }
+
+        QList<Resource> resources = note.resources();
+        for(auto it = resources.constBegin(),
+            end = resources.constEnd(); it != end; ++it)
+        {
+            const Resource & resource = *it;
+            cost += sizeof(Resource);
+
+            if (resource.hasDataBody()) {
+                cost += static_cast<quint64>(resource.dataBody().size());
+            }
+
+            if (resource.hasAlternateDataBody()) {
+                cost += static_cast<quint64>(
+                    resource.alternateDataBody().size());
+            }
+
+            if (resource.hasRecognitionDataBody()) {
+                cost += static_cast<quint64>(
+                    resource.recognitionDataBody().size());
+            }
+        }
+
+        return cost;
+    }
+};
+
+typedef ItemCache<QString, Note, NoteCacheCostEstimator> NoteCache;
 
 } // namespace quentier
 
@@ -0,0 +1,988 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteIndexAsync.h"
+#include "NoteSummaryListerAsync.h"
+
+#include <quentier/local_storage/LocalStorageManager.h>
+#include <quentier/logging/QuentierLogger.h>
+
+#include <QTimer>
+#include <QTimerEvent>
+
+#include <algorithm>
+
+// Number of notes listed from the local storage at once while building
+// the note index
+#define NOTE_INDEX_BUILD_BATCH_SIZE (500)
+
+// Number of notes listed from the local storage at once while ordering
+// the notes with the given local uids
+#define NOTE_ORDERING_BATCH_SIZE (500)
+
+// The note index is released if no request has used it for this long
+#define NOTE_INDEX_EXPIRATION_MSEC (600000)
+
+// Number of query results and ordered lists of local uids kept for paging,
+// enough for all models which might page through different queries at once
+#define NOTE_LISTING_CACHE_SIZE (4)
+
+namespace quentier {
+
+NoteIndexQuery::NoteIndexQuery() :
+    m_notebookLocalUids(),
+    m_tagLocalUids(),
+    m_includeNonDeletedNotes(true),
+    m_includeDeletedNotes(true),
+    m_order(LocalStorageManager::ListNotesOrder::NoOrder),
+    m_orderBySize(false)
+{}
+
+bool NoteIndexQuery::operator==(const NoteIndexQuery & other) const
+{
+    return (m_notebookLocalUids == other.m_notebookLocalUids) &&
+           (m_tagLocalUids == other.m_tagLocalUids) &&
+           (m_includeNonDeletedNotes == other.m_includeNonDeletedNotes) &&
+           (m_includeDeletedNotes == other.m_includeDeletedNotes) &&
+           (m_order == other.m_order) &&
+           (m_orderBySize == other.m_orderBySize);
+}
+
+bool NoteIndexQuery::operator!=(const NoteIndexQuery & other) const
+{
+    return !(*this == other);
+}
+
+NoteIndexAsync::NoteIndexAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_noteIndex(),
+    m_noteIndexBuilt(false),
+    m_noteIndexBuilding(false),
+    m_noteIndexBuildOffset(0),
+    m_pendingIndexedNoteSummariesRequests(),
+    m_noteIndexExpirationTimer(),
+    m_noteIndexQueryResults(),
+    m_orderedNoteLocalUids()
+{
+    qRegisterMetaType<QList<NoteModelItem> >("QList<NoteModelItem>");
+    qRegisterMetaType<NoteIndexQuery>("NoteIndexQuery");
+
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,addNoteComplete,
+                              Note,QUuid),
+                     this,
+                     QNSLOT(NoteIndexAsync,onAddNoteComplete,
+                            Note,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,updateNoteComplete,
+                              Note,LocalStorageManager::UpdateNoteOptions,QUuid),
+                     this,
+                     QNSLOT(NoteIndexAsync,onUpdateNoteComplete,
+                            Note,LocalStorageManager::UpdateNoteOptions,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,expungeNoteComplete,
+                              Note,QUuid),
+                     this,
+                     QNSLOT(NoteIndexAsync,onExpungeNoteComplete,
+                            Note,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,expungeNotebookComplete,
+                              Notebook,QUuid),
+                     this,
+                     QNSLOT(NoteIndexAsync,onExpungeNotebookComplete,
+                            Notebook,QUuid));
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,expungeTagComplete,
+                              Tag,QStringList,QUuid),
+                     this,
+                     QNSLOT(NoteIndexAsync,onExpungeTagComplete,
+                            Tag,QStringList,QUuid));
+}
+
+NoteIndexAsync::~NoteIndexAsync()
+{}
+
+void NoteIndexAsync::onListIndexedNoteSummariesRequest(
+    NoteIndexQuery query, LocalStorageManager::OrderDirection orderDirection,
+    size_t limit, size_t offset, QUuid requestId)
+{
+    QNDEBUG("NoteIndexAsync::onListIndexedNoteSummariesRequest: "
+            << "limit = " << limit << ", offset = " << offset
+            << ", order = " << query.m_order << ", order by size = "
+            << (query.m_orderBySize ? "true" : "false")
+            << ", direction = " << orderDirection
+            << ", include non-deleted notes = "
+            << (query.m_includeNonDeletedNotes ? "true" : "false")
+            << ", include deleted notes = "
+            << (query.m_includeDeletedNotes ? "true" : "false")
+            << ", notebook local uids: "
+            << query.m_notebookLocalUids.join(QStringLiteral(", "))
+            << ", tag local uids: "
+            << query.m_tagLocalUids.join(QStringLiteral(", "))
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    IndexedNoteSummariesRequest request;
+    request.m_query = query;
+    request.m_orderDirection = orderDirection;
+    request.m_limit = limit;
+    request.m_offset = offset;
+    request.m_requestId = requestId;
+
+    if (!m_noteIndexBuilt)
+    {
+        QNDEBUG("The note index is not built yet, postponing the request");
+        m_pendingIndexedNoteSummariesRequests << request;
+
+        if (!m_noteIndexBuilding) {
+            startNoteIndexBuilding();
+        }
+
+        return;
+    }
+
+    listIndexedNoteSummaries(*pLocalStorageManager, request);
+}
+
+void NoteIndexAsync::onListOrderedNoteSummariesByLocalUidsRequest(
+    QStringList noteLocalUids, LocalStorageManager::ListObjectsOptions flag,
+    size_t limit, size_t offset, LocalStorageManager::ListNotesOrder order,
+    bool orderBySize, LocalStorageManager::OrderDirection orderDirection,
+    QUuid requestId)
+{
+    QNDEBUG("NoteIndexAsync::"
+            << "onListOrderedNoteSummariesByLocalUidsRequest: flag = " << flag
+            << ", limit = " << limit << ", offset = " << offset
+            << ", order = " << order << ", order by size = "
+            << (orderBySize ? "true" : "false")
+            << ", direction = " << orderDirection
+            << ", num note local uids = " << noteLocalUids.size()
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    const QStringList * pOrderedNoteLocalUids =
+        findOrderedNoteLocalUids(noteLocalUids, order, orderBySize);
+    if (!pOrderedNoteLocalUids)
+    {
+        if (!buildOrderedNoteLocalUids(*pLocalStorageManager, noteLocalUids,
+                                       order, orderBySize, errorDescription))
+        {
+            Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+            return;
+        }
+
+        pOrderedNoteLocalUids =
+            &(m_orderedNoteLocalUids.front().m_noteLocalUids);
+    }
+
+    QStringList page = pageNoteLocalUids(*pOrderedNoteLocalUids,
+                                         orderDirection, limit, offset);
+    listNoteSummariesPage(*pLocalStorageManager, page, flag, requestId);
+}
+
+bool NoteIndexAsync::countNotes(
+    const LocalStorageManager::NoteCountOptions options,
+    QHash<QString, int> & noteCountsPerNotebookLocalUid,
+    QHash<QString, int> & noteCountsPerTagLocalUid,
+    const bool addMissingNotebooks) const
+{
+    if (!m_noteIndexBuilt) {
+        return false;
+    }
+
+    bool includeNonDeletedNotes = options.testFlag(
+        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    bool includeDeletedNotes = options.testFlag(
+        LocalStorageManager::NoteCountOption::IncludeDeletedNotes);
+
+    for(auto it = m_noteIndex.constBegin(),
+        end = m_noteIndex.constEnd(); it != end; ++it)
+    {
+        const NoteIndexEntry & entry = it.value();
+        if (entry.m_deleted ? !includeDeletedNotes : !includeNonDeletedNotes) {
+            continue;
+        }
+
+        auto notebookCountIt =
+            noteCountsPerNotebookLocalUid.find(entry.m_notebookLocalUid);
+        if (notebookCountIt != noteCountsPerNotebookLocalUid.end()) {
+            ++notebookCountIt.value();
+        }
+        else if (addMissingNotebooks) {
+            noteCountsPerNotebookLocalUid[entry.m_notebookLocalUid] = 1;
+        }
+
+        if (noteCountsPerTagLocalUid.isEmpty()) {
+            continue;
+        }
+
+        for(auto tagIt = entry.m_tagLocalUids.constBegin(),
+            tagEnd = entry.m_tagLocalUids.constEnd(); tagIt != tagEnd; ++tagIt)
+        {
+            auto tagCountIt = noteCountsPerTagLocalUid.find(*tagIt);
+            if (tagCountIt != noteCountsPerTagLocalUid.end()) {
+                ++tagCountIt.value();
+            }
+        }
+    }
+
+    return true;
+}
+
+void NoteIndexAsync::onAddNoteComplete(Note note, QUuid requestId)
+{
+    Q_UNUSED(requestId)
+    addOrUpdateNoteIndexEntry(note);
+}
+
+void NoteIndexAsync::onUpdateNoteComplete(
+    Note note, LocalStorageManager::UpdateNoteOptions options, QUuid requestId)
+{
+    Q_UNUSED(options)
+    Q_UNUSED(requestId)
+    addOrUpdateNoteIndexEntry(note);
+    invalidateOrderedNoteLocalUids(note.localUid());
+}
+
+void NoteIndexAsync::onExpungeNoteComplete(Note note, QUuid requestId)
+{
+    Q_UNUSED(requestId)
+    removeNoteIndexEntry(note.localUid());
+    invalidateOrderedNoteLocalUids(note.localUid());
+}
+
+void NoteIndexAsync::onExpungeNotebookComplete(
+    Notebook notebook, QUuid requestId)
+{
+    Q_UNUSED(requestId)
+
+    if (!m_noteIndexBuilt && !m_noteIndexBuilding) {
+        return;
+    }
+
+    for(auto it = m_noteIndex.begin(); it != m_noteIndex.end(); )
+    {
+        if (it->m_notebookLocalUid == notebook.localUid())
+        {
+            // See the comment in removeNoteIndexEntry
+            if (m_noteIndexBuilding && (m_noteIndexBuildOffset > 0)) {
+                --m_noteIndexBuildOffset;
+            }
+
+            it = m_noteIndex.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    m_noteIndexQueryResults.clear();
+}
+
+void NoteIndexAsync::onExpungeTagComplete(
+    Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
+{
+    Q_UNUSED(requestId)
+
+    if (!m_noteIndexBuilt && !m_noteIndexBuilding) {
+        return;
+    }
+
+    QStringList expungedTagLocalUids = expungedChildTagLocalUids;
+    expungedTagLocalUids << tag.localUid();
+
+    for(auto it = m_noteIndex.begin(), end = m_noteIndex.end(); it != end; ++it)
+    {
+        QStringList & tagLocalUids = it->m_tagLocalUids;
+        for(auto tagIt = expungedTagLocalUids.constBegin(),
+            tagEnd = expungedTagLocalUids.constEnd(); tagIt != tagEnd; ++tagIt)
+        {
+            Q_UNUSED(tagLocalUids.removeAll(*tagIt))
+        }
+    }
+
+    m_noteIndexQueryResults.clear();
+}
+
+void NoteIndexAsync::buildNoteIndexBatch()
+{
+    if (!m_noteIndexBuilding) {
+        return;
+    }
+
+    QNDEBUG("NoteIndexAsync::buildNoteIndexBatch: offset = "
+            << m_noteIndexBuildOffset);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        finishNoteIndexBuilding(errorDescription);
+        return;
+    }
+
+    // NOTE: the notes are listed in the order of modification so that
+    // the notes added or updated while the index is being built go to the end
+    // of the list rather than somewhere before the offset
+    QList<Note> notes = pLocalStorageManager->listNotes(
+        LocalStorageManager::ListObjectsOption::ListAll,
+        NoteSummaryListerAsync::noteSummaryOptions(), errorDescription,
+        NOTE_INDEX_BUILD_BATCH_SIZE, m_noteIndexBuildOffset,
+        LocalStorageManager::ListNotesOrder::ByModificationTimestamp,
+        LocalStorageManager::OrderDirection::Ascending, QString());
+    if (notes.isEmpty() && !errorDescription.isEmpty()) {
+        finishNoteIndexBuilding(errorDescription);
+        return;
+    }
+
+    for(auto it = notes.constBegin(), end = notes.constEnd(); it != end; ++it)
+    {
+        NoteIndexEntry entry;
+        noteToIndexEntry(*it, entry, false);
+        m_noteIndex[entry.m_localUid] = entry;
+    }
+
+    m_noteIndexBuildOffset += static_cast<size_t>(notes.size());
+
+    if (notes.size() < NOTE_INDEX_BUILD_BATCH_SIZE) {
+        finishNoteIndexBuilding(ErrorString());
+        return;
+    }
+
+    // NOTE: building the index batch by batch lets the local storage thread
+    // process the requests which have arrived in the meantime
+    QTimer::singleShot(0, this, SLOT(buildNoteIndexBatch()));
+}
+
+void NoteIndexAsync::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_noteIndexExpirationTimer.timerId())
+    {
+        m_noteIndexExpirationTimer.stop();
+
+        if (!m_noteIndexBuilt) {
+            return;
+        }
+
+        QNDEBUG("Releasing the note index unused for "
+                << NOTE_INDEX_EXPIRATION_MSEC << " msec");
+
+        m_noteIndex.clear();
+        m_noteIndex.squeeze();
+        m_noteIndexBuilt = false;
+        m_noteIndexQueryResults.clear();
+        return;
+    }
+
+    QObject::timerEvent(pEvent);
+}
+
+LocalStorageManager * NoteIndexAsync::localStorageManager(
+    ErrorString & errorDescription)
+{
+    LocalStorageManager * pLocalStorageManager =
+        m_localStorageManagerAsync.localStorageManager();
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        errorDescription.setBase(QT_TR_NOOP("Can't list notes: local storage "
+                                            "is not initialized yet"));
+        QNWARNING(errorDescription);
+    }
+
+    return pLocalStorageManager;
+}
+
+void NoteIndexAsync::noteToIndexEntry(
+    const Note & note, NoteIndexEntry & entry, const bool withPreviewText)
+{
+    NoteModelItem summary;
+    NoteSummaryListerAsync::noteToSummary(note, summary, false);
+
+    entry.m_localUid = summary.localUid();
+    entry.m_notebookLocalUid = summary.notebookLocalUid();
+    entry.m_tagLocalUids = summary.tagLocalUids();
+    entry.m_creationTimestamp = summary.creationTimestamp();
+    entry.m_modificationTimestamp = summary.modificationTimestamp();
+    entry.m_sizeInBytes = summary.sizeInBytes();
+    entry.m_deleted = note.hasDeletionTimestamp();
+
+    // Notes without title are ordered by their preview texts the same way
+    // the note model orders them
+    if (!summary.title().isEmpty()) {
+        entry.m_titleOrPreviewText = summary.title();
+    }
+    else if (withPreviewText) {
+        entry.m_titleOrPreviewText =
+            NoteSummaryListerAsync::notePreviewText(note);
+    }
+    else {
+        entry.m_needsPreviewText = note.hasContent();
+    }
+}
+
+QStringList NoteIndexAsync::pageNoteLocalUids(
+    const QStringList & orderedNoteLocalUids,
+    const LocalStorageManager::OrderDirection orderDirection,
+    const size_t limit, const size_t offset)
+{
+    bool descending =
+        (orderDirection == LocalStorageManager::OrderDirection::Descending);
+
+    int size = orderedNoteLocalUids.size();
+    int first = std::min(static_cast<int>(offset), size);
+    int last = size;
+    if (limit != 0) {
+        last = std::min(first + static_cast<int>(limit), size);
+    }
+
+    QStringList page;
+    page.reserve(last - first);
+    for(int i = first; i < last; ++i) {
+        page << orderedNoteLocalUids[descending ? (size - 1 - i) : i];
+    }
+
+    return page;
+}
+
+void NoteIndexAsync::startNoteIndexBuilding()
+{
+    QNDEBUG("NoteIndexAsync::startNoteIndexBuilding");
+
+    m_noteIndex.clear();
+    m_noteIndexQueryResults.clear();
+    m_noteIndexBuilding = true;
+    m_noteIndexBuildOffset = 0;
+
+    buildNoteIndexBatch();
+}
+
+void NoteIndexAsync::finishNoteIndexBuilding(
+    const ErrorString & errorDescription)
+{
+    m_noteIndexBuilding = false;
+    m_noteIndexBuildOffset = 0;
+
+    QList<IndexedNoteSummariesRequest> requests =
+        m_pendingIndexedNoteSummariesRequests;
+    m_pendingIndexedNoteSummariesRequests.clear();
+
+    if (!errorDescription.isEmpty())
+    {
+        QNWARNING("Failed to build the note index: " << errorDescription);
+        m_noteIndex.clear();
+
+        for(auto it = requests.constBegin(), end = requests.constEnd();
+            it != end; ++it)
+        {
+            Q_EMIT listNoteSummariesFailed(errorDescription, it->m_requestId);
+        }
+
+        return;
+    }
+
+    m_noteIndexBuilt = true;
+    QNDEBUG("Built the note index for " << m_noteIndex.size() << " notes");
+
+    ErrorString error;
+    LocalStorageManager * pLocalStorageManager = localStorageManager(error);
+    for(auto it = requests.constBegin(), end = requests.constEnd();
+        it != end; ++it)
+    {
+        if (Q_UNLIKELY(!pLocalStorageManager)) {
+            Q_EMIT listNoteSummariesFailed(error, it->m_requestId);
+            continue;
+        }
+
+        listIndexedNoteSummaries(*pLocalStorageManager, *it);
+    }
+}
+
+void NoteIndexAsync::addOrUpdateNoteIndexEntry(const Note & note)
+{
+    if (!m_noteIndexBuilt && !m_noteIndexBuilding) {
+        // The index would be built from the local storage contents when
+        // it is needed
+        return;
+    }
+
+    NoteIndexEntry entry;
+    noteToIndexEntry(note, entry, false);
+
+    auto it = m_noteIndex.find(note.localUid());
+    if (it != m_noteIndex.end())
+    {
+        // The updated note might come without notebook local uid or tags,
+        // in that case the previously known ones are kept
+        if (!note.hasNotebookLocalUid()) {
+            entry.m_notebookLocalUid = it->m_notebookLocalUid;
+        }
+
+        if (!note.hasTagLocalUids()) {
+            entry.m_tagLocalUids = it->m_tagLocalUids;
+        }
+
+        // The updated note moves to the end of the list of notes being
+        // indexed, see the comment in removeNoteIndexEntry
+        if (m_noteIndexBuilding && (m_noteIndexBuildOffset > 0)) {
+            --m_noteIndexBuildOffset;
+        }
+    }
+
+    m_noteIndex[entry.m_localUid] = entry;
+    m_noteIndexQueryResults.clear();
+}
+
+void NoteIndexAsync::removeNoteIndexEntry(const QString & noteLocalUid)
+{
+    auto it = m_noteIndex.find(noteLocalUid);
+    if (it == m_noteIndex.end()) {
+        return;
+    }
+
+    // NOTE: while the index is being built, a note which has already been
+    // listed leaving its place shifts the notes not listed yet back by one
+    // so the offset is decreased for none of them to be skipped; the notes
+    // which might get listed twice because of that are harmless
+    if (m_noteIndexBuilding && (m_noteIndexBuildOffset > 0)) {
+        --m_noteIndexBuildOffset;
+    }
+
+    Q_UNUSED(m_noteIndex.erase(it))
+    m_noteIndexQueryResults.clear();
+}
+
+void NoteIndexAsync::listIndexedNoteSummaries(
+    LocalStorageManager & localStorageManager,
+    const IndexedNoteSummariesRequest & request)
+{
+    m_noteIndexExpirationTimer.start(NOTE_INDEX_EXPIRATION_MSEC, this);
+
+    // NOTE: the models page through the same queries so the results of
+    // the recent queries are kept until the index changes
+    const QStringList * pNoteLocalUids =
+        findNoteIndexQueryResult(request.m_query);
+    if (!pNoteLocalUids)
+    {
+        ErrorString errorDescription;
+        if (!runNoteIndexQuery(localStorageManager, request.m_query,
+                               errorDescription))
+        {
+            Q_EMIT listNoteSummariesFailed(errorDescription,
+                                           request.m_requestId);
+            return;
+        }
+
+        pNoteLocalUids = &(m_noteIndexQueryResults.front().m_noteLocalUids);
+    }
+
+    QStringList page = pageNoteLocalUids(*pNoteLocalUids,
+                                         request.m_orderDirection,
+                                         request.m_limit, request.m_offset);
+    listNoteSummariesPage(localStorageManager, page,
+                          LocalStorageManager::ListObjectsOption::ListAll,
+                          request.m_requestId);
+}
+
+const QStringList * NoteIndexAsync::findNoteIndexQueryResult(
+    const NoteIndexQuery & query)
+{
+    for(int i = 0, size = m_noteIndexQueryResults.size(); i < size; ++i)
+    {
+        if (m_noteIndexQueryResults[i].m_query != query) {
+            continue;
+        }
+
+        if (i != 0) {
+            m_noteIndexQueryResults.move(i, 0);
+        }
+
+        return &(m_noteIndexQueryResults.front().m_noteLocalUids);
+    }
+
+    return nullptr;
+}
+
+bool NoteIndexAsync::runNoteIndexQuery(
+    LocalStorageManager & localStorageManager, const NoteIndexQuery & query,
+    ErrorString & errorDescription)
+{
+    QNDEBUG("NoteIndexAsync::runNoteIndexQuery");
+
+    QSet<QString> notebookLocalUids =
+        QSet<QString>::fromList(query.m_notebookLocalUids);
+    QSet<QString> tagLocalUids = QSet<QString>::fromList(query.m_tagLocalUids);
+
+    QVector<NoteIndexEntry> entries;
+    entries.reserve(m_noteIndex.size());
+
+    for(auto it = m_noteIndex.constBegin(),
+        end = m_noteIndex.constEnd(); it != end; ++it)
+    {
+        const NoteIndexEntry & entry = it.value();
+
+        if (entry.m_deleted ? !query.m_includeDeletedNotes
+                            : !query.m_includeNonDeletedNotes)
+        {
+            continue;
+        }
+
+        if (!notebookLocalUids.isEmpty() &&
+            !notebookLocalUids.contains(entry.m_notebookLocalUid))
+        {
+            continue;
+        }
+
+        if (!tagLocalUids.isEmpty())
+        {
+            bool foundTag = false;
+            for(auto tagIt = entry.m_tagLocalUids.constBegin(),
+                tagEnd = entry.m_tagLocalUids.constEnd();
+                tagIt != tagEnd; ++tagIt)
+            {
+                if (tagLocalUids.contains(*tagIt)) {
+                    foundTag = true;
+                    break;
+                }
+            }
+
+            if (!foundTag) {
+                continue;
+            }
+        }
+
+        entries << entry;
+    }
+
+    if (!query.m_orderBySize &&
+        (query.m_order == LocalStorageManager::ListNotesOrder::ByTitle) &&
+        !computeNoteIndexPreviewTexts(localStorageManager, entries,
+                                      errorDescription))
+    {
+        return false;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              NoteIndexEntryLess(query.m_orderBySize, query.m_order));
+
+    NoteIndexQueryResult result;
+    result.m_query = query;
+    result.m_noteLocalUids.reserve(entries.size());
+    for(auto it = entries.constBegin(), end = entries.constEnd(); it != end; ++it) {
+        result.m_noteLocalUids << it->m_localUid;
+    }
+
+    QNDEBUG("Found " << result.m_noteLocalUids.size()
+            << " notes matching the query");
+
+    m_noteIndexQueryResults.prepend(result);
+    while(m_noteIndexQueryResults.size() > NOTE_LISTING_CACHE_SIZE) {
+        m_noteIndexQueryResults.removeLast();
+    }
+
+    return true;
+}
+
+bool NoteIndexAsync::computeNoteIndexPreviewTexts(
+    LocalStorageManager & localStorageManager,
+    QVector<NoteIndexEntry> & entries, ErrorString & errorDescription)
+{
+    QStringList noteLocalUids;
+    for(auto it = entries.constBegin(), end = entries.constEnd();
+        it != end; ++it)
+    {
+        if (it->m_needsPreviewText) {
+            noteLocalUids << it->m_localUid;
+        }
+    }
+
+    if (noteLocalUids.isEmpty()) {
+        return true;
+    }
+
+    QNDEBUG("NoteIndexAsync::computeNoteIndexPreviewTexts: "
+            << "num notes without title = " << noteLocalUids.size());
+
+    QHash<QString, QString> previewTextsByNoteLocalUid;
+    previewTextsByNoteLocalUid.reserve(noteLocalUids.size());
+
+    for(int first = 0, size = noteLocalUids.size(); first < size;
+        first += NOTE_ORDERING_BATCH_SIZE)
+    {
+        QStringList chunk = noteLocalUids.mid(first, NOTE_ORDERING_BATCH_SIZE);
+        QList<Note> notes = localStorageManager.listNotesByLocalUids(
+            chunk, LocalStorageManager::GetNoteOptions(0), errorDescription,
+            LocalStorageManager::ListObjectsOption::ListAll, 0, 0,
+            LocalStorageManager::ListNotesOrder::NoOrder,
+            LocalStorageManager::OrderDirection::Ascending);
+        if (notes.isEmpty() && !errorDescription.isEmpty()) {
+            QNWARNING("Failed to compute preview texts for notes without "
+                      << "title: " << errorDescription);
+            return false;
+        }
+
+        for(auto it = notes.constBegin(), end = notes.constEnd();
+            it != end; ++it)
+        {
+            QString previewText = NoteSummaryListerAsync::notePreviewText(*it);
+            previewTextsByNoteLocalUid[it->localUid()] = previewText;
+
+            // The preview text is kept in the index until the note is updated
+            auto indexIt = m_noteIndex.find(it->localUid());
+            if (indexIt != m_noteIndex.end()) {
+                indexIt->m_titleOrPreviewText = previewText;
+                indexIt->m_needsPreviewText = false;
+            }
+        }
+    }
+
+    for(auto it = entries.begin(), end = entries.end(); it != end; ++it)
+    {
+        if (!it->m_needsPreviewText) {
+            continue;
+        }
+
+        it->m_titleOrPreviewText =
+            previewTextsByNoteLocalUid.value(it->m_localUid);
+        it->m_needsPreviewText = false;
+    }
+
+    return true;
+}
+
+const QStringList * NoteIndexAsync::findOrderedNoteLocalUids(
+    const QStringList & noteLocalUids,
+    const LocalStorageManager::ListNotesOrder order, const bool orderBySize)
+{
+    // NOTE: comparing the lists is cheap when the same list is passed for
+    // every page since QStringList compares the shared data first
+    for(int i = 0, size = m_orderedNoteLocalUids.size(); i < size; ++i)
+    {
+        const OrderedNoteLocalUids & ordered = m_orderedNoteLocalUids[i];
+        if ((ordered.m_order != order) ||
+            (ordered.m_orderBySize != orderBySize) ||
+            (ordered.m_sourceNoteLocalUids != noteLocalUids))
+        {
+            continue;
+        }
+
+        if (i != 0) {
+            m_orderedNoteLocalUids.move(i, 0);
+        }
+
+        return &(m_orderedNoteLocalUids.front().m_noteLocalUids);
+    }
+
+    return nullptr;
+}
+
+bool NoteIndexAsync::buildOrderedNoteLocalUids(
+    LocalStorageManager & localStorageManager, const QStringList & noteLocalUids,
+    const LocalStorageManager::ListNotesOrder order, const bool orderBySize,
+    ErrorString & errorDescription)
+{
+    QNDEBUG("NoteIndexAsync::buildOrderedNoteLocalUids: "
+            << "num note local uids = " << noteLocalUids.size()
+            << ", order = " << order << ", order by size = "
+            << (orderBySize ? "true" : "false"));
+
+    // Only the notes without title ordered by title need preview texts
+    bool withPreviewText = !orderBySize &&
+        (order == LocalStorageManager::ListNotesOrder::ByTitle);
+
+    QVector<NoteIndexEntry> entries;
+    entries.reserve(noteLocalUids.size());
+
+    if (m_noteIndexBuilt)
+    {
+        m_noteIndexExpirationTimer.start(NOTE_INDEX_EXPIRATION_MSEC, this);
+
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            auto entryIt = m_noteIndex.constFind(*it);
+            if (entryIt != m_noteIndex.constEnd()) {
+                entries << entryIt.value();
+            }
+        }
+
+        if (withPreviewText &&
+            !computeNoteIndexPreviewTexts(localStorageManager, entries,
+                                          errorDescription))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        // NOTE: the notes are listed by chunks of local uids rather than by
+        // offsets within the whole list so that the local storage doesn't need
+        // to process the entire list of local uids for each chunk
+        for(int first = 0, size = noteLocalUids.size(); first < size;
+            first += NOTE_ORDERING_BATCH_SIZE)
+        {
+            QStringList chunk = noteLocalUids.mid(first, NOTE_ORDERING_BATCH_SIZE);
+            QList<Note> notes = localStorageManager.listNotesByLocalUids(
+                chunk, NoteSummaryListerAsync::noteSummaryOptions(),
+                errorDescription,
+                LocalStorageManager::ListObjectsOption::ListAll, 0, 0,
+                LocalStorageManager::ListNotesOrder::NoOrder,
+                LocalStorageManager::OrderDirection::Ascending);
+            if (notes.isEmpty() && !errorDescription.isEmpty()) {
+                QNWARNING("Failed to order the notes by local uids: "
+                          << errorDescription);
+                return false;
+            }
+
+            for(auto it = notes.constBegin(), end = notes.constEnd();
+                it != end; ++it)
+            {
+                NoteIndexEntry entry;
+                noteToIndexEntry(*it, entry, withPreviewText);
+                entries << entry;
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              NoteIndexEntryLess(orderBySize, order));
+
+    OrderedNoteLocalUids ordered;
+    ordered.m_sourceNoteLocalUids = noteLocalUids;
+    ordered.m_order = order;
+    ordered.m_orderBySize = orderBySize;
+    ordered.m_noteLocalUids.reserve(entries.size());
+    ordered.m_noteLocalUidsSet.reserve(entries.size());
+    for(auto it = entries.constBegin(), end = entries.constEnd(); it != end; ++it) {
+        ordered.m_noteLocalUids << it->m_localUid;
+        Q_UNUSED(ordered.m_noteLocalUidsSet.insert(it->m_localUid))
+    }
+
+    QNDEBUG("Ordered " << ordered.m_noteLocalUids.size() << " notes");
+
+    m_orderedNoteLocalUids.prepend(ordered);
+    while(m_orderedNoteLocalUids.size() > NOTE_LISTING_CACHE_SIZE) {
+        m_orderedNoteLocalUids.removeLast();
+    }
+
+    return true;
+}
+
+void NoteIndexAsync::invalidateOrderedNoteLocalUids(
+    const QString & noteLocalUid)
+{
+    for(auto it = m_orderedNoteLocalUids.begin();
+        it != m_orderedNoteLocalUids.end(); )
+    {
+        if (!it->m_noteLocalUidsSet.contains(noteLocalUid)) {
+            ++it;
+            continue;
+        }
+
+        QNDEBUG("NoteIndexAsync::invalidateOrderedNoteLocalUids: "
+                << noteLocalUid);
+        it = m_orderedNoteLocalUids.erase(it);
+    }
+}
+
+bool NoteIndexAsync::NoteIndexEntryLess::operator()(
+    const NoteIndexEntry & lhs, const NoteIndexEntry & rhs) const
+{
+    // NOTE: the notes equal by the sorting key are ordered by local uid so
+    // that the order stays the same between the queries and the pages don't
+    // overlap
+
+    if (m_orderBySize)
+    {
+        if (lhs.m_sizeInBytes != rhs.m_sizeInBytes) {
+            return lhs.m_sizeInBytes < rhs.m_sizeInBytes;
+        }
+
+        return lhs.m_localUid < rhs.m_localUid;
+    }
+
+    switch(m_order)
+    {
+    case LocalStorageManager::ListNotesOrder::ByTitle:
+        {
+            int compareResult = lhs.m_titleOrPreviewText.localeAwareCompare(
+                rhs.m_titleOrPreviewText);
+            if (compareResult != 0) {
+                return (compareResult < 0);
+            }
+            break;
+        }
+    case LocalStorageManager::ListNotesOrder::ByCreationTimestamp:
+        if (lhs.m_creationTimestamp != rhs.m_creationTimestamp) {
+            return lhs.m_creationTimestamp < rhs.m_creationTimestamp;
+        }
+        break;
+    case LocalStorageManager::ListNotesOrder::NoOrder:
+        break;
+    default:
+        if (lhs.m_modificationTimestamp != rhs.m_modificationTimestamp) {
+            return lhs.m_modificationTimestamp < rhs.m_modificationTimestamp;
+        }
+        break;
+    }
+
+    return lhs.m_localUid < rhs.m_localUid;
+}
+
+void NoteIndexAsync::listNoteSummariesPage(
+    LocalStorageManager & localStorageManager,
+    const QStringList & pageNoteLocalUids,
+    const LocalStorageManager::ListObjectsOptions flag,
+    const QUuid & requestId)
+{
+    ErrorString errorDescription;
+    QList<NoteModelItem> summaries =
+        NoteSummaryListerAsync::listNoteSummariesPage(
+            localStorageManager, pageNoteLocalUids, flag, errorDescription);
+    if (summaries.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list notes: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    QNTRACE("Listed " << summaries.size() << " note summaries, request id = "
+            << requestId);
+    Q_EMIT listNoteSummariesComplete(summaries, requestId);
+}
+
+} // namespace quentier
@@ -0,0 +1,359 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_INDEX_ASYNC_H
+#define QUENTIER_LIB_MODEL_NOTE_INDEX_ASYNC_H
+
+#include "NoteModelItem.h"
+
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/types/Note.h>
+#include <quentier/types/Notebook.h>
+#include <quentier/types/Tag.h>
+
+#include <QBasicTimer>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QUuid>
+#include <QVector>
+
+namespace quentier {
+
+/**
+ * @brief The NoteIndexQuery struct describes the notes to be listed from
+ * the note index maintained by NoteIndexAsync
+ */
+struct NoteIndexQuery
+{
+    NoteIndexQuery();
+
+    bool operator==(const NoteIndexQuery & other) const;
+    bool operator!=(const NoteIndexQuery & other) const;
+
+    // If not empty, only the notes from these notebooks are listed
+    QStringList m_notebookLocalUids;
+
+    // If not empty, only the notes labeled with any of these tags are listed
+    QStringList m_tagLocalUids;
+
+    bool        m_includeNonDeletedNotes;
+    bool        m_includeDeletedNotes;
+
+    LocalStorageManager::ListNotesOrder m_order;
+
+    // If true, the notes are ordered by size and m_order is ignored
+    bool        m_orderBySize;
+};
+
+/**
+ * @brief The NoteIndexAsync class maintains an in-memory index of all notes
+ * containing the data required for filtering and ordering them and serves
+ * the note listings which the local storage cannot handle efficiently, like
+ * listing notes ordered by size
+ *
+ * Just like NoteSummaryListerAsync, the object is meant to live in the same
+ * thread as LocalStorageManagerAsync and uses the LocalStorageManager owned
+ * by the latter directly.
+ *
+ * The index is not persisted: it is built on the first request which needs it,
+ * batch by batch so that other local storage requests are not blocked while
+ * it is being built, then it is kept up to date on each note addition, update
+ * or expunge made through LocalStorageManagerAsync and released once no
+ * request has used it for a while. The preview texts of notes without title,
+ * by which such notes are ordered by title, are computed only when the index
+ * is queried in the title order.
+ *
+ * A single index can be shared by several models listing notes from the same
+ * local storage so that it is built only once for all of them; the results
+ * of the last few queries are kept so that the models paging through different
+ * queries don't invalidate each other's results. Note that the models still
+ * list their own pages of notes through their own requests.
+ *
+ * For listing the notes with the given local uids in pages the whole list
+ * of local uids is ordered once and kept until any of the notes from the list
+ * is updated or expunged or until the list is pushed out by the lists
+ * of the more recent requests.
+ */
+class NoteIndexAsync: public QObject
+{
+    Q_OBJECT
+public:
+    explicit NoteIndexAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        QObject * parent = nullptr);
+
+    virtual ~NoteIndexAsync();
+
+    bool isBuilt() const { return m_noteIndexBuilt; }
+
+    /**
+     * @brief countNotes - counts notes per notebooks and tags using the index
+     *
+     * @param options               Options telling which notes to count
+     * @param noteCountsPerNotebookLocalUid     Counts of notes per notebooks
+     *                                          present in the hash are
+     *                                          increased
+     * @param noteCountsPerTagLocalUid          Counts of notes per tags present
+     *                                          in the hash are increased
+     * @param addMissingNotebooks   If true, the notebooks missing from
+     *                              the hash of note counts per notebook are
+     *                              added to it; notebooks without notes are
+     *                              not added then
+     * @return                      False if the index is not built, true
+     *                              otherwise
+     */
+    bool countNotes(
+        const LocalStorageManager::NoteCountOptions options,
+        QHash<QString, int> & noteCountsPerNotebookLocalUid,
+        QHash<QString, int> & noteCountsPerTagLocalUid,
+        const bool addMissingNotebooks) const;
+
+Q_SIGNALS:
+    void listNoteSummariesComplete(
+        QList<NoteModelItem> summaries, QUuid requestId);
+
+    void listNoteSummariesFailed(ErrorString errorDescription, QUuid requestId);
+
+public Q_SLOTS:
+    /**
+     * @brief onListOrderedNoteSummariesByLocalUidsRequest - lists a page of
+     * notes with the given local uids in the given order
+     *
+     * @param noteLocalUids         Local uids of all notes to be paged
+     *                              through; the same list should be passed
+     *                              for each page
+     * @param orderBySize           If true, the notes are ordered by size
+     *                              and order is ignored
+     */
+    void onListOrderedNoteSummariesByLocalUidsRequest(
+        QStringList noteLocalUids,
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListNotesOrder order, bool orderBySize,
+        LocalStorageManager::OrderDirection orderDirection,
+        QUuid requestId);
+
+    /**
+     * @brief onListIndexedNoteSummariesRequest - lists a page of notes
+     * matching the query using the note index
+     */
+    void onListIndexedNoteSummariesRequest(
+        NoteIndexQuery query,
+        LocalStorageManager::OrderDirection orderDirection,
+        size_t limit, size_t offset, QUuid requestId);
+
+private Q_SLOTS:
+    // Slots keeping the note index up to date
+    void onAddNoteComplete(Note note, QUuid requestId);
+
+    void onUpdateNoteComplete(
+        Note note, LocalStorageManager::UpdateNoteOptions options,
+        QUuid requestId);
+
+    void onExpungeNoteComplete(Note note, QUuid requestId);
+    void onExpungeNotebookComplete(Notebook notebook, QUuid requestId);
+
+    void onExpungeTagComplete(
+        Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId);
+
+    void buildNoteIndexBatch();
+
+private:
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
+    LocalStorageManager * localStorageManager(ErrorString & errorDescription);
+
+    struct NoteIndexEntry
+    {
+        NoteIndexEntry() :
+            m_localUid(),
+            m_notebookLocalUid(),
+            m_tagLocalUids(),
+            m_titleOrPreviewText(),
+            m_creationTimestamp(0),
+            m_modificationTimestamp(0),
+            m_sizeInBytes(0),
+            m_deleted(false),
+            m_needsPreviewText(false)
+        {}
+
+        QString     m_localUid;
+        QString     m_notebookLocalUid;
+        QStringList m_tagLocalUids;
+        QString     m_titleOrPreviewText;
+        qint64      m_creationTimestamp;
+        qint64      m_modificationTimestamp;
+        quint64     m_sizeInBytes;
+        bool        m_deleted;
+
+        // True if the note has no title and its preview text, by which it is
+        // ordered by title, has not been computed yet
+        bool        m_needsPreviewText;
+    };
+
+    struct NoteIndexQueryResult
+    {
+        NoteIndexQueryResult() :
+            m_query(),
+            m_noteLocalUids()
+        {}
+
+        NoteIndexQuery  m_query;
+
+        // Local uids of notes matching the query in ascending order
+        QStringList     m_noteLocalUids;
+    };
+
+    struct OrderedNoteLocalUids
+    {
+        OrderedNoteLocalUids() :
+            m_sourceNoteLocalUids(),
+            m_order(LocalStorageManager::ListNotesOrder::NoOrder),
+            m_orderBySize(false),
+            m_noteLocalUids(),
+            m_noteLocalUidsSet()
+        {}
+
+        QStringList     m_sourceNoteLocalUids;
+        LocalStorageManager::ListNotesOrder m_order;
+        bool            m_orderBySize;
+
+        // The source local uids of existing notes in ascending order
+        QStringList     m_noteLocalUids;
+        QSet<QString>   m_noteLocalUidsSet;
+    };
+
+    struct IndexedNoteSummariesRequest
+    {
+        IndexedNoteSummariesRequest() :
+            m_query(),
+            m_orderDirection(LocalStorageManager::OrderDirection::Ascending),
+            m_limit(0),
+            m_offset(0),
+            m_requestId()
+        {}
+
+        NoteIndexQuery  m_query;
+        LocalStorageManager::OrderDirection m_orderDirection;
+        size_t          m_limit;
+        size_t          m_offset;
+        QUuid           m_requestId;
+    };
+
+    class NoteIndexEntryLess
+    {
+    public:
+        NoteIndexEntryLess(
+                const bool orderBySize,
+                const LocalStorageManager::ListNotesOrder order) :
+            m_orderBySize(orderBySize),
+            m_order(order)
+        {}
+
+        bool operator()(
+            const NoteIndexEntry & lhs, const NoteIndexEntry & rhs) const;
+
+    private:
+        bool                                m_orderBySize;
+        LocalStorageManager::ListNotesOrder m_order;
+    };
+
+    static void noteToIndexEntry(
+        const Note & note, NoteIndexEntry & entry,
+        const bool withPreviewText);
+
+    static QStringList pageNoteLocalUids(
+        const QStringList & orderedNoteLocalUids,
+        const LocalStorageManager::OrderDirection orderDirection,
+        const size_t limit, const size_t offset);
+
+    void startNoteIndexBuilding();
+    void finishNoteIndexBuilding(const ErrorString & errorDescription);
+
+    void addOrUpdateNoteIndexEntry(const Note & note);
+    void removeNoteIndexEntry(const QString & noteLocalUid);
+
+    void listIndexedNoteSummaries(
+        LocalStorageManager & localStorageManager,
+        const IndexedNoteSummariesRequest & request);
+
+    const QStringList * findNoteIndexQueryResult(const NoteIndexQuery & query);
+
+    bool runNoteIndexQuery(
+        LocalStorageManager & localStorageManager,
+        const NoteIndexQuery & query, ErrorString & errorDescription);
+
+    bool computeNoteIndexPreviewTexts(
+        LocalStorageManager & localStorageManager,
+        QVector<NoteIndexEntry> & entries, ErrorString & errorDescription);
+
+    const QStringList * findOrderedNoteLocalUids(
+        const QStringList & noteLocalUids,
+        const LocalStorageManager::ListNotesOrder order,
+        const bool orderBySize);
+
+    bool buildOrderedNoteLocalUids(
+        LocalStorageManager & localStorageManager,
+        const QStringList & noteLocalUids,
+        const LocalStorageManager::ListNotesOrder order,
+        const bool orderBySize, ErrorString & errorDescription);
+
+    void invalidateOrderedNoteLocalUids(const QString & noteLocalUid);
+
+    void listNoteSummariesPage(
+        LocalStorageManager & localStorageManager,
+        const QStringList & pageNoteLocalUids,
+        const LocalStorageManager::ListObjectsOptions flag,
+        const QUuid & requestId);
+
+private:
+    Q_DISABLE_COPY(NoteIndexAsync)
+
+private:
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+
+    QHash<QString, NoteIndexEntry>  m_noteIndex;
+    bool                        m_noteIndexBuilt;
+    bool                        m_noteIndexBuilding;
+
+    // Offset of the next batch of notes to be listed while building the index
+    size_t                      m_noteIndexBuildOffset;
+
+    // Requests to list indexed notes received while the index is being built
+    QList<IndexedNoteSummariesRequest>  m_pendingIndexedNoteSummariesRequests;
+
+    QBasicTimer                 m_noteIndexExpirationTimer;
+
+    // Results of the most recent queries to the note index, the most
+    // recently used first
+    QList<NoteIndexQueryResult> m_noteIndexQueryResults;
+
+    // Ordered local uids for the most recent requests to list notes
+    // by local uids, the most recently used first
+    QList<OrderedNoteLocalUids> m_orderedNoteLocalUids;
+};
+
+} // namespace quentier
+
+Q_DECLARE_METATYPE(quentier::NoteIndexQuery)
+
+#endif // QUENTIER_LIB_MODEL_NOTE_INDEX_ASYNC_H
@@ -21,7 +21,14 @@
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/Utility.h>
 
+#include <QThreadPool>
+#include <QTimer>
+#include <QTimerEvent>
+#include <QVector>
+
+#include <algorithm>
 #include <iterator>
+#include <vector>
 
 // Separate logging macros for the note model - to distinguish the one
 // for deleted notes from the one for non-deleted notes
@@ -64,14 +71,48 @@ inline QString includedNotesStr(
     QNFATAL(includedNotesStr(m_includedNotes) << message)                      \
 // NMFATAL
 
-// Limit for the queries to the local storage
+// Minimal limit for the queries to the local storage
 #define NOTE_LIST_QUERY_LIMIT (10)
 
+// Maximal limit for the queries to the local storage: the batch of notes
+// loaded on fetchMore grows with viewport size and scrolling speed but never
+// beyond this value
+#define NOTE_LIST_QUERY_MAX_LIMIT (200)
+
+// If fetchMore is called again within this number of milliseconds, the view
+// is considered to be scrolled fast and the model prefetches more rows
+#define NOTE_FETCH_MORE_FAST_SCROLL_THRESHOLD_MSEC (500)
+
+// Number of screens worth of rows loaded ahead on fetchMore for slow and fast
+// scrolling respectively
+#define NOTE_FETCH_MORE_SCREENS_AHEAD (1)
+#define NOTE_FETCH_MORE_FAST_SCROLL_SCREENS_AHEAD (2)
+
+// In the sliding window mode full note items are kept for this number of
+// screens worth of rows before and after the visible rows but for no less
+// than NOTE_WINDOW_MIN_MARGIN rows
+#define NOTE_WINDOW_MARGIN_SCREENS (3)
+#define NOTE_WINDOW_MIN_MARGIN (50)
+
+// In the sliding window mode the loaded rows below the window are removed
+// when the number of evicted items exceeds this limit
+#define NOTE_MAX_EVICTED_ITEMS (5000)
+
+// Max number of notes which preview texts are extracted by a single thread
+// pool task
+#define NOTE_PREVIEW_TEXT_EXTRACTION_BATCH_SIZE (20)
+
 // Minimum number of notes which the model attempts to load from the local
 // storage
 #define NOTE_MIN_CACHE_SIZE (30)
 
-#define NOTE_PREVIEW_TEXT_SIZE (500)
+// The note counts are requested from the local storage for reconciliation
+// no more often than once per this number of milliseconds
+#define NOTE_COUNT_RECONCILIATION_INTERVAL_MSEC (1000)
+
+// The signals notifying about the note counts changes are emitted no more
+// often than once per this number of milliseconds
+#define NOTE_COUNT_NOTIFICATION_INTERVAL_MSEC (250)
 
 #define NUM_NOTE_MODEL_COLUMNS (12)
 
@@ -90,26 +131,50 @@ NoteModel::NoteModel(
         QObject * parent,
         const IncludedNotes::type includedNotes,
         const NoteSortingMode::type noteSortingMode,
-        NoteFilters * pFilters) :
+        NoteFilters * pFilters,
+        NoteIndexAsync * pNoteIndex) :
     QAbstractItemModel(parent),
     m_account(account),
     m_includedNotes(includedNotes),
     m_noteSortingMode(noteSortingMode),
     m_localStorageManagerAsync(localStorageManagerAsync),
     m_connectedToLocalStorage(false),
+    m_pNoteSummaryLister(new NoteSummaryListerAsync(localStorageManagerAsync)),
+    m_pNoteIndex(pNoteIndex),
+    m_ownsNoteIndex(!pNoteIndex),
     m_isStarted(false),
     m_data(),
     m_totalFilteredNotesCount(0),
     m_cache(noteCache),
     m_notebookCache(notebookCache),
+    m_instrumentation(QStringLiteral("NoteModel")),
     m_pFilters(pFilters),
     m_pUpdatedNoteFilters(nullptr),
     m_maxNoteCount(NOTE_MIN_CACHE_SIZE * 2),
+    m_viewportRowCount(NOTE_LIST_QUERY_LIMIT),
+    m_fetchMoreTimer(),
+    m_pendingFetchMore(false),
+    m_windowedMode(false),
+    m_firstVisibleRow(0),
+    m_lastVisibleRow(-1),
+    m_hydratedNoteLocalUids(),
+    m_noteLocalUidsPendingRehydration(),
+    m_noteLocalUidsByRehydrateRequestId(),
+    m_notesPendingPreviewTextExtraction(),
+    m_previewTextSequenceNumberByNoteLocalUid(),
+    m_lastPreviewTextSequenceNumber(0),
     m_listNotesOffset(0),
     m_listNotesRequestId(),
+    m_reconcileSortingRequestId(),
+    m_reconcileSortingLimit(0),
     m_getNoteCountRequestId(),
     m_totalAccountNotesCount(0),
     m_getFullNoteCountPerAccountRequestId(),
+    m_noteCountsReconciliationTimer(),
+    m_noteCountsNotificationTimer(),
+    m_pendingNoteCountsNotification(false),
+    m_lastNotifiedAccountNotesCount(-1),
+    m_lastNotifiedFilteredNotesCount(-1),
     m_notebookDataByNotebookLocalUid(),
     m_findNotebookRequestForNotebookLocalUid(),
     m_localUidsOfNewNotesBeingAddedToLocalStorage(),
@@ -120,13 +185,32 @@ NoteModel::NoteModel(
     m_findNoteToPerformUpdateRequestIds(),
     m_noteItemsPendingNotebookDataUpdate(),
     m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap(),
+    m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook(),
+    m_deletedNoteItemsPendingUpdate(),
     m_tagDataByTagLocalUid(),
     m_findTagRequestForTagLocalUid(),
-    m_tagLocalUidToNoteLocalUid()
-{}
+    m_noteLocalUidsByTagLocalUid(),
+    m_internedStrings()
+{
+    m_pNoteSummaryLister->moveToThread(localStorageManagerAsync.thread());
+
+    if (m_ownsNoteIndex) {
+        m_pNoteIndex = new NoteIndexAsync(localStorageManagerAsync);
+        m_pNoteIndex->moveToThread(localStorageManagerAsync.thread());
+    }
+}
 
 NoteModel::~NoteModel()
-{}
+{
+    m_pNoteSummaryLister->disconnect(this);
+    m_pNoteSummaryLister->deleteLater();
+
+    m_pNoteIndex->disconnect(this);
+
+    if (m_ownsNoteIndex) {
+        m_pNoteIndex->deleteLater();
+    }
+}
 
 void NoteModel::updateAccount(const Account & account)
 {
@@ -410,6 +494,68 @@ qint32 NoteModel::totalAccountNotesCount() const
     return m_totalAccountNotesCount;
 }
 
+void NoteModel::setViewportRowCount(const int rowCount)
+{
+    if (rowCount == m_viewportRowCount) {
+        return;
+    }
+
+    NMTRACE("NoteModel::setViewportRowCount: " << rowCount);
+    m_viewportRowCount = std::max(rowCount, 1);
+}
+
+void NoteModel::setWindowedMode(const bool windowed)
+{
+    NMDEBUG("NoteModel::setWindowedMode: "
+            << (windowed ? "true" : "false"));
+
+    if (m_windowedMode == windowed) {
+        return;
+    }
+
+    m_windowedMode = windowed;
+
+    if (!m_windowedMode) {
+        rehydrateEvictedItems(0, static_cast<int>(m_data.size()) - 1);
+        m_hydratedNoteLocalUids.clear();
+        return;
+    }
+
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
+    for(auto it = index.begin(), end = index.end(); it != end; ++it)
+    {
+        if (!it->isEvicted()) {
+            Q_UNUSED(m_hydratedNoteLocalUids.insert(it->localUid()))
+        }
+    }
+
+    if (m_lastVisibleRow >= 0) {
+        evictItemsOutsideOfWindow();
+    }
+}
+
+void NoteModel::setVisibleRowRange(const int firstRow, const int lastRow)
+{
+    if (!m_windowedMode) {
+        return;
+    }
+
+    if ((firstRow == m_firstVisibleRow) && (lastRow == m_lastVisibleRow)) {
+        return;
+    }
+
+    NMTRACE("NoteModel::setVisibleRowRange: first row = " << firstRow
+            << ", last row = " << lastRow);
+
+    m_firstVisibleRow = firstRow;
+    m_lastVisibleRow = lastRow;
+
+    evictItemsOutsideOfWindow();
+
+    int margin = windowMargin();
+    rehydrateEvictedItems(m_firstVisibleRow - margin, m_lastVisibleRow + margin);
+}
+
 QModelIndex NoteModel::createNoteItem(
     const QString & notebookLocalUid, ErrorString & errorDescription)
 {
@@ -467,11 +613,11 @@ QModelIndex NoteModel::createNoteItem(
     item.setLocalUid(UidGenerator::Generate());
     item.setNotebookLocalUid(notebookLocalUid);
     item.setNotebookGuid(notebookData.m_guid);
-    item.setNotebookName(notebookData.m_name);
     item.setCreationTimestamp(QDateTime::currentMSecsSinceEpoch());
     item.setModificationTimestamp(item.creationTimestamp());
     item.setDirty(true);
     item.setSynchronizable(m_account.type() != Account::Type::Local);
+    internItemStrings(item);
 
     int row = rowForNewItem(item);
     beginInsertRows(QModelIndex(), row, row);
@@ -538,10 +684,14 @@ bool NoteModel::moveNoteToNotebook(
     {
         const Notebook & notebook = nit->second;
         if (notebook.hasName() && (notebook.name() == notebookName)) {
+            m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"),
+                                                 true);
             return moveNoteToNotebookImpl(it, notebook, errorDescription);
         }
     }
 
+    m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"), false);
+
     /**
      * 2) No such notebook in the cache; attempt to find it within the local
      * storage asynchronously then
@@ -559,6 +709,8 @@ bool NoteModel::moveNoteToNotebook(
             << "moving the note to it: request id = "
             << requestId << ", notebook name = " << notebookName
             << ", note local uid = " << noteLocalUid);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNotebook"), requestId);
     Q_EMIT findNotebook(dummy, requestId);
 
     return true;
@@ -578,6 +730,160 @@ bool NoteModel::unfavoriteNote(
     return setNoteFavorited(noteLocalUid, false, errorDescription);
 }
 
+bool NoteModel::deleteNotes(
+    const QStringList & noteLocalUids, ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::deleteNotes: "
+            << noteLocalUids.join(QStringLiteral(", ")));
+
+    QList<NoteModelItem> items;
+    if (!findNoteItemsToUpdate(noteLocalUids, items, errorDescription)) {
+        return false;
+    }
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    for(auto it = items.begin(), end = items.end(); it != end; ++it)
+    {
+        NoteModelItem & item = *it;
+        item.setDeletionTimestamp(timestamp);
+        item.setActive(false);
+        item.setDirty(true);
+
+        // Just like in setDataImpl the modification timestamp is not touched
+        // when the note is moved to trash from the model of non-deleted notes
+        if (m_includedNotes != IncludedNotes::NonDeleted) {
+            item.setModificationTimestamp(timestamp);
+        }
+    }
+
+    if (m_includedNotes == IncludedNotes::NonDeleted)
+    {
+        // The deleted notes no longer belong to the model so their rows are
+        // removed right away rather than one by one on the completion of
+        // each note update within the local storage
+        QSet<QString> localUids;
+        localUids.reserve(items.size());
+        for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it) {
+            Q_UNUSED(localUids.insert(it->localUid()))
+            m_deletedNoteItemsPendingUpdate[it->localUid()] = *it;
+        }
+
+        removeItemsByLocalUids(localUids);
+
+        if ((m_getFullNoteCountPerAccountRequestId == QUuid()) &&
+            (m_getNoteCountRequestId == QUuid()))
+        {
+            m_totalAccountNotesCount =
+                std::max(m_totalAccountNotesCount - items.size(), 0);
+            m_totalFilteredNotesCount =
+                std::max(m_totalFilteredNotesCount - items.size(), 0);
+            notifyNoteCountsUpdated();
+        }
+        else {
+            scheduleNoteCountsReconciliation();
+        }
+    }
+    else
+    {
+        replaceNoteItems(items, Columns::ModificationTimestamp, Columns::Dirty);
+    }
+
+    for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it) {
+        saveNoteInLocalStorage(*it);
+    }
+
+    return true;
+}
+
+bool NoteModel::moveNotesToNotebook(
+    const QStringList & noteLocalUids, const QString & notebookName,
+    ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::moveNotesToNotebook: note local uids: "
+            << noteLocalUids.join(QStringLiteral(", "))
+            << "; notebook name = " << notebookName);
+
+    if (Q_UNLIKELY(notebookName.isEmpty())) {
+        errorDescription.setBase(QT_TR_NOOP("the name of the target notebook "
+                                            "is empty"));
+        return false;
+    }
+
+    QList<NoteModelItem> items;
+    if (!findNoteItemsToUpdate(noteLocalUids, items, errorDescription)) {
+        return false;
+    }
+
+    for(auto nit = m_notebookCache.begin(),
+        end = m_notebookCache.end(); nit != end; ++nit)
+    {
+        const Notebook & notebook = nit->second;
+        if (notebook.hasName() && (notebook.name() == notebookName)) {
+            m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"),
+                                                 true);
+            return moveNotesToNotebookImpl(noteLocalUids, notebook,
+                                           errorDescription);
+        }
+    }
+
+    m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"), false);
+
+    Notebook dummy;
+    dummy.setName(notebookName);
+
+    // Set empty local uid as a hint for local storage to search the notebook
+    // by name
+    dummy.setLocalUid(QString());
+    QUuid requestId = QUuid::createUuid();
+    m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook[requestId] =
+        noteLocalUids;
+    NMTRACE("Emitting the request to find a notebook by name for "
+            << "moving the notes to it: request id = "
+            << requestId << ", notebook name = " << notebookName);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNotebook"), requestId);
+    Q_EMIT findNotebook(dummy, requestId);
+
+    return true;
+}
+
+bool NoteModel::favoriteNotes(
+    const QStringList & noteLocalUids, ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::favoriteNotes: "
+            << noteLocalUids.join(QStringLiteral(", ")));
+    return setNotesFavorited(noteLocalUids, true, errorDescription);
+}
+
+bool NoteModel::unfavoriteNotes(
+    const QStringList & noteLocalUids, ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::unfavoriteNotes: "
+            << noteLocalUids.join(QStringLiteral(", ")));
+    return setNotesFavorited(noteLocalUids, false, errorDescription);
+}
+
+bool NoteModel::tagNotes(
+    const QStringList & noteLocalUids, const QString & tagLocalUid,
+    ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::tagNotes: note local uids: "
+            << noteLocalUids.join(QStringLiteral(", "))
+            << "; tag local uid = " << tagLocalUid);
+    return setNotesTagged(noteLocalUids, tagLocalUid, true, errorDescription);
+}
+
+bool NoteModel::untagNotes(
+    const QStringList & noteLocalUids, const QString & tagLocalUid,
+    ErrorString & errorDescription)
+{
+    NMDEBUG("NoteModel::untagNotes: note local uids: "
+            << noteLocalUids.join(QStringLiteral(", "))
+            << "; tag local uid = " << tagLocalUid);
+    return setNotesTagged(noteLocalUids, tagLocalUid, false, errorDescription);
+}
+
 Qt::ItemFlags NoteModel::flags(const QModelIndex & modelIndex) const
 {
     Qt::ItemFlags indexFlags = QAbstractItemModel::flags(modelIndex);
@@ -828,6 +1134,9 @@ void NoteModel::sort(int column, Qt::SortOrder order)
         return;
     }
 
+    NoteSortingMode::type previousNoteSortingMode = m_noteSortingMode;
+    Columns::type previousSortingColumn = sortingColumn();
+
     if (column == sortingColumn())
     {
         if (order == sortOrder()) {
@@ -845,9 +1154,20 @@ void NoteModel::sort(int column, Qt::SortOrder order)
         setSortingColumnAndOrder(column, order);
     }
 
-    if (m_isStarted) {
-        resetModel();
+    if (m_noteSortingMode == previousNoteSortingMode) {
+        NMDEBUG("The note sorting mode has not changed, nothing to do");
+        return;
+    }
+
+    if (!m_isStarted) {
+        return;
     }
+
+    // NOTE: instead of resetting the model the already loaded items are
+    // reordered in place and then reconciled with the notes listed from
+    // the local storage in the new order in the background
+    sortLoadedItems(sortingColumn() == previousSortingColumn);
+    reconcileLoadedItemsWithSorting();
 }
 
 bool NoteModel::canFetchMore(const QModelIndex & parent) const
@@ -874,7 +1194,9 @@ bool NoteModel::canFetchMore(const QModelIndex & parent) const
         return false;
     }
 
-    if (m_listNotesRequestId != QUuid()) {
+    if ((m_listNotesRequestId != QUuid()) ||
+        (m_reconcileSortingRequestId != QUuid()))
+    {
         NMDEBUG("Still pending list notes request");
         return false;
     }
@@ -891,7 +1213,22 @@ void NoteModel::fetchMore(const QModelIndex & parent)
         return;
     }
 
-    m_maxNoteCount += NOTE_LIST_QUERY_LIMIT;
+    // NOTE: the new upper bound is computed relative to the number of already
+    // loaded notes so that repeated fetchMore calls arriving while the list
+    // notes request is still in flight don't make the bound grow without
+    // limit
+    size_t batchSize = fetchMoreBatchSize();
+    m_maxNoteCount = std::max(m_maxNoteCount, m_data.size() + batchSize);
+
+    if ((m_listNotesRequestId != QUuid()) ||
+        (m_reconcileSortingRequestId != QUuid()))
+    {
+        NMDEBUG("List notes request is still pending, will request more notes "
+                << "after its completion");
+        m_pendingFetchMore = true;
+        return;
+    }
+
     requestNotesList();
 }
 
@@ -930,6 +1267,8 @@ void NoteModel::stop(const StopMode::type stopMode)
 
 void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMDEBUG("NoteModel::onAddNoteComplete: " << note
             << "\nRequest id = " << requestId);
 
@@ -941,21 +1280,32 @@ void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
         noteIncluded |= (m_includedNotes != IncludedNotes::Deleted);
     }
 
-    if (noteIncluded && (m_getFullNoteCountPerAccountRequestId == QUuid())) {
-        ++m_totalAccountNotesCount;
-        NMTRACE("Note count per account increased to "
-                << m_totalAccountNotesCount);
-        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
-    }
-
-    if (noteIncluded &&
-        (m_getNoteCountRequestId == QUuid()) &&
-        noteConformsToFilter(note))
+    if (noteIncluded)
     {
-        ++m_totalFilteredNotesCount;
-        NMTRACE("Filtered notes count increased to "
-                << m_totalFilteredNotesCount);
-        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+        // NOTE: if the count request is pending, its result might or might not
+        // include the added note so the count would be reconciled later
+        if (m_getFullNoteCountPerAccountRequestId == QUuid()) {
+            ++m_totalAccountNotesCount;
+            NMTRACE("Note count per account increased to "
+                    << m_totalAccountNotesCount);
+        }
+        else {
+            scheduleNoteCountsReconciliation();
+        }
+
+        if (noteConformsToFilter(note))
+        {
+            if (m_getNoteCountRequestId == QUuid()) {
+                ++m_totalFilteredNotesCount;
+                NMTRACE("Filtered notes count increased to "
+                        << m_totalFilteredNotesCount);
+            }
+            else {
+                scheduleNoteCountsReconciliation();
+            }
+        }
+
+        notifyNoteCountsUpdated();
     }
 
     auto it = m_addNoteRequestIds.find(requestId);
@@ -970,6 +1320,8 @@ void NoteModel::onAddNoteComplete(Note note, QUuid requestId)
 void NoteModel::onAddNoteFailed(
     Note note, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_addNoteRequestIds.find(requestId);
     if (it == m_addNoteRequestIds.end()) {
         return;
@@ -988,6 +1340,8 @@ void NoteModel::onAddNoteFailed(
 void NoteModel::onUpdateNoteComplete(
     Note note, LocalStorageManager::UpdateNoteOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMDEBUG("NoteModel::onUpdateNoteComplete: note = " << note
             << "\nRequest id = " << requestId);
 
@@ -999,6 +1353,29 @@ void NoteModel::onUpdateNoteComplete(
         (!note.hasDeletionTimestamp() &&
          (m_includedNotes == IncludedNotes::Deleted));
 
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    bool noteLoaded = (localUidIndex.find(note.localUid()) != localUidIndex.end());
+
+    if (shouldRemoveNoteFromModel && noteLoaded &&
+        (m_getFullNoteCountPerAccountRequestId == QUuid()) &&
+        (m_getNoteCountRequestId == QUuid()))
+    {
+        // The loaded note was counted in both counts and is no longer
+        // included into the model
+        m_totalAccountNotesCount = std::max(m_totalAccountNotesCount - 1, 0);
+        m_totalFilteredNotesCount = std::max(m_totalFilteredNotesCount - 1, 0);
+        NMTRACE("Note count per account decreased to "
+                << m_totalAccountNotesCount << ", filtered notes count "
+                << "decreased to " << m_totalFilteredNotesCount);
+        notifyNoteCountsUpdated();
+    }
+    else if (!noteLoaded || shouldRemoveNoteFromModel || hasFilters())
+    {
+        // The model doesn't know whether the note was counted before
+        // the update or whether it still conforms to the filter after it
+        scheduleNoteCountsReconciliation();
+    }
+
     if (shouldRemoveNoteFromModel) {
         removeItemByLocalUid(note.localUid());
     }
@@ -1009,14 +1386,31 @@ void NoteModel::onUpdateNoteComplete(
         NMDEBUG("This update was initiated by the note model");
         Q_UNUSED(m_updateNoteRequestIds.erase(it))
 
-        const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
         auto itemIt = localUidIndex.find(note.localUid());
+        auto deletedItemIt = m_deletedNoteItemsPendingUpdate.find(note.localUid());
+        // NOTE: the evicted item doesn't keep the tags, the note saved
+        // for it already carries the ones from the local storage
         if (itemIt != localUidIndex.end()) {
             const NoteModelItem & item = *itemIt;
+            if (!item.isEvicted()) {
+                note.setTagLocalUids(item.tagLocalUids());
+                note.setTagGuids(item.tagGuids());
+                NMTRACE("Complemented the note with tag local uids and "
+                        << "guids: " << note);
+            }
+        }
+        else if ((deletedItemIt != m_deletedNoteItemsPendingUpdate.end()) &&
+                 !deletedItemIt.value().isEvicted())
+        {
+            const NoteModelItem & item = deletedItemIt.value();
             note.setTagLocalUids(item.tagLocalUids());
             note.setTagGuids(item.tagGuids());
-            NMTRACE("Complemented the note with tag local uids and guids: "
-                    << note);
+            NMTRACE("Complemented the deleted note with tag local uids and "
+                    << "guids: " << note);
+        }
+
+        if (deletedItemIt != m_deletedNoteItemsPendingUpdate.end()) {
+            Q_UNUSED(m_deletedNoteItemsPendingUpdate.erase(deletedItemIt))
         }
 
         m_cache.put(note.localUid(), note);
@@ -1036,17 +1430,22 @@ void NoteModel::onUpdateNoteComplete(
 
     if (!shouldRemoveNoteFromModel)
     {
-        if (!(options & LocalStorageManager::UpdateNoteOption::UpdateTags))
+        auto noteItemIt = localUidIndex.find(note.localUid());
+        bool evicted =
+            ((noteItemIt != localUidIndex.end()) && noteItemIt->isEvicted());
+        if (evicted) {
+            // The cached note is saved in place of the data the evicted item
+            // doesn't keep so its stale copy must not remain in the cache
+            Q_UNUSED(m_cache.remove(note.localUid()))
+        }
+        else if ((noteItemIt != localUidIndex.end()) &&
+                 !(options & LocalStorageManager::UpdateNoteOption::UpdateTags))
         {
-            const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-            auto noteItemIt = localUidIndex.find(note.localUid());
-            if (noteItemIt != localUidIndex.end()) {
-                const NoteModelItem & item = *noteItemIt;
-                note.setTagGuids(item.tagGuids());
-                note.setTagLocalUids(item.tagLocalUids());
-                NMTRACE("Complemented the note with tag local uids and guids: "
-                        << note);
-            }
+            const NoteModelItem & item = *noteItemIt;
+            note.setTagGuids(item.tagGuids());
+            note.setTagLocalUids(item.tagLocalUids());
+            NMTRACE("Complemented the note with tag local uids and guids: "
+                    << note);
         }
 
         onNoteAddedOrUpdated(note);
@@ -1057,6 +1456,8 @@ void NoteModel::onUpdateNoteFailed(
     Note note, LocalStorageManager::UpdateNoteOptions options,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_updateNoteRequestIds.find(requestId);
@@ -1069,6 +1470,7 @@ void NoteModel::onUpdateNoteFailed(
             << ", request id = " << requestId);
 
     Q_UNUSED(m_updateNoteRequestIds.erase(it))
+    Q_UNUSED(m_deletedNoteItemsPendingUpdate.remove(note.localUid()))
 
     findNoteToRestoreFailedUpdate(note);
 }
@@ -1076,6 +1478,8 @@ void NoteModel::onUpdateNoteFailed(
 void NoteModel::onFindNoteComplete(
     Note note, LocalStorageManager::GetNoteOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
@@ -1105,6 +1509,12 @@ void NoteModel::onFindNoteComplete(
         auto it = localUidIndex.find(note.localUid());
         if (it != localUidIndex.end()) {
             saveNoteInLocalStorage(*it);
+            return;
+        }
+
+        auto deletedItemIt = m_deletedNoteItemsPendingUpdate.constFind(note.localUid());
+        if (deletedItemIt != m_deletedNoteItemsPendingUpdate.constEnd()) {
+            saveNoteInLocalStorage(deletedItemIt.value());
         }
     }
 }
@@ -1113,6 +1523,8 @@ void NoteModel::onFindNoteFailed(
     Note note, LocalStorageManager::GetNoteOptions options,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto restoreUpdateIt = m_findNoteToRestoreFailedUpdateRequestIds.find(requestId);
@@ -1137,218 +1549,91 @@ void NoteModel::onFindNoteFailed(
     Q_EMIT notifyError(errorDescription);
 }
 
-void NoteModel::onListNotesComplete(
-    LocalStorageManager::ListObjectsOptions flag,
-    LocalStorageManager::GetNoteOptions options,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, QList<Note> foundNotes,
-    QUuid requestId)
+void NoteModel::onListNoteSummariesComplete(
+    QList<NoteModelItem> summaries, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
+    auto rehydrateIt = m_noteLocalUidsByRehydrateRequestId.find(requestId);
+    if (rehydrateIt != m_noteLocalUidsByRehydrateRequestId.end())
+    {
+        const QStringList & noteLocalUids = rehydrateIt.value();
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            Q_UNUSED(m_noteLocalUidsPendingRehydration.remove(*it))
+        }
+
+        Q_UNUSED(m_noteLocalUidsByRehydrateRequestId.erase(rehydrateIt))
+        onRehydrateNotesComplete(summaries);
+        return;
+    }
+
+    if (requestId == m_reconcileSortingRequestId) {
+        onReconcileSortingComplete(summaries);
+        return;
+    }
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
 
-    NMDEBUG("NoteModel::onListNotesComplete: flag = " << flag
-            << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit << ", offset = "
-            << offset << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = " << linkedNotebookGuid
-            << ", num found notes = " << foundNotes.size()
-            << ", request id = " << requestId);
+    NMDEBUG("NoteModel::onListNoteSummariesComplete: num found notes = "
+            << summaries.size() << ", request id = " << requestId);
 
-    onListNotesCompleteImpl(foundNotes);
+    onListNotesCompleteImpl(summaries);
 }
 
-void NoteModel::onListNotesFailed(
-    LocalStorageManager::ListObjectsOptions flag,
-    LocalStorageManager::GetNoteOptions options,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QString linkedNotebookGuid, ErrorString errorDescription,
-    QUuid requestId)
+void NoteModel::onListNoteSummariesFailed(
+    ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
+    auto rehydrateIt = m_noteLocalUidsByRehydrateRequestId.find(requestId);
+    if (rehydrateIt != m_noteLocalUidsByRehydrateRequestId.end())
+    {
+        NMWARNING("NoteModel::onListNoteSummariesFailed: failed to "
+                  << "rehydrate evicted notes: " << errorDescription
+                  << ", request id = " << requestId);
+
+        const QStringList & noteLocalUids = rehydrateIt.value();
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            Q_UNUSED(m_noteLocalUidsPendingRehydration.remove(*it))
+        }
+
+        Q_UNUSED(m_noteLocalUidsByRehydrateRequestId.erase(rehydrateIt))
+        Q_EMIT notifyError(errorDescription);
+        return;
+    }
+
+    if (requestId == m_reconcileSortingRequestId)
+    {
+        NMWARNING("NoteModel::onListNoteSummariesFailed: failed to list "
+                  << "notes in the new sorting order, resetting the model: "
+                  << errorDescription << ", request id = " << requestId);
+        Q_EMIT notifyError(errorDescription);
+        resetModel();
+        return;
+    }
+
     if (requestId != m_listNotesRequestId) {
         return;
     }
 
-    NMDEBUG("NoteModel::onListNotesFailed: flag = " << flag
-            << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", linked notebook guid = " << linkedNotebookGuid
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
+    NMDEBUG("NoteModel::onListNoteSummariesFailed: error description = "
+            << errorDescription << ", request id = " << requestId);
 
     m_listNotesRequestId = QUuid();
     Q_EMIT notifyError(errorDescription);
 }
 
-void NoteModel::onListNotesPerNotebooksAndTagsComplete(
-    QStringList notebookLocalUids,
-    QStringList tagLocalUids,
-    LocalStorageManager::GetNoteOptions options,
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QList<Note> foundNotes, QUuid requestId)
+void NoteModel::onGetNoteCountComplete(
+    int noteCount, LocalStorageManager::NoteCountOptions options, QUuid requestId)
 {
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
+    m_instrumentation.recordRequestCompleted(requestId);
 
-    NMDEBUG("NoteModel::onListNotesPerNotebooksAndTagsComplete: "
-            << "flag = " << flag << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit << ", offset = "
-            << offset << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", notebook local uids: "
-            << notebookLocalUids.join(QStringLiteral(", "))
-            << ", tag local uids: "
-            << tagLocalUids.join(QStringLiteral(", "))
-            << ", num found notes = " << foundNotes.size()
-            << ", request id = " << requestId);
-
-    onListNotesCompleteImpl(foundNotes);
-}
-
-void NoteModel::onListNotesPerNotebooksAndTagsFailed(
-    QStringList notebookLocalUids,
-    QStringList tagLocalUids,
-    LocalStorageManager::GetNoteOptions options,
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    ErrorString errorDescription, QUuid requestId)
-{
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
-
-    NMDEBUG("NoteModel::onListNotesPerNotebooksAndTagsFailed: "
-            << "flag = " << flag
-            << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", notebook local uids: "
-            << notebookLocalUids.join(QStringLiteral(", "))
-            << ", tag local uids: "
-            << tagLocalUids.join(QStringLiteral(", "))
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
-
-    m_listNotesRequestId = QUuid();
-    Q_EMIT notifyError(errorDescription);
-}
-
-void NoteModel::onListNotesByLocalUidsComplete(
-    QStringList noteLocalUids,
-    LocalStorageManager::GetNoteOptions options,
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    QList<Note> foundNotes, QUuid requestId)
-{
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
-
-    NMDEBUG("NoteModel::onListNotesByLocalUidsComplete: "
-            << "flag = " << flag << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit << ", offset = "
-            << offset << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", note local uids: "
-            << noteLocalUids.join(QStringLiteral(", "))
-            << ", num found notes = " << foundNotes.size()
-            << ", request id = " << requestId);
-
-    onListNotesCompleteImpl(foundNotes);
-}
-
-void NoteModel::onListNotesByLocalUidsFailed(
-    QStringList noteLocalUids,
-    LocalStorageManager::GetNoteOptions options,
-    LocalStorageManager::ListObjectsOptions flag,
-    size_t limit, size_t offset,
-    LocalStorageManager::ListNotesOrder order,
-    LocalStorageManager::OrderDirection orderDirection,
-    ErrorString errorDescription, QUuid requestId)
-{
-    if (requestId != m_listNotesRequestId) {
-        return;
-    }
-
-    NMDEBUG("NoteModel::onListNotesByLocalUidsFailed: "
-            << "flag = " << flag << ", with resource metadata = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceMetadata)
-                ? "true"
-                : "false")
-            << ", with resource binary data = "
-            << ((options & LocalStorageManager::GetNoteOption::WithResourceBinaryData)
-                ? "true"
-                : "false")
-            << ", limit = " << limit
-            << ", offset = " << offset
-            << ", order = " << order
-            << ", direction = " << orderDirection
-            << ", note local uids: "
-            << noteLocalUids.join(QStringLiteral(", "))
-            << ", error description = " << errorDescription
-            << ", request id = " << requestId);
-
-    m_listNotesRequestId = QUuid();
-    Q_EMIT notifyError(errorDescription);
-}
-
-void NoteModel::onGetNoteCountComplete(
-    int noteCount, LocalStorageManager::NoteCountOptions options, QUuid requestId)
-{
     Q_UNUSED(options)
 
     if (m_getFullNoteCountPerAccountRequestId == requestId)
@@ -1359,7 +1644,7 @@ void NoteModel::onGetNoteCountComplete(
         m_getFullNoteCountPerAccountRequestId = QUuid();
 
         m_totalAccountNotesCount = noteCount;
-        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
+        notifyNoteCountsUpdated();
 
         return;
     }
@@ -1372,7 +1657,7 @@ void NoteModel::onGetNoteCountComplete(
         m_getNoteCountRequestId = QUuid();
 
         m_totalFilteredNotesCount = noteCount;
-        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+        notifyNoteCountsUpdated();
 
         return;
     }
@@ -1382,6 +1667,8 @@ void NoteModel::onGetNoteCountFailed(
     ErrorString errorDescription, LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     if (m_getFullNoteCountPerAccountRequestId == requestId)
@@ -1392,7 +1679,7 @@ void NoteModel::onGetNoteCountFailed(
         m_getFullNoteCountPerAccountRequestId = QUuid();
 
         m_totalAccountNotesCount = 0;
-        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
+        notifyNoteCountsUpdated();
 
         Q_EMIT notifyError(errorDescription);
         return;
@@ -1406,7 +1693,7 @@ void NoteModel::onGetNoteCountFailed(
         m_getNoteCountRequestId = QUuid();
 
         m_totalFilteredNotesCount = 0;
-        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+        notifyNoteCountsUpdated();
 
         Q_EMIT notifyError(errorDescription);
         return;
@@ -1417,6 +1704,8 @@ void NoteModel::onGetNoteCountPerNotebooksAndTagsComplete(
     int noteCount, QStringList notebookLocalUids, QStringList tagLocalUids,
     LocalStorageManager::NoteCountOptions options, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     if (m_getNoteCountRequestId != requestId) {
@@ -1433,7 +1722,7 @@ void NoteModel::onGetNoteCountPerNotebooksAndTagsComplete(
     m_getNoteCountRequestId = QUuid();
 
     m_totalFilteredNotesCount = noteCount;
-    Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+    notifyNoteCountsUpdated();
 }
 
 void NoteModel::onGetNoteCountPerNotebooksAndTagsFailed(
@@ -1442,6 +1731,8 @@ void NoteModel::onGetNoteCountPerNotebooksAndTagsFailed(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     if (m_getNoteCountRequestId != requestId) {
@@ -1457,22 +1748,34 @@ void NoteModel::onGetNoteCountPerNotebooksAndTagsFailed(
     m_getNoteCountRequestId = QUuid();
 
     m_totalFilteredNotesCount = 0;
-    Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+    notifyNoteCountsUpdated();
 
     Q_EMIT notifyError(errorDescription);
 }
 
 void NoteModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onExpungeNoteComplete: note = " << note
             << "\nRequest id = " << requestId);
 
-    if (m_getFullNoteCountPerAccountRequestId == QUuid()) {
-        requestTotalNotesCountPerAccount();
-    }
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    bool noteLoaded = (localUidIndex.find(note.localUid()) != localUidIndex.end());
 
-    if (m_getNoteCountRequestId == QUuid()) {
-        requestTotalFilteredNotesCount();
+    if (noteLoaded && (m_getFullNoteCountPerAccountRequestId == QUuid()) &&
+        (m_getNoteCountRequestId == QUuid()))
+    {
+        // The loaded note was counted in both counts
+        m_totalAccountNotesCount = std::max(m_totalAccountNotesCount - 1, 0);
+        m_totalFilteredNotesCount = std::max(m_totalFilteredNotesCount - 1, 0);
+        NMTRACE("Note count per account decreased to "
+                << m_totalAccountNotesCount << ", filtered notes count "
+                << "decreased to " << m_totalFilteredNotesCount);
+        notifyNoteCountsUpdated();
+    }
+    else {
+        scheduleNoteCountsReconciliation();
     }
 
     auto it = m_expungeNoteRequestIds.find(requestId);
@@ -1487,6 +1790,8 @@ void NoteModel::onExpungeNoteComplete(Note note, QUuid requestId)
 void NoteModel::onExpungeNoteFailed(
     Note note, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_expungeNoteRequestIds.find(requestId);
     if (it == m_expungeNoteRequestIds.end()) {
         return;
@@ -1503,14 +1808,19 @@ void NoteModel::onExpungeNoteFailed(
 
 void NoteModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto fit = m_findNotebookRequestForNotebookLocalUid.right.find(requestId);
     auto mit =
         ((fit == m_findNotebookRequestForNotebookLocalUid.right.end())
-         ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()
-         : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId));
+         ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId)
+         : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end());
+    auto bit =
+        m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.find(requestId);
 
     if ( (fit == m_findNotebookRequestForNotebookLocalUid.right.end()) &&
-         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) )
+         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) &&
+         (bit == m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end()) )
     {
         return;
     }
@@ -1549,19 +1859,39 @@ void NoteModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
             Q_EMIT notifyError(errorDescription);
         }
     }
+    else if (bit != m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end())
+    {
+        QStringList noteLocalUids = bit.value();
+        Q_UNUSED(m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.erase(bit))
+
+        ErrorString error;
+        if (!moveNotesToNotebookImpl(noteLocalUids, notebook, error)) {
+            ErrorString errorDescription(QT_TR_NOOP("Can't move notes to another notebook"));
+            errorDescription.appendBase(error.base());
+            errorDescription.appendBase(error.additionalBases());
+            errorDescription.details() = error.details();
+            NMWARNING(errorDescription);
+            Q_EMIT notifyError(errorDescription);
+        }
+    }
 }
 
 void NoteModel::onFindNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto fit = m_findNotebookRequestForNotebookLocalUid.right.find(requestId);
     auto mit =
         ((fit == m_findNotebookRequestForNotebookLocalUid.right.end())
-         ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()
-         : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId));
+         ? m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.find(requestId)
+         : m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end());
+    auto bit =
+        m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.find(requestId);
 
     if ( (fit == m_findNotebookRequestForNotebookLocalUid.right.end()) &&
-         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) )
+         (mit == m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.right.end()) &&
+         (bit == m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end()) )
     {
         return;
     }
@@ -1586,10 +1916,24 @@ void NoteModel::onFindNotebookFailed(
         NMDEBUG(error);
         Q_EMIT notifyError(error);
     }
+    else if (bit != m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.end())
+    {
+        Q_UNUSED(m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.erase(bit))
+
+        ErrorString error(QT_TR_NOOP("Can't move notes to another notebook: "
+                                     "failed to find the target notebook"));
+        error.appendBase(errorDescription.base());
+        error.appendBase(errorDescription.additionalBases());
+        error.details() = errorDescription.details();
+        NMDEBUG(error);
+        Q_EMIT notifyError(error);
+    }
 }
 
 void NoteModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMDEBUG("NoteModel::onAddNotebookComplete: local uid = "
             << notebook.localUid());
     Q_UNUSED(requestId)
@@ -1599,6 +1943,8 @@ void NoteModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onUpdateNotebookComplete: local uid = "
             << notebook.localUid());
     Q_UNUSED(requestId)
@@ -1608,6 +1954,8 @@ void NoteModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onExpungeNotebookComplete: local uid = "
             << notebook.localUid());
 
@@ -1622,6 +1970,8 @@ void NoteModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 
 void NoteModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto it = m_findTagRequestForTagLocalUid.right.find(requestId);
     if (it == m_findTagRequestForTagLocalUid.right.end()) {
         return;
@@ -1637,6 +1987,8 @@ void NoteModel::onFindTagComplete(Tag tag, QUuid requestId)
 void NoteModel::onFindTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_findTagRequestForTagLocalUid.right.find(requestId);
     if (it == m_findTagRequestForTagLocalUid.right.end()) {
         return;
@@ -1652,6 +2004,8 @@ void NoteModel::onFindTagFailed(
 
 void NoteModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onAddTagComplete: tag = " << tag
             << ", request id = " << requestId);
     updateTagData(tag);
@@ -1659,6 +2013,8 @@ void NoteModel::onAddTagComplete(Tag tag, QUuid requestId)
 
 void NoteModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onUpdateTagComplete: tag = " << tag
             << ", request id = " << requestId);
     updateTagData(tag);
@@ -1667,6 +2023,8 @@ void NoteModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 void NoteModel::onExpungeTagComplete(
     Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     NMTRACE("NoteModel::onExpungeTagComplete: tag = " << tag
             << "\nExpunged child tag local uids = "
             << expungedChildTagLocalUids.join(QStringLiteral(", "))
@@ -1710,51 +2068,73 @@ void NoteModel::connectToLocalStorage()
                      QNSLOT(LocalStorageManagerAsync,onFindNoteRequest,
                             Note,LocalStorageManager::GetNoteOptions,QUuid));
     QObject::connect(this,
-                     QNSIGNAL(NoteModel,listNotes,
+                     QNSIGNAL(NoteModel,listNoteSummaries,
                               LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
+                              size_t,size_t,
                               LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QUuid),
-                     &m_localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,onListNotesRequest,
+                              LocalStorageManager::OrderDirection,QUuid),
+                     m_pNoteSummaryLister,
+                     QNSLOT(NoteSummaryListerAsync,onListNoteSummariesRequest,
                             LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,size_t,size_t,
+                            size_t,size_t,
                             LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QUuid));
+                            LocalStorageManager::OrderDirection,QUuid));
     QObject::connect(this,
-                     QNSIGNAL(NoteModel,listNotesPerNotebooksAndTags,
+                     QNSIGNAL(NoteModel,listNoteSummariesPerNotebooksAndTags,
                               QStringList,QStringList,
-                              LocalStorageManager::GetNoteOptions,
                               LocalStorageManager::ListObjectsOptions,
                               size_t,size_t,
                               LocalStorageManager::ListNotesOrder,
                               LocalStorageManager::OrderDirection,QUuid),
-                     &m_localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,
-                            onListNotesPerNotebooksAndTagsRequest,
+                     m_pNoteSummaryLister,
+                     QNSLOT(NoteSummaryListerAsync,
+                            onListNoteSummariesPerNotebooksAndTagsRequest,
                             QStringList,QStringList,
-                            LocalStorageManager::GetNoteOptions,
                             LocalStorageManager::ListObjectsOptions,
                             size_t,size_t,
                             LocalStorageManager::ListNotesOrder,
                             LocalStorageManager::OrderDirection,QUuid));
     QObject::connect(this,
-                     QNSIGNAL(NoteModel,listNotesByLocalUids,
-                              QStringList,LocalStorageManager::GetNoteOptions,
+                     QNSIGNAL(NoteModel,listNoteSummariesByLocalUids,
+                              QStringList,
                               LocalStorageManager::ListObjectsOptions,
                               size_t,size_t,
                               LocalStorageManager::ListNotesOrder,
                               LocalStorageManager::OrderDirection,QUuid),
-                     &m_localStorageManagerAsync,
-                     QNSLOT(LocalStorageManagerAsync,
-                            onListNotesByLocalUidsRequest,
-                            QStringList,LocalStorageManager::GetNoteOptions,
+                     m_pNoteSummaryLister,
+                     QNSLOT(NoteSummaryListerAsync,
+                            onListNoteSummariesByLocalUidsRequest,
+                            QStringList,
                             LocalStorageManager::ListObjectsOptions,
                             size_t,size_t,
                             LocalStorageManager::ListNotesOrder,
                             LocalStorageManager::OrderDirection,QUuid));
+    QObject::connect(this,
+                     QNSIGNAL(NoteModel,listOrderedNoteSummariesByLocalUids,
+                              QStringList,
+                              LocalStorageManager::ListObjectsOptions,
+                              size_t,size_t,
+                              LocalStorageManager::ListNotesOrder,bool,
+                              LocalStorageManager::OrderDirection,QUuid),
+                     m_pNoteIndex,
+                     QNSLOT(NoteIndexAsync,
+                            onListOrderedNoteSummariesByLocalUidsRequest,
+                            QStringList,
+                            LocalStorageManager::ListObjectsOptions,
+                            size_t,size_t,
+                            LocalStorageManager::ListNotesOrder,bool,
+                            LocalStorageManager::OrderDirection,QUuid));
+    QObject::connect(this,
+                     QNSIGNAL(NoteModel,listIndexedNoteSummaries,
+                              NoteIndexQuery,
+                              LocalStorageManager::OrderDirection,
+                              size_t,size_t,QUuid),
+                     m_pNoteIndex,
+                     QNSLOT(NoteIndexAsync,
+                            onListIndexedNoteSummariesRequest,
+                            NoteIndexQuery,
+                            LocalStorageManager::OrderDirection,
+                            size_t,size_t,QUuid));
     QObject::connect(this,
                      QNSIGNAL(NoteModel,getNoteCount,
                               LocalStorageManager::NoteCountOptions,QUuid),
@@ -1824,105 +2204,29 @@ void NoteModel::connectToLocalStorage()
                      QNSLOT(NoteModel,onFindNoteFailed,
                             Note,LocalStorageManager::GetNoteOptions,
                             ErrorString,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotesComplete,
-                              LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,QList<Note>,QUuid),
-                     this,
-                     QNSLOT(NoteModel,onListNotesComplete,
-                            LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,QList<Note>,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,listNotesFailed,
-                              LocalStorageManager::ListObjectsOptions,
-                              LocalStorageManager::GetNoteOptions,size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QString,ErrorString,QUuid),
-                     this,
-                     QNSLOT(NoteModel,onListNotesFailed,
-                            LocalStorageManager::ListObjectsOptions,
-                            LocalStorageManager::GetNoteOptions,size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QString,ErrorString,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,
-                              listNotesPerNotebooksAndTagsComplete,
-                              QStringList,QStringList,
-                              LocalStorageManager::GetNoteOptions,
-                              LocalStorageManager::ListObjectsOptions,
-                              size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QList<Note>,QUuid),
+    QObject::connect(m_pNoteSummaryLister,
+                     QNSIGNAL(NoteSummaryListerAsync,listNoteSummariesComplete,
+                              QList<NoteModelItem>,QUuid),
                      this,
-                     QNSLOT(NoteModel,onListNotesPerNotebooksAndTagsComplete,
-                            QStringList,QStringList,
-                            LocalStorageManager::GetNoteOptions,
-                            LocalStorageManager::ListObjectsOptions,
-                            size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QList<Note>,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,
-                              listNotesPerNotebooksAndTagsFailed,
-                              QStringList,QStringList,
-                              LocalStorageManager::GetNoteOptions,
-                              LocalStorageManager::ListObjectsOptions,
-                              size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
+                     QNSLOT(NoteModel,onListNoteSummariesComplete,
+                            QList<NoteModelItem>,QUuid));
+    QObject::connect(m_pNoteSummaryLister,
+                     QNSIGNAL(NoteSummaryListerAsync,listNoteSummariesFailed,
                               ErrorString,QUuid),
                      this,
-                     QNSLOT(NoteModel,onListNotesPerNotebooksAndTagsFailed,
-                            QStringList,QStringList,
-                            LocalStorageManager::GetNoteOptions,
-                            LocalStorageManager::ListObjectsOptions,
-                            size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
+                     QNSLOT(NoteModel,onListNoteSummariesFailed,
                             ErrorString,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,
-                              listNotesByLocalUidsComplete,
-                              QStringList,LocalStorageManager::GetNoteOptions,
-                              LocalStorageManager::ListObjectsOptions,
-                              size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
-                              QList<Note>,QUuid),
+    QObject::connect(m_pNoteIndex,
+                     QNSIGNAL(NoteIndexAsync,listNoteSummariesComplete,
+                              QList<NoteModelItem>,QUuid),
                      this,
-                     QNSLOT(NoteModel,onListNotesByLocalUidsComplete,
-                            QStringList,LocalStorageManager::GetNoteOptions,
-                            LocalStorageManager::ListObjectsOptions,
-                            size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
-                            QList<Note>,QUuid));
-    QObject::connect(&m_localStorageManagerAsync,
-                     QNSIGNAL(LocalStorageManagerAsync,
-                              listNotesByLocalUidsFailed,
-                              QStringList,LocalStorageManager::GetNoteOptions,
-                              LocalStorageManager::ListObjectsOptions,
-                              size_t,size_t,
-                              LocalStorageManager::ListNotesOrder,
-                              LocalStorageManager::OrderDirection,
+                     QNSLOT(NoteModel,onListNoteSummariesComplete,
+                            QList<NoteModelItem>,QUuid));
+    QObject::connect(m_pNoteIndex,
+                     QNSIGNAL(NoteIndexAsync,listNoteSummariesFailed,
                               ErrorString,QUuid),
                      this,
-                     QNSLOT(NoteModel,onListNotesByLocalUidsFailed,
-                            QStringList,LocalStorageManager::GetNoteOptions,
-                            LocalStorageManager::ListObjectsOptions,
-                            size_t,size_t,
-                            LocalStorageManager::ListNotesOrder,
-                            LocalStorageManager::OrderDirection,
+                     QNSLOT(NoteModel,onListNoteSummariesFailed,
                             ErrorString,QUuid));
     QObject::connect(&m_localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,getNoteCountComplete,
@@ -2031,7 +2335,15 @@ void NoteModel::disconnectFromLocalStorage()
 
     QObject::disconnect(&m_localStorageManagerAsync);
     m_localStorageManagerAsync.disconnect(this);
+    QObject::disconnect(m_pNoteSummaryLister);
+    m_pNoteSummaryLister->disconnect(this);
+    QObject::disconnect(m_pNoteIndex);
+    m_pNoteIndex->disconnect(this);
     m_connectedToLocalStorage = false;
+
+    // The completion of requests issued before the disconnection won't be
+    // received anymore
+    m_instrumentation.clearPendingRequests();
 }
 
 void NoteModel::onNoteAddedOrUpdated(
@@ -2049,9 +2361,39 @@ void NoteModel::onNoteAddedOrUpdated(
         return;
     }
 
+    // NOTE: the preview text serves as the sorting key for notes without
+    // title so for such notes it is computed right away; for other notes
+    // the conversion of ENML into the preview text is offloaded to the thread
+    // pool and the item keeps its previous preview text until then
+    bool deferPreviewText =
+        note.hasContent() && note.hasTitle() && !note.title().isEmpty();
+
     NoteModelItem item;
-    noteToItem(note, item);
+    noteToItem(note, item, !deferPreviewText);
 
+    if (deferPreviewText)
+    {
+        const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+        auto it = localUidIndex.find(note.localUid());
+        if (it != localUidIndex.end()) {
+            item.setPreviewText(it->previewText());
+        }
+    }
+    else
+    {
+        cancelNotePreviewTextExtraction(note.localUid());
+    }
+
+    onNoteItemAddedOrUpdated(item, fromNotesListing);
+
+    if (deferPreviewText) {
+        scheduleNotePreviewTextExtraction(note);
+    }
+}
+
+void NoteModel::onNoteItemAddedOrUpdated(
+    NoteModelItem & item, const bool fromNotesListing)
+{
     auto notebookIt = m_notebookDataByNotebookLocalUid.find(item.notebookLocalUid());
     if (notebookIt == m_notebookDataByNotebookLocalUid.end())
     {
@@ -2070,13 +2412,7 @@ void NoteModel::onNoteAddedOrUpdated(
         if (!findNotebookRequestSent)
         {
             Notebook notebook;
-            if (note.hasNotebookLocalUid()) {
-                notebook.setLocalUid(note.notebookLocalUid());
-            }
-            else {
-                notebook.setLocalUid(QString());
-                notebook.setGuid(note.notebookGuid());
-            }
+            notebook.setLocalUid(item.notebookLocalUid());
 
             QUuid requestId = QUuid::createUuid();
             Q_UNUSED(m_findNotebookRequestForNotebookLocalUid.insert(
@@ -2085,6 +2421,8 @@ void NoteModel::onNoteAddedOrUpdated(
             NMTRACE("Emitting the request to find notebook local uid: = "
                     << item.notebookLocalUid() << ", request id = "
                     << requestId);
+            m_instrumentation.recordRequestIssued(
+                QStringLiteral("findNotebook"), requestId);
             Q_EMIT findNotebook(notebook, requestId);
         }
         else
@@ -2100,194 +2438,295 @@ void NoteModel::onNoteAddedOrUpdated(
     addOrUpdateNoteItem(item, notebookData, fromNotesListing);
 }
 
-void NoteModel::noteToItem(const Note & note, NoteModelItem & item)
+void NoteModel::noteToItem(
+    const Note & note, NoteModelItem & item, const bool withPreviewText)
 {
-    item.setLocalUid(note.localUid());
-
-    if (note.hasGuid()) {
-        item.setGuid(note.guid());
-    }
-
-    if (note.hasNotebookGuid()) {
-        item.setNotebookGuid(note.notebookGuid());
-    }
+    NoteSummaryListerAsync::noteToSummary(note, item, withPreviewText);
+}
 
-    if (note.hasNotebookLocalUid()) {
-        item.setNotebookLocalUid(note.notebookLocalUid());
-    }
+void NoteModel::scheduleNotePreviewTextExtraction(const Note & note)
+{
+    NMTRACE("NoteModel::scheduleNotePreviewTextExtraction: note local uid = "
+            << note.localUid());
 
-    if (note.hasTitle()) {
-        item.setTitle(note.title());
+    // Extraction tasks are started on the next event loop iteration so that
+    // the burst of note updates coming from the local storage is processed
+    // in batches
+    if (m_notesPendingPreviewTextExtraction.isEmpty()) {
+        QTimer::singleShot(0, this, SLOT(extractPendingNotePreviewTexts()));
     }
 
-    if (note.hasContent()) {
-        QString previewText = note.plainText();
-        previewText.truncate(NOTE_PREVIEW_TEXT_SIZE);
-        item.setPreviewText(previewText);
-    }
+    m_notesPendingPreviewTextExtraction << note;
+}
 
-    item.setThumbnailData(note.thumbnailData());
+void NoteModel::cancelNotePreviewTextExtraction(const QString & noteLocalUid)
+{
+    Q_UNUSED(m_previewTextSequenceNumberByNoteLocalUid.remove(noteLocalUid))
 
-    if (note.hasTagLocalUids())
+    for(auto it = m_notesPendingPreviewTextExtraction.begin();
+        it != m_notesPendingPreviewTextExtraction.end(); )
     {
-        const QStringList & tagLocalUids = note.tagLocalUids();
-        item.setTagLocalUids(tagLocalUids);
-
-        QStringList tagNames;
-        tagNames.reserve(tagLocalUids.size());
-
-        for(auto it = tagLocalUids.constBegin(),
-            end = tagLocalUids.constEnd(); it != end; ++it)
-        {
-            auto tagIt = m_tagDataByTagLocalUid.find(*it);
-            if (tagIt != m_tagDataByTagLocalUid.end()) {
-                const TagData & tagData = tagIt.value();
-                tagNames << tagData.m_name;
-            }
+        if (it->localUid() == noteLocalUid) {
+            it = m_notesPendingPreviewTextExtraction.erase(it);
+            continue;
         }
 
-        item.setTagNameList(tagNames);
+        ++it;
     }
+}
 
-    if (note.hasTagGuids()) {
-        const QStringList tagGuids = note.tagGuids();
-        item.setTagGuids(tagGuids);
-    }
+void NoteModel::extractPendingNotePreviewTexts()
+{
+    NMDEBUG("NoteModel::extractPendingNotePreviewTexts: num notes = "
+            << m_notesPendingPreviewTextExtraction.size());
 
-    if (note.hasCreationTimestamp()) {
-        item.setCreationTimestamp(note.creationTimestamp());
-    }
+    QList<Note> notes = m_notesPendingPreviewTextExtraction;
+    m_notesPendingPreviewTextExtraction.clear();
 
-    if (note.hasModificationTimestamp()) {
-        item.setModificationTimestamp(note.modificationTimestamp());
-    }
+    for(int offset = 0, size = notes.size(); offset < size;
+        offset += NOTE_PREVIEW_TEXT_EXTRACTION_BATCH_SIZE)
+    {
+        QList<Note> batch =
+            notes.mid(offset, NOTE_PREVIEW_TEXT_EXTRACTION_BATCH_SIZE);
 
-    if (note.hasDeletionTimestamp()) {
-        item.setDeletionTimestamp(note.deletionTimestamp());
+        quint64 sequenceNumber = ++m_lastPreviewTextSequenceNumber;
+        for(auto it = batch.constBegin(), end = batch.constEnd(); it != end; ++it) {
+            m_previewTextSequenceNumberByNoteLocalUid[it->localUid()] =
+                sequenceNumber;
+        }
+
+        NotePreviewTextExtractor * pExtractor =
+            new NotePreviewTextExtractor(batch, sequenceNumber);
+        QObject::connect(pExtractor,
+                         QNSIGNAL(NotePreviewTextExtractor,
+                                  previewTextsExtracted,
+                                  quint64,QStringList,QStringList),
+                         this,
+                         QNSLOT(NoteModel,onNotePreviewTextsExtracted,
+                                quint64,QStringList,QStringList));
+        QThreadPool::globalInstance()->start(pExtractor);
     }
+}
 
-    item.setSynchronizable(!note.isLocal());
-    item.setDirty(note.isDirty());
-    item.setFavorited(note.isFavorited());
-    item.setActive(note.hasActive() ? note.active() : true);
-    item.setHasResources(note.hasResources() && (note.numResources() > 0));
+void NoteModel::onNotePreviewTextsExtracted(
+    quint64 sequenceNumber, QStringList noteLocalUids,
+    QStringList previewTexts)
+{
+    NMDEBUG("NoteModel::onNotePreviewTextsExtracted: sequence number = "
+            << sequenceNumber << ", num notes = " << noteLocalUids.size());
 
-    if (note.hasNoteRestrictions())
-    {
-        const qevercloud::NoteRestrictions & restrictions = note.noteRestrictions();
-        item.setCanUpdateTitle(!restrictions.noUpdateTitle.isSet() ||
-                               !restrictions.noUpdateTitle.ref());
-        item.setCanUpdateContent(!restrictions.noUpdateContent.isSet() ||
-                                 !restrictions.noUpdateContent.ref());
-        item.setCanEmail(!restrictions.noEmail.isSet() ||
-                         !restrictions.noEmail.ref());
-        item.setCanShare(!restrictions.noShare.isSet() ||
-                         !restrictions.noShare.ref());
-        item.setCanSharePublicly(!restrictions.noSharePublicly.isSet() ||
-                                 !restrictions.noSharePublicly.ref());
-    }
-    else
-    {
-        item.setCanUpdateTitle(true);
-        item.setCanUpdateContent(true);
-        item.setCanEmail(true);
-        item.setCanShare(true);
-        item.setCanSharePublicly(true);
-    }
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
 
-    qint64 sizeInBytes = 0;
-    if (note.hasContent()) {
-        sizeInBytes += note.content().size();
-    }
+    QVector<int> rows;
+    rows.reserve(noteLocalUids.size());
 
-    if (note.hasResources())
+    for(int i = 0, size = noteLocalUids.size(); i < size; ++i)
     {
-        QList<Resource> resources = note.resources();
-        for(auto it = resources.constBegin(),
-            end = resources.constEnd(); it != end; ++it)
-        {
-            const Resource & resource = *it;
+        const QString & noteLocalUid = noteLocalUids[i];
 
-            if (resource.hasDataBody()) {
-                sizeInBytes += resource.dataBody().size();
-            }
+        auto sequenceNumberIt =
+            m_previewTextSequenceNumberByNoteLocalUid.find(noteLocalUid);
+        if ((sequenceNumberIt == m_previewTextSequenceNumberByNoteLocalUid.end()) ||
+            (sequenceNumberIt.value() != sequenceNumber))
+        {
+            NMTRACE("Skipping stale preview text for note " << noteLocalUid);
+            continue;
+        }
 
-            if (resource.hasRecognitionDataBody()) {
-                sizeInBytes += resource.recognitionDataBody().size();
-            }
+        Q_UNUSED(m_previewTextSequenceNumberByNoteLocalUid.erase(sequenceNumberIt))
 
-            if (resource.hasAlternateDataBody()) {
-                sizeInBytes += resource.alternateDataBody().size();
-            }
+        auto itemIt = localUidIndex.find(noteLocalUid);
+        if ((itemIt == localUidIndex.end()) || itemIt->isEvicted()) {
+            continue;
         }
+
+        NoteModelItem item = *itemIt;
+        item.setPreviewText(previewTexts.value(i));
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+
+        auto indexIt = m_data.project<ByIndex>(itemIt);
+        rows << static_cast<int>(std::distance(index.begin(), indexIt));
     }
 
-    sizeInBytes = std::max(qint64(0), sizeInBytes);
-    item.setSizeInBytes(static_cast<quint64>(sizeInBytes));
+    // NOTE: the notes from the same batch might be far apart in the model
+    // so the rows in between are not reported as changed
+    emitDataChangedForRows(rows, Columns::PreviewText, Columns::PreviewText);
 }
 
-bool NoteModel::noteConformsToFilter(const Note & note) const
+QString NoteModel::notebookNameForItem(const NoteModelItem & item) const
 {
-    if (Q_UNLIKELY(!note.hasNotebookLocalUid())) {
-        return false;
+    auto notebookIt =
+        m_notebookDataByNotebookLocalUid.find(item.notebookLocalUid());
+    if (notebookIt == m_notebookDataByNotebookLocalUid.end()) {
+        return QString();
     }
 
-    if (!m_pFilters) {
-        return true;
+    return notebookIt->m_name;
+}
+
+QStringList NoteModel::tagNamesForItem(const NoteModelItem & item) const
+{
+    const QStringList & tagLocalUids = item.tagLocalUids();
+    if (tagLocalUids.isEmpty()) {
+        return QStringList();
     }
 
-    const QSet<QString> & filteredNoteLocalUids = m_pFilters->filteredNoteLocalUids();
-    if (!filteredNoteLocalUids.isEmpty() &&
-        !filteredNoteLocalUids.contains(note.localUid()))
+    QStringList tagNames;
+    tagNames.reserve(tagLocalUids.size());
+
+    for(auto it = tagLocalUids.constBegin(),
+        end = tagLocalUids.constEnd(); it != end; ++it)
     {
-        return false;
+        auto tagIt = m_tagDataByTagLocalUid.find(*it);
+        if ((tagIt != m_tagDataByTagLocalUid.end()) &&
+            !tagIt->m_name.isEmpty())
+        {
+            tagNames << tagIt->m_name;
+        }
     }
 
-    const QStringList & filteredNotebookLocalUids =
-        m_pFilters->filteredNotebookLocalUids();
-    if (!filteredNotebookLocalUids.isEmpty() &&
-        !filteredNotebookLocalUids.contains(note.notebookLocalUid()))
+    return tagNames;
+}
+
+void NoteModel::internItemStrings(NoteModelItem & item)
+{
+    item.setNotebookLocalUid(internedString(item.notebookLocalUid()));
+    item.setNotebookGuid(internedString(item.notebookGuid()));
+
+    auto notebookIt =
+        m_notebookDataByNotebookLocalUid.constFind(item.notebookLocalUid());
+    if (notebookIt != m_notebookDataByNotebookLocalUid.constEnd()) {
+        item.setNotebookName(notebookIt->m_name);
+    }
+    else {
+        item.setNotebookName(QString());
+    }
+
+    QStringList tagLocalUids = item.tagLocalUids();
+    for(auto it = tagLocalUids.begin(), end = tagLocalUids.end(); it != end; ++it) {
+        *it = internedString(*it);
+    }
+    item.setTagLocalUids(tagLocalUids);
+
+    QStringList tagGuids = item.tagGuids();
+    for(auto it = tagGuids.begin(), end = tagGuids.end(); it != end; ++it) {
+        *it = internedString(*it);
+    }
+    item.setTagGuids(tagGuids);
+}
+
+QString NoteModel::internedString(const QString & str)
+{
+    if (str.isEmpty()) {
+        return QString();
+    }
+
+    auto it = m_internedStrings.constFind(str);
+    if (it != m_internedStrings.constEnd()) {
+        return *it;
+    }
+
+    Q_UNUSED(m_internedStrings.insert(str))
+    return str;
+}
+
+void NoteModel::pruneInternedStrings()
+{
+    // The interned string not shared with anything else is no longer used
+    // by any item
+    for(auto it = m_internedStrings.begin(); it != m_internedStrings.end(); )
     {
-        return false;
+        if (it->isDetached()) {
+            it = m_internedStrings.erase(it);
+        }
+        else {
+            ++it;
+        }
     }
+}
 
-    const QStringList & filteredTagLocalUids = m_pFilters->filteredTagLocalUids();
-    if (!filteredTagLocalUids.isEmpty())
+void NoteModel::emitDataChangedForRows(
+    QVector<int> & rows, const Columns::type firstColumn,
+    const Columns::type lastColumn)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    int rangeStart = rows[0];
+    int rangeEnd = rangeStart;
+    for(int i = 1, size = rows.size(); i <= size; ++i)
     {
-        bool foundTag = false;
-        const QStringList & tagLocalUids = note.tagLocalUids();
-        for(auto it = tagLocalUids.constBegin(),
-            end = tagLocalUids.end(); it != end; ++it)
-        {
-            if (filteredTagLocalUids.contains(*it)) {
-                foundTag = true;
-                break;
-            }
+        if ((i < size) && (rows[i] <= rangeEnd + 1)) {
+            rangeEnd = std::max(rangeEnd, rows[i]);
+            continue;
         }
 
-        if (!foundTag) {
-            return false;
+        QModelIndex modelIndexFrom = createIndex(rangeStart, firstColumn);
+        QModelIndex modelIndexTo = createIndex(rangeEnd, lastColumn);
+        Q_EMIT dataChanged(modelIndexFrom, modelIndexTo);
+
+        if (i < size) {
+            rangeStart = rows[i];
+            rangeEnd = rangeStart;
         }
     }
+}
 
-    return true;
+bool NoteModel::noteConformsToFilter(const Note & note) const
+{
+    if (Q_UNLIKELY(!note.hasNotebookLocalUid())) {
+        return false;
+    }
+
+    if (!m_pFilters) {
+        return true;
+    }
+
+    return m_pFilters->noteConforms(note.localUid(), note.notebookLocalUid(),
+                                    note.tagLocalUids());
 }
 
-void NoteModel::onListNotesCompleteImpl(const QList<Note> foundNotes)
+void NoteModel::onListNotesCompleteImpl(const QList<NoteModelItem> & summaries)
 {
-    bool fromNotesListing = true;
-    for(auto it = foundNotes.begin(), end = foundNotes.end(); it != end; ++it) {
-        onNoteAddedOrUpdated(*it, fromNotesListing);
+    QList<NoteModelItem> items;
+    items.reserve(summaries.size());
+
+    for(auto it = summaries.constBegin(),
+        end = summaries.constEnd(); it != end; ++it)
+    {
+        if (Q_UNLIKELY(it->notebookLocalUid().isEmpty())) {
+            NMWARNING("Skipping the note not having the notebook local uid: "
+                      << *it);
+            continue;
+        }
+
+        items << *it;
     }
-    m_listNotesOffset += static_cast<size_t>(foundNotes.size());
+
+    addOrUpdateNoteItemsFromNotesListing(items);
+    m_listNotesOffset += static_cast<size_t>(summaries.size());
 
     m_listNotesRequestId = QUuid();
 
-    if (!foundNotes.isEmpty() && (m_data.size() < NOTE_MIN_CACHE_SIZE)) {
+    bool pendingFetchMore = m_pendingFetchMore;
+    m_pendingFetchMore = false;
+
+    if (!summaries.isEmpty() && (m_data.size() < NOTE_MIN_CACHE_SIZE)) {
         NMTRACE("The number of found notes is greater than zero, "
                 "requesting more notes from the local storage");
         requestNotesList();
     }
+    else if (!summaries.isEmpty() && pendingFetchMore &&
+             (m_data.size() < m_maxNoteCount))
+    {
+        NMTRACE("Fetching more notes was requested during the pending list "
+                "notes request, requesting more notes from the local storage");
+        requestNotesList();
+    }
     else {
         NMDEBUG("Emitting minimalNotesBatchLoaded signal");
         Q_EMIT minimalNotesBatchLoaded();
@@ -2306,12 +2745,21 @@ void NoteModel::requestNotesList()
 {
     NMDEBUG("NoteModel::requestNotesList");
 
+    m_listNotesRequestId = QUuid::createUuid();
+    requestNotesListImpl(m_listNotesOffset, listNotesQueryLimit(),
+                         m_listNotesRequestId);
+}
+
+void NoteModel::requestNotesListImpl(
+    const size_t offset, const size_t limit, const QUuid & requestId)
+{
     LocalStorageManager::ListObjectsOptions flags =
         LocalStorageManager::ListObjectsOption::ListAll;
     LocalStorageManager::ListNotesOrder order =
         LocalStorageManager::ListNotesOrder::ByModificationTimestamp;
     LocalStorageManager::OrderDirection direction =
         LocalStorageManager::OrderDirection::Ascending;
+    bool bySize = false;
 
     switch(m_noteSortingMode)
     {
@@ -2339,56 +2787,89 @@ void NoteModel::requestNotesList()
         order = LocalStorageManager::ListNotesOrder::ByTitle;
         direction = LocalStorageManager::OrderDirection::Descending;
         break;
-    // NOTE: no sorting by side is supported by the local storage so leaving
-    // it as is for now
+    // NOTE: the local storage doesn't support sorting by size so notes
+    // ordered by size are listed using the note index maintained by
+    // NoteIndexAsync
+    case NoteSortingMode::SizeAscending:
+        bySize = true;
+        direction = LocalStorageManager::OrderDirection::Ascending;
+        break;
+    case NoteSortingMode::SizeDescending:
+        bySize = true;
+        direction = LocalStorageManager::OrderDirection::Descending;
+        break;
     default:
         break;
     }
 
-    m_listNotesRequestId = QUuid::createUuid();
+    if (bySize &&
+        (!hasFilters() || m_pFilters->filteredNoteLocalUids().isEmpty()))
+    {
+        NoteIndexQuery query;
+        if (hasFilters()) {
+            query.m_notebookLocalUids = m_pFilters->filteredNotebookLocalUids();
+            query.m_tagLocalUids = m_pFilters->filteredTagLocalUids();
+        }
+
+        query.m_includeNonDeletedNotes =
+            (m_includedNotes != IncludedNotes::Deleted);
+        query.m_includeDeletedNotes =
+            (m_includedNotes != IncludedNotes::NonDeleted);
+        query.m_order = order;
+        query.m_orderBySize = bySize;
+
+        NMDEBUG("Emitting the request to list indexed notes: offset = "
+                << offset << ", limit = " << limit
+                << ", request id = " << requestId
+                << ", order = " << order
+                << ", order by size = " << (bySize ? "true" : "false")
+                << ", direction = " << direction
+                << ", notebook local uids: "
+                << query.m_notebookLocalUids.join(QStringLiteral(", "))
+                << "; tag local uids: "
+                << query.m_tagLocalUids.join(QStringLiteral(", ")));
+
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("listIndexedNoteSummaries"), requestId);
+        Q_EMIT listIndexedNoteSummaries(query, direction, limit, offset,
+                                        requestId);
+        return;
+    }
 
     if (!hasFilters())
     {
         NMDEBUG("Emitting the request to list notes: offset = "
-                << m_listNotesOffset << ", request id = "
-                << m_listNotesRequestId << ", order = "
+                << offset << ", limit = " << limit
+                << ", request id = " << requestId << ", order = "
                 << order << ", direction = " << direction);
 
-        Q_EMIT listNotes(flags, LocalStorageManager::GetNoteOptions(0),
-                         NOTE_LIST_QUERY_LIMIT, m_listNotesOffset, order,
-                         direction, QString(), m_listNotesRequestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("listNoteSummaries"), requestId);
+        Q_EMIT listNoteSummaries(flags, limit, offset, order,
+                                 direction, requestId);
         return;
     }
 
-    const QSet<QString> & filteredNoteLocalUids = m_pFilters->filteredNoteLocalUids();
+    const QStringList & filteredNoteLocalUids =
+        m_pFilters->filteredNoteLocalUidsList();
     if (!filteredNoteLocalUids.isEmpty())
     {
-        int end = static_cast<int>(m_listNotesOffset) + NOTE_LIST_QUERY_LIMIT;
-        end = std::min(end, filteredNoteLocalUids.size());
-
-        auto beginIt = filteredNoteLocalUids.begin();
-        std::advance(beginIt, static_cast<int>(m_listNotesOffset));
-
-        auto endIt = filteredNoteLocalUids.begin();
-        std::advance(endIt, end);
-
-        QStringList noteLocalUids;
-        noteLocalUids.reserve(std::max((end - static_cast<int>(m_listNotesOffset)), 0));
-        for(auto it = beginIt; it != endIt; ++it) {
-            noteLocalUids << *it;
-        }
-
-        NMDEBUG("Emitting the request to list notes by local uids: "
-                << ", request id = " << m_listNotesRequestId
+        // NOTE: the whole list of filtered note local uids is passed along
+        // with each page request: the lister orders it once and then serves
+        // the consequent pages from the ordered list
+        NMDEBUG("Emitting the request to list ordered notes by local uids: "
+                << "offset = " << offset << ", limit = " << limit
+                << ", request id = " << requestId
                 << ", order = " << order
+                << ", order by size = " << (bySize ? "true" : "false")
                 << ", direction = " << direction
-                << ", note local uids: "
-                << noteLocalUids.join(QStringLiteral(", ")));
+                << ", num note local uids = " << filteredNoteLocalUids.size());
 
-        Q_EMIT listNotesByLocalUids(noteLocalUids,
-                                    LocalStorageManager::GetNoteOptions(0),
-                                    flags, NOTE_LIST_QUERY_LIMIT, 0, order, direction,
-                                    m_listNotesRequestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("listOrderedNoteSummariesByLocalUids"), requestId);
+        Q_EMIT listOrderedNoteSummariesByLocalUids(
+            filteredNoteLocalUids, flags, limit, offset, order, bySize,
+            direction, requestId);
         return;
     }
 
@@ -2396,8 +2877,9 @@ void NoteModel::requestNotesList()
     const QStringList & tagLocalUids = m_pFilters->filteredTagLocalUids();
 
     NMDEBUG("Emitting the request to list notes per notebooks "
-            << "and tags: offset = " << m_listNotesOffset
-            << ", request id = " << m_listNotesRequestId
+            << "and tags: offset = " << offset
+            << ", limit = " << limit
+            << ", request id = " << requestId
             << ", order = " << order
             << ", direction = " << direction
             << ", notebook local uids: "
@@ -2405,11 +2887,264 @@ void NoteModel::requestNotesList()
             << "; tag local uids: "
             << tagLocalUids.join(QStringLiteral(", ")));
 
-    Q_EMIT listNotesPerNotebooksAndTags(
-        notebookLocalUids, tagLocalUids,
-        LocalStorageManager::GetNoteOptions(0),
-        flags, NOTE_LIST_QUERY_LIMIT, m_listNotesOffset,
-        order, direction, m_listNotesRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listNoteSummariesPerNotebooksAndTags"), requestId);
+    Q_EMIT listNoteSummariesPerNotebooksAndTags(
+        notebookLocalUids, tagLocalUids, flags, limit, offset,
+        order, direction, requestId);
+}
+
+size_t NoteModel::listNotesQueryLimit() const
+{
+    size_t limit = NOTE_LIST_QUERY_LIMIT;
+    if (m_maxNoteCount > m_data.size()) {
+        limit = std::max(limit, m_maxNoteCount - m_data.size());
+    }
+
+    return std::min(limit, static_cast<size_t>(NOTE_LIST_QUERY_MAX_LIMIT));
+}
+
+size_t NoteModel::fetchMoreBatchSize()
+{
+    int screensAhead = NOTE_FETCH_MORE_SCREENS_AHEAD;
+    if (m_fetchMoreTimer.isValid() &&
+        (m_fetchMoreTimer.elapsed() < NOTE_FETCH_MORE_FAST_SCROLL_THRESHOLD_MSEC))
+    {
+        screensAhead = NOTE_FETCH_MORE_FAST_SCROLL_SCREENS_AHEAD;
+    }
+
+    m_fetchMoreTimer.start();
+
+    int batchSize = m_viewportRowCount * screensAhead;
+    batchSize = std::max(batchSize, NOTE_LIST_QUERY_LIMIT);
+    batchSize = std::min(batchSize, NOTE_LIST_QUERY_MAX_LIMIT);
+
+    NMTRACE("NoteModel::fetchMoreBatchSize: viewport row count = "
+            << m_viewportRowCount << ", screens ahead = " << screensAhead
+            << ", batch size = " << batchSize);
+
+    return static_cast<size_t>(batchSize);
+}
+
+void NoteModel::evictItemsOutsideOfWindow()
+{
+    // NOTE: evicting only the items which are twice as far from the visible
+    // rows as the rehydration margin to prevent the items on the window border
+    // from being evicted and rehydrated back and forth as the view scrolls
+    int margin = 2 * windowMargin();
+    int firstRow = m_firstVisibleRow - margin;
+    int lastRow = m_lastVisibleRow + margin;
+
+    // NOTE: the hydrated items are walked only once their number exceeds twice
+    // the window size so that the walk is not repeated on each scroll but once
+    // per window worth of rehydrated items
+    int windowSize = std::max(lastRow - firstRow + 1, 1);
+    if (m_hydratedNoteLocalUids.size() <= 2 * windowSize) {
+        return;
+    }
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
+
+    QVector<int> evictedRows;
+    for(auto it = m_hydratedNoteLocalUids.begin();
+        it != m_hydratedNoteLocalUids.end(); )
+    {
+        auto itemIt = localUidIndex.find(*it);
+        if (itemIt == localUidIndex.end()) {
+            it = m_hydratedNoteLocalUids.erase(it);
+            continue;
+        }
+
+        auto indexIt = m_data.project<ByIndex>(itemIt);
+        int row = static_cast<int>(std::distance(index.begin(), indexIt));
+        if ((row >= firstRow) && (row <= lastRow)) {
+            ++it;
+            continue;
+        }
+
+        NoteModelItem item = *itemIt;
+        shrinkItemToPlaceholder(item);
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+
+        evictedRows << row;
+        it = m_hydratedNoteLocalUids.erase(it);
+    }
+
+    if (!evictedRows.isEmpty()) {
+        NMDEBUG("Evicted " << evictedRows.size() << " note items outside of "
+                << "rows range [" << firstRow << ", " << lastRow << "]");
+    }
+
+    emitDataChangedForRows(evictedRows, Columns::PreviewText,
+                           Columns::TagNameList);
+
+    removeExcessEvictedItems(lastRow);
+}
+
+void NoteModel::removeExcessEvictedItems(const int lastWindowRow)
+{
+    size_t numItems = m_data.size();
+    size_t numHydratedItems = std::min(
+        numItems, static_cast<size_t>(m_hydratedNoteLocalUids.size()));
+    size_t numEvictedItems = numItems - numHydratedItems;
+    if (numEvictedItems <= NOTE_MAX_EVICTED_ITEMS) {
+        return;
+    }
+
+    if ((m_listNotesRequestId != QUuid()) ||
+        (m_reconcileSortingRequestId != QUuid()))
+    {
+        NMDEBUG("Won't remove the excess evicted items while the list notes "
+                "request is pending");
+        return;
+    }
+
+    // NOTE: only the rows below the window are removed: removing the rows
+    // above it would shift the rows under the view; the removed notes are
+    // listed again once the view is scrolled down to them
+    size_t numExcessItems = numEvictedItems - NOTE_MAX_EVICTED_ITEMS;
+    int firstRow = std::max(lastWindowRow + 1,
+                            static_cast<int>(numItems - numExcessItems));
+    int lastRow = static_cast<int>(numItems) - 1;
+    if (firstRow > lastRow) {
+        return;
+    }
+
+    NMDEBUG("Removing " << (lastRow - firstRow + 1) << " rows below "
+            << "the window to keep the number of evicted items within "
+            << "the limit: rows range [" << firstRow << ", " << lastRow
+            << "]");
+
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+    for(int row = firstRow; row <= lastRow; ++row)
+    {
+        const QString & localUid = index[static_cast<size_t>(row)].localUid();
+        cancelNotePreviewTextExtraction(localUid);
+        Q_UNUSED(m_hydratedNoteLocalUids.remove(localUid))
+    }
+
+    beginRemoveRows(QModelIndex(), firstRow, lastRow);
+    Q_UNUSED(index.erase(index.begin() + firstRow, index.end()))
+    endRemoveRows();
+
+    pruneInternedStrings();
+
+    // The remaining rows are the first notes in the current sorting order
+    // so the next listing continues right after them
+    m_listNotesOffset = m_data.size();
+    m_maxNoteCount = std::max(m_data.size(),
+                              static_cast<size_t>(NOTE_MIN_CACHE_SIZE * 2));
+}
+
+void NoteModel::shrinkItemToPlaceholder(NoteModelItem & item)
+{
+    // NOTE: all the sorting keys are kept rather than only the one for
+    // the current sorting column since the sorting can change while the item
+    // is evicted; the preview text is the sorting key for notes without title.
+    // The notebook local uid is the key of the index by notebook and is shared
+    // by all items anyway
+    item.setGuid(QString());
+    item.setNotebookGuid(QString());
+    item.setTagLocalUids(QStringList());
+    item.setTagGuids(QStringList());
+
+    if (!item.title().isEmpty()) {
+        item.setPreviewText(QString());
+    }
+
+    item.setThumbnailData(QByteArray());
+    item.setEvicted(true);
+}
+
+void NoteModel::rehydrateEvictedItems(int firstRow, int lastRow)
+{
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, static_cast<int>(m_data.size()) - 1);
+
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
+
+    QStringList noteLocalUids;
+    for(int row = firstRow; row <= lastRow; ++row)
+    {
+        const NoteModelItem & item = index[static_cast<size_t>(row)];
+        if (!item.isEvicted()) {
+            continue;
+        }
+
+        if (m_noteLocalUidsPendingRehydration.contains(item.localUid())) {
+            continue;
+        }
+
+        Q_UNUSED(m_noteLocalUidsPendingRehydration.insert(item.localUid()))
+        noteLocalUids << item.localUid();
+    }
+
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    QUuid requestId = QUuid::createUuid();
+    m_noteLocalUidsByRehydrateRequestId[requestId] = noteLocalUids;
+
+    NMDEBUG("Emitting the request to list evicted notes by local uids: "
+            << "request id = " << requestId << ", note local uids: "
+            << noteLocalUids.join(QStringLiteral(", ")));
+
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listNoteSummariesByLocalUids"), requestId);
+    Q_EMIT listNoteSummariesByLocalUids(
+        noteLocalUids, LocalStorageManager::ListObjectsOption::ListAll,
+        static_cast<size_t>(noteLocalUids.size()), 0,
+        LocalStorageManager::ListNotesOrder::NoOrder,
+        LocalStorageManager::OrderDirection::Ascending,
+        requestId);
+}
+
+void NoteModel::onRehydrateNotesComplete(
+    const QList<NoteModelItem> & summaries)
+{
+    NMDEBUG("NoteModel::onRehydrateNotesComplete: num found notes = "
+            << summaries.size());
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    QVector<int> rehydratedRows;
+    rehydratedRows.reserve(summaries.size());
+
+    for(auto it = summaries.constBegin(),
+        end = summaries.constEnd(); it != end; ++it)
+    {
+        const NoteModelItem & summary = *it;
+
+        auto itemIt = localUidIndex.find(summary.localUid());
+        if ((itemIt == localUidIndex.end()) || !itemIt->isEvicted()) {
+            continue;
+        }
+
+        // The placeholder only keeps the sorting keys so the item is restored
+        // from the summary as a whole
+        NoteModelItem item = summary;
+        item.setEvicted(false);
+        internItemStrings(item);
+        Q_UNUSED(localUidIndex.replace(itemIt, item))
+        findTagDataForItem(item);
+
+        if (m_windowedMode) {
+            Q_UNUSED(m_hydratedNoteLocalUids.insert(item.localUid()))
+        }
+
+        rehydratedRows << indexForLocalUid(item.localUid()).row();
+    }
+
+    emitDataChangedForRows(rehydratedRows, Columns::PreviewText,
+                           Columns::TagNameList);
+}
+
+int NoteModel::windowMargin() const
+{
+    return std::max(m_viewportRowCount * NOTE_WINDOW_MARGIN_SCREENS,
+                    NOTE_WINDOW_MIN_MARGIN);
 }
 
 void NoteModel::requestNotesCount()
@@ -2436,6 +3171,8 @@ void NoteModel::requestTotalNotesCountPerAccount()
             << m_getFullNoteCountPerAccountRequestId);
 
     LocalStorageManager::NoteCountOptions options = noteCountOptions();
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("getNoteCount"), m_getFullNoteCountPerAccountRequestId);
     Q_EMIT getNoteCount(options, m_getFullNoteCountPerAccountRequestId);
 }
 
@@ -2452,6 +3189,8 @@ void NoteModel::requestTotalFilteredNotesCount()
                 << "options = " << options
                 << ", request id = " << m_getNoteCountRequestId);
 
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("getNoteCount"), m_getNoteCountRequestId);
         Q_EMIT getNoteCount(options, m_getNoteCountRequestId);
         return;
     }
@@ -2460,7 +3199,7 @@ void NoteModel::requestTotalFilteredNotesCount()
     if (!filteredNoteLocalUids.isEmpty()) {
         m_getNoteCountRequestId = QUuid();
         m_totalFilteredNotesCount = filteredNoteLocalUids.size();
-        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+        notifyNoteCountsUpdated();
         return;
     }
 
@@ -2474,10 +3213,102 @@ void NoteModel::requestTotalFilteredNotesCount()
             << "notebooks and tags: options = " << options
             << ", request id = " << m_getNoteCountRequestId);
 
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("getNoteCountPerNotebooksAndTags"),
+        m_getNoteCountRequestId);
     Q_EMIT getNoteCountPerNotebooksAndTags(
         notebookLocalUids, tagLocalUids, options, m_getNoteCountRequestId);
 }
 
+void NoteModel::scheduleNoteCountsReconciliation()
+{
+    if (m_noteCountsReconciliationTimer.isActive()) {
+        return;
+    }
+
+    NMTRACE("NoteModel::scheduleNoteCountsReconciliation");
+    m_noteCountsReconciliationTimer.start(
+        NOTE_COUNT_RECONCILIATION_INTERVAL_MSEC, this);
+}
+
+void NoteModel::notifyNoteCountsUpdated()
+{
+    if (m_noteCountsNotificationTimer.isActive()) {
+        m_pendingNoteCountsNotification = true;
+        return;
+    }
+
+    emitNoteCountsUpdated();
+    m_noteCountsNotificationTimer.start(
+        NOTE_COUNT_NOTIFICATION_INTERVAL_MSEC, this);
+}
+
+void NoteModel::emitNoteCountsUpdated()
+{
+    if (m_lastNotifiedAccountNotesCount != m_totalAccountNotesCount) {
+        m_lastNotifiedAccountNotesCount = m_totalAccountNotesCount;
+        Q_EMIT noteCountPerAccountUpdated(m_totalAccountNotesCount);
+    }
+
+    if (m_lastNotifiedFilteredNotesCount != m_totalFilteredNotesCount) {
+        m_lastNotifiedFilteredNotesCount = m_totalFilteredNotesCount;
+        Q_EMIT filteredNotesCountUpdated(m_totalFilteredNotesCount);
+    }
+}
+
+void NoteModel::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_noteCountsReconciliationTimer.timerId())
+    {
+        m_noteCountsReconciliationTimer.stop();
+
+        NMDEBUG("Reconciling note counts with the local storage");
+
+        // NOTE: the results of the pending count requests might not reflect
+        // the changes which caused the reconciliation so the counts still
+        // being requested would be requested again later
+        bool pendingCountRequest = false;
+
+        if (m_getFullNoteCountPerAccountRequestId == QUuid()) {
+            requestTotalNotesCountPerAccount();
+        }
+        else {
+            pendingCountRequest = true;
+        }
+
+        if (m_getNoteCountRequestId == QUuid()) {
+            requestTotalFilteredNotesCount();
+        }
+        else {
+            pendingCountRequest = true;
+        }
+
+        if (pendingCountRequest) {
+            scheduleNoteCountsReconciliation();
+        }
+
+        return;
+    }
+
+    if (pEvent->timerId() == m_noteCountsNotificationTimer.timerId())
+    {
+        if (!m_pendingNoteCountsNotification) {
+            m_noteCountsNotificationTimer.stop();
+            return;
+        }
+
+        m_pendingNoteCountsNotification = false;
+        emitNoteCountsUpdated();
+        return;
+    }
+
+    QAbstractItemModel::timerEvent(pEvent);
+}
+
 void NoteModel::findNoteToRestoreFailedUpdate(const Note & note)
 {
     NMDEBUG("NoteModel::findNoteToRestoreFailedUpdate: local uid = "
@@ -2489,6 +3320,8 @@ void NoteModel::findNoteToRestoreFailedUpdate(const Note & note)
             << note.localUid() << ", request id = " << requestId);
     LocalStorageManager::GetNoteOptions getNoteOptions(
         LocalStorageManager::GetNoteOption::WithResourceMetadata);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNote"), requestId);
     Q_EMIT findNote(note, getNoteOptions, requestId);
 }
 
@@ -2501,11 +3334,25 @@ void NoteModel::clearModel()
     m_data.clear();
     m_totalFilteredNotesCount = 0;
     m_maxNoteCount = NOTE_MIN_CACHE_SIZE * 2;
+    m_fetchMoreTimer.invalidate();
+    m_pendingFetchMore = false;
+    m_firstVisibleRow = 0;
+    m_lastVisibleRow = -1;
+    m_hydratedNoteLocalUids.clear();
+    m_noteLocalUidsPendingRehydration.clear();
+    m_noteLocalUidsByRehydrateRequestId.clear();
+    m_notesPendingPreviewTextExtraction.clear();
+    m_previewTextSequenceNumberByNoteLocalUid.clear();
     m_listNotesOffset = 0;
     m_listNotesRequestId = QUuid();
+    m_reconcileSortingRequestId = QUuid();
+    m_reconcileSortingLimit = 0;
     m_getNoteCountRequestId = QUuid();
     m_totalAccountNotesCount = 0;
     m_getFullNoteCountPerAccountRequestId = QUuid();
+    m_noteCountsReconciliationTimer.stop();
+    m_noteCountsNotificationTimer.stop();
+    m_pendingNoteCountsNotification = false;
     m_notebookDataByNotebookLocalUid.clear();
     m_findNotebookRequestForNotebookLocalUid.clear();
     m_localUidsOfNewNotesBeingAddedToLocalStorage.clear();
@@ -2516,9 +3363,12 @@ void NoteModel::clearModel()
     m_findNoteToPerformUpdateRequestIds.clear();
     m_noteItemsPendingNotebookDataUpdate.clear();
     m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap.clear();
+    m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook.clear();
+    m_deletedNoteItemsPendingUpdate.clear();
     m_tagDataByTagLocalUid.clear();
     m_findTagRequestForTagLocalUid.clear();
-    m_tagLocalUidToNoteLocalUid.clear();
+    m_noteLocalUidsByTagLocalUid.clear();
+    m_internedStrings.clear();
 
     endResetModel();
 }
@@ -2527,16 +3377,204 @@ void NoteModel::resetModel()
 {
     NMDEBUG("NoteModel::resetModel");
 
+    // NOTE: the model is reset on each filter change but the total note count
+    // per account doesn't depend on the filters so it is not requested again
+    // unless it's unknown
+    qint32 totalAccountNotesCount = 0;
+    if ((m_getFullNoteCountPerAccountRequestId == QUuid()) &&
+        !m_noteCountsReconciliationTimer.isActive())
+    {
+        totalAccountNotesCount = m_totalAccountNotesCount;
+    }
+
     clearModel();
+
+    m_totalAccountNotesCount = totalAccountNotesCount;
     requestNotesListAndCount();
 }
 
+void NoteModel::sortLoadedItems(const bool orderReversed)
+{
+    NMDEBUG("NoteModel::sortLoadedItems: order reversed = "
+            << (orderReversed ? "true" : "false"));
+
+    Q_EMIT layoutAboutToBeChanged();
+
+    QModelIndexList persistentIndices = persistentIndexList();
+    QStringList localUidsToUpdate;
+    localUidsToUpdate.reserve(persistentIndices.size());
+    const NoteDataByIndex & constIndex = m_data.get<ByIndex>();
+    for(auto it = persistentIndices.constBegin(),
+        end = persistentIndices.constEnd(); it != end; ++it)
+    {
+        const QModelIndex & index = *it;
+        int row = index.row();
+        if (!index.isValid() || (row < 0) ||
+            (row >= static_cast<int>(constIndex.size())))
+        {
+            localUidsToUpdate << QString();
+            continue;
+        }
+
+        localUidsToUpdate << constIndex[static_cast<size_t>(row)].localUid();
+    }
+
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+    std::vector<boost::reference_wrapper<const NoteModelItem> > items(
+        index.begin(), index.end());
+
+    // NOTE: the comparator for the opposite order is the exact inverse of
+    // the current one so when only the order has changed the reversal of
+    // the already sorted items is enough; otherwise the items are sorted
+    // stably so that the notes equal by the new sorting column keep their
+    // relative order
+    if (orderReversed) {
+        std::reverse(items.begin(), items.end());
+    }
+    else {
+        std::stable_sort(items.begin(), items.end(),
+                         NoteComparator(sortingColumn(), sortOrder(),
+                                        m_notebookDataByNotebookLocalUid));
+    }
+
+    index.rearrange(items.begin());
+
+    QModelIndexList replacementIndices;
+    replacementIndices.reserve(persistentIndices.size());
+    for(int i = 0, size = persistentIndices.size(); i < size; ++i)
+    {
+        const QString & localUid = localUidsToUpdate[i];
+        if (localUid.isEmpty()) {
+            replacementIndices << QModelIndex();
+            continue;
+        }
+
+        QModelIndex newIndex = indexForLocalUid(localUid);
+        if (newIndex.isValid()) {
+            newIndex = createIndex(newIndex.row(), persistentIndices[i].column());
+        }
+
+        replacementIndices << newIndex;
+    }
+
+    changePersistentIndexList(persistentIndices, replacementIndices);
+
+    Q_EMIT layoutChanged();
+
+    if (m_windowedMode && (m_lastVisibleRow >= 0)) {
+        evictItemsOutsideOfWindow();
+        int margin = windowMargin();
+        rehydrateEvictedItems(m_firstVisibleRow - margin,
+                              m_lastVisibleRow + margin);
+    }
+}
+
+void NoteModel::reconcileLoadedItemsWithSorting()
+{
+    NMDEBUG("NoteModel::reconcileLoadedItemsWithSorting");
+
+    // Any pending listing refers to the previous sorting order
+    m_listNotesRequestId = QUuid();
+    m_reconcileSortingRequestId = QUuid();
+    m_reconcileSortingLimit = 0;
+
+    if (m_data.empty()) {
+        NMDEBUG("No notes are loaded yet, listing them from scratch");
+        m_listNotesOffset = 0;
+        requestNotesList();
+        return;
+    }
+
+    if ((m_totalFilteredNotesCount > 0) &&
+        (m_data.size() >= static_cast<size_t>(m_totalFilteredNotesCount)))
+    {
+        NMDEBUG("All notes are loaded, no reconciliation is required");
+        return;
+    }
+
+    // The loaded items were the first ones in the previous order, in the new
+    // order the same number of first notes needs to be listed to find out
+    // which of the loaded items are no longer within the loaded window
+    m_reconcileSortingLimit = m_data.size();
+    m_reconcileSortingRequestId = QUuid::createUuid();
+
+    NMDEBUG("Emitting the request to list notes in the new sorting order: "
+            << "limit = " << m_reconcileSortingLimit << ", request id = "
+            << m_reconcileSortingRequestId);
+
+    requestNotesListImpl(0, m_reconcileSortingLimit,
+                         m_reconcileSortingRequestId);
+}
+
+void NoteModel::onReconcileSortingComplete(
+    const QList<NoteModelItem> & summaries)
+{
+    NMDEBUG("NoteModel::onReconcileSortingComplete: num found notes = "
+            << summaries.size());
+
+    bool listedAllNotes =
+        (static_cast<size_t>(summaries.size()) < m_reconcileSortingLimit);
+
+    m_reconcileSortingRequestId = QUuid();
+    m_reconcileSortingLimit = 0;
+
+    if (!listedAllNotes)
+    {
+        QSet<QString> listedNoteLocalUids;
+        listedNoteLocalUids.reserve(summaries.size());
+        for(auto it = summaries.constBegin(),
+            end = summaries.constEnd(); it != end; ++it)
+        {
+            Q_UNUSED(listedNoteLocalUids.insert(it->localUid()))
+        }
+
+        // Removing the loaded items which don't fall into the loaded window
+        // in the new sorting order, contiguous rows are removed at once
+        NoteDataByIndex & index = m_data.get<ByIndex>();
+        int lastRow = static_cast<int>(index.size()) - 1;
+        for(int row = lastRow; row >= 0; --row)
+        {
+            const NoteModelItem & item = index[static_cast<size_t>(row)];
+            if (listedNoteLocalUids.contains(item.localUid())) {
+                continue;
+            }
+
+            int firstStaleRow = row;
+            while((firstStaleRow > 0) &&
+                  !listedNoteLocalUids.contains(
+                      index[static_cast<size_t>(firstStaleRow - 1)].localUid()))
+            {
+                --firstStaleRow;
+            }
+
+            for(int i = firstStaleRow; i <= row; ++i) {
+                cancelNotePreviewTextExtraction(
+                    index[static_cast<size_t>(i)].localUid());
+            }
+
+            beginRemoveRows(QModelIndex(), firstStaleRow, row);
+            Q_UNUSED(index.erase(index.begin() + firstStaleRow,
+                                 index.begin() + row + 1))
+            endRemoveRows();
+
+            row = firstStaleRow;
+        }
+
+        pruneInternedStrings();
+    }
+
+    m_listNotesOffset = 0;
+    onListNotesCompleteImpl(summaries);
+}
+
 int NoteModel::rowForNewItem(const NoteModelItem & item) const
 {
     const NoteDataByIndex & index = m_data.get<ByIndex>();
 
-    auto it = std::lower_bound(index.begin(), index.end(), item,
-                               NoteComparator(sortingColumn(), sortOrder()));
+    auto it = std::lower_bound(
+        index.begin(), index.end(), item,
+        NoteComparator(sortingColumn(), sortOrder(),
+                       m_notebookDataByNotebookLocalUid));
     if (it == index.end()) {
         return static_cast<int>(index.size());
     }
@@ -2574,56 +3612,60 @@ void NoteModel::processTagExpunging(const QString & tagLocalUid)
     }
 
     QString tagGuid = tagDataIt->m_guid;
-    QString tagName = tagDataIt->m_name;
 
     Q_UNUSED(m_tagDataByTagLocalUid.erase(tagDataIt))
 
-    auto noteIt = m_tagLocalUidToNoteLocalUid.find(tagLocalUid);
-    if (noteIt == m_tagLocalUidToNoteLocalUid.end()) {
+    auto postingIt = m_noteLocalUidsByTagLocalUid.find(tagLocalUid);
+    if (postingIt == m_noteLocalUidsByTagLocalUid.end()) {
         return;
     }
 
-    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    QSet<QString> affectedNoteLocalUids = postingIt.value();
+    Q_UNUSED(m_noteLocalUidsByTagLocalUid.erase(postingIt))
 
-    QStringList affectedNotesLocalUids;
-    while(noteIt != m_tagLocalUidToNoteLocalUid.end())
-    {
-        if (noteIt.key() != tagLocalUid) {
-            break;
-        }
+    NMTRACE("Number of affected notes: " << affectedNoteLocalUids.size());
 
-        affectedNotesLocalUids << noteIt.value();
-        ++noteIt;
-    }
-
-    Q_UNUSED(m_tagLocalUidToNoteLocalUid.remove(tagLocalUid))
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
 
-    NMTRACE("Affected notes local uids: "
-            << affectedNotesLocalUids.join(QStringLiteral(", ")));
-    for(auto it = affectedNotesLocalUids.constBegin(),
-        end = affectedNotesLocalUids.constEnd(); it != end; ++it)
+    int firstRow = -1;
+    int lastRow = -1;
+    for(auto it = affectedNoteLocalUids.constBegin(),
+        end = affectedNoteLocalUids.constEnd(); it != end; ++it)
     {
         auto noteItemIt = localUidIndex.find(*it);
-        if (Q_UNLIKELY(noteItemIt == localUidIndex.end())) {
-            NMDEBUG("Can't find the note pointed to by the expunged "
-                    << "tag by local uid: note local uid = " << noteIt.value());
+        if (noteItemIt == localUidIndex.end()) {
             continue;
         }
 
-        NoteModelItem item = *noteItemIt;
-        item.removeTagGuid(tagGuid);
-        item.removeTagName(tagName);
-        item.removeTagLocalUid(tagLocalUid);
+        if (!noteItemIt->hasTagLocalUid(tagLocalUid)) {
+            // Stale posting: the tag was removed from the note
+            continue;
+        }
 
-        Q_UNUSED(localUidIndex.replace(noteItemIt, item))
+        // NOTE: modifying the item in place rather than replacing it with
+        // a copy since none of the keys of the item changes here
+        Q_UNUSED(localUidIndex.modify(noteItemIt,
+            [&](NoteModelItem & item)
+            {
+                item.removeTagGuid(tagGuid);
+                item.removeTagLocalUid(tagLocalUid);
+            }))
 
-        QModelIndex modelIndex = indexForLocalUid(item.localUid());
-        modelIndex = createIndex(modelIndex.row(), Columns::TagNameList);
-        Q_EMIT dataChanged(modelIndex, modelIndex);
+        auto indexIt = m_data.project<ByIndex>(noteItemIt);
+        int row = static_cast<int>(std::distance(index.begin(), indexIt));
+        firstRow = ((firstRow < 0) ? row : std::min(firstRow, row));
+        lastRow = std::max(lastRow, row);
 
         // This note's cache entry is clearly stale now, need to ensure
         // it won't be present in the cache
-        Q_UNUSED(m_cache.remove(item.localUid()))
+        Q_UNUSED(m_cache.remove(*it))
+    }
+
+    if (firstRow >= 0) {
+        QModelIndex modelIndexFrom = createIndex(firstRow, Columns::TagNameList);
+        QModelIndex modelIndexTo = createIndex(lastRow, Columns::TagNameList);
+        Q_EMIT dataChanged(modelIndexFrom, modelIndexTo);
     }
 }
 
@@ -2631,6 +3673,8 @@ void NoteModel::removeItemByLocalUid(const QString & localUid)
 {
     NMDEBUG("NoteModel::removeItemByLocalUid: " << localUid);
 
+    cancelNotePreviewTextExtraction(localUid);
+
     NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
     auto itemIt = localUidIndex.find(localUid);
     if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
@@ -2659,6 +3703,46 @@ void NoteModel::removeItemByLocalUid(const QString & localUid)
     beginRemoveRows(QModelIndex(), row, row);
     Q_UNUSED(localUidIndex.erase(itemIt))
     endRemoveRows();
+
+    pruneInternedStrings();
+}
+
+void NoteModel::removeItemsByLocalUids(const QSet<QString> & localUids)
+{
+    NMDEBUG("NoteModel::removeItemsByLocalUids: num items = "
+            << localUids.size());
+
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+    int lastRow = static_cast<int>(index.size()) - 1;
+    for(int row = lastRow; row >= 0; --row)
+    {
+        const NoteModelItem & item = index[static_cast<size_t>(row)];
+        if (!localUids.contains(item.localUid())) {
+            continue;
+        }
+
+        int firstRemovedRow = row;
+        while((firstRemovedRow > 0) &&
+              localUids.contains(
+                  index[static_cast<size_t>(firstRemovedRow - 1)].localUid()))
+        {
+            --firstRemovedRow;
+        }
+
+        for(int i = firstRemovedRow; i <= row; ++i) {
+            cancelNotePreviewTextExtraction(
+                index[static_cast<size_t>(i)].localUid());
+        }
+
+        beginRemoveRows(QModelIndex(), firstRemovedRow, row);
+        Q_UNUSED(index.erase(index.begin() + firstRemovedRow,
+                             index.begin() + row + 1))
+        endRemoveRows();
+
+        row = firstRemovedRow;
+    }
+
+    pruneInternedStrings();
 }
 
 bool NoteModel::updateItemRowWithRespectToSorting(
@@ -2711,7 +3795,8 @@ bool NoteModel::updateItemRowWithRespectToSorting(
 
     auto positionIter =
         std::lower_bound(index.begin(), index.end(), itemCopy,
-                         NoteComparator(sortingColumn(), sortOrder()));
+                         NoteComparator(sortingColumn(), sortOrder(),
+                                        m_notebookDataByNotebookLocalUid));
     if (positionIter == index.end())
     {
         int newRow = static_cast<int>(index.size());
@@ -2750,6 +3835,8 @@ void NoteModel::saveNoteInLocalStorage(
         NMTRACE("Updating the note");
 
         const Note * pCachedNote = m_cache.get(item.localUid());
+        m_instrumentation.recordCacheLookup(QStringLiteral("Note"),
+                                             (pCachedNote != nullptr));
         if (Q_UNLIKELY(!pCachedNote))
         {
             QUuid requestId = QUuid::createUuid();
@@ -2760,6 +3847,8 @@ void NoteModel::saveNoteInLocalStorage(
                     << ", request id = " << requestId);
             LocalStorageManager::GetNoteOptions getNoteOptions(
                 LocalStorageManager::GetNoteOption::WithResourceMetadata);
+            m_instrumentation.recordRequestIssued(
+                QStringLiteral("findNote"), requestId);
             Q_EMIT findNote(dummy, getNoteOptions, requestId);
             return;
         }
@@ -2767,15 +3856,34 @@ void NoteModel::saveNoteInLocalStorage(
         note = *pCachedNote;
     }
 
+    if (item.isEvicted())
+    {
+        // The evicted item doesn't keep the guids and tags so the ones of
+        // the note from the cache or the local storage are kept
+        auto notebookIt =
+            m_notebookDataByNotebookLocalUid.find(item.notebookLocalUid());
+        if (notebookIt != m_notebookDataByNotebookLocalUid.end()) {
+            note.setNotebookGuid(notebookIt->m_guid);
+        }
+        else if (!note.hasNotebookLocalUid() ||
+                 (note.notebookLocalUid() != item.notebookLocalUid()))
+        {
+            note.setNotebookGuid(QString());
+        }
+    }
+    else
+    {
+        note.setGuid(item.guid());
+        note.setNotebookGuid(item.notebookGuid());
+        note.setTagLocalUids(item.tagLocalUids());
+        note.setTagGuids(item.tagGuids());
+    }
+
     note.setLocalUid(item.localUid());
-    note.setGuid(item.guid());
     note.setNotebookLocalUid(item.notebookLocalUid());
-    note.setNotebookGuid(item.notebookGuid());
     note.setCreationTimestamp(item.creationTimestamp());
     note.setModificationTimestamp(item.modificationTimestamp());
     note.setDeletionTimestamp(item.deletionTimestamp());
-    note.setTagLocalUids(item.tagLocalUids());
-    note.setTagGuids(item.tagGuids());
     note.setTitle(item.title());
     note.setLocal(!item.isSynchronizable());
     note.setDirty(item.isDirty());
@@ -2791,6 +3899,8 @@ void NoteModel::saveNoteInLocalStorage(
 
         NMTRACE("Emitting the request to add the note to local storage: id = "
                 << requestId << ", note: " << note);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("addNote"), requestId);
         Q_EMIT addNote(note, requestId);
     }
     else
@@ -2807,6 +3917,8 @@ void NoteModel::saveNoteInLocalStorage(
         if (saveTags) {
             options |= LocalStorageManager::UpdateNoteOption::UpdateTags;
         }
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("updateNote"), requestId);
         Q_EMIT updateNote(note, options, requestId);
     }
 }
@@ -2839,9 +3951,9 @@ QVariant NoteModel::dataImpl(const int row, const Columns::type column) const
             return thumbnail;
         }
     case Columns::NotebookName:
-        return item.notebookName();
+        return notebookNameForItem(item);
     case Columns::TagNameList:
-        return item.tagNameList();
+        return tagNamesForItem(item);
     case Columns::Size:
         return item.sizeInBytes();
     case Columns::Synchronizable:
@@ -2931,7 +4043,7 @@ QVariant NoteModel::dataAccessibleText(
         }
     case Columns::NotebookName:
         {
-            const QString & notebookName = item.notebookName();
+            QString notebookName = notebookNameForItem(item);
             if (notebookName.isEmpty()) {
                 accessibleText += tr("notebook name is not available");
             }
@@ -2942,7 +4054,7 @@ QVariant NoteModel::dataAccessibleText(
         }
     case Columns::TagNameList:
         {
-            const QStringList & tagNameList = item.tagNameList();
+            QStringList tagNameList = tagNamesForItem(item);
             if (tagNameList.isEmpty()) {
                 accessibleText += tr("tag list is empty");
             }
@@ -3172,7 +4284,14 @@ bool NoteModel::removeRowsImpl(int row, int count, ErrorString & errorDescriptio
 
     for(int i = 0; i < count; ++i)
     {
-        auto it = index.begin() + row;
+        auto it = index.begin() + row + i;
+        if (it->isEvicted()) {
+            errorDescription.setBase(QT_TR_NOOP("Can't remove the note which "
+                                                "is not fully loaded"));
+            NMDEBUG(errorDescription);
+            return false;
+        }
+
         if (!it->guid().isEmpty()) {
             errorDescription.setBase(QT_TR_NOOP("Can't remove the synchronizable "
                                                 "note"));
@@ -3202,10 +4321,13 @@ bool NoteModel::removeRowsImpl(int row, int count, ErrorString & errorDescriptio
         NMTRACE("Emitting the request to expunge the note from "
                 << "the local storage: request id = "
                 << requestId << ", note local uid: " << *it);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("expungeNote"), requestId);
         Q_EMIT expungeNote(note, requestId);
     }
 
     endRemoveRows();
+    pruneInternedStrings();
 
     return true;
 }
@@ -3265,51 +4387,241 @@ void NoteModel::updateNotebookData(const Notebook & notebook)
                                          : true);
     }
 
-    if (notebook.hasName()) {
-        notebookData.m_name = notebook.name();
+    bool nameChanged = false;
+    if (notebook.hasName()) {
+        nameChanged = (notebookData.m_name != notebook.name());
+        notebookData.m_name = notebook.name();
+    }
+
+    if (notebook.hasGuid()) {
+        notebookData.m_guid = notebook.guid();
+    }
+
+    NMTRACE("Collected notebook data from notebook with local uid "
+            << notebook.localUid() << ": guid = "
+            << notebookData.m_guid << "; name = "
+            << notebookData.m_name << ": can create notes = "
+            << (notebookData.m_canCreateNotes ? "true" : "false")
+            << ": can update notes = "
+            << (notebookData.m_canUpdateNotes ? "true" : "false"));
+
+    if (nameChanged)
+    {
+        const NoteDataByNotebookLocalUid & notebookLocalUidIndex =
+            m_data.get<ByNotebookLocalUid>();
+        NoteDataByIndex & index = m_data.get<ByIndex>();
+
+        QVector<int> rows;
+        auto range = notebookLocalUidIndex.equal_range(notebook.localUid());
+        for(auto it = range.first; it != range.second; ++it) {
+            auto indexIt = m_data.project<ByIndex>(it);
+            rows << static_cast<int>(std::distance(index.begin(), indexIt));
+        }
+
+        // NOTE: the items are modified after collecting the rows so that
+        // the index by notebook local uid is not traversed while its items
+        // change; none of the keys of the items changes here anyway
+        const QString & notebookName = notebookData.m_name;
+        for(auto it = rows.constBegin(), end = rows.constEnd(); it != end; ++it)
+        {
+            Q_UNUSED(index.modify(index.begin() + *it,
+                [&](NoteModelItem & item)
+                {
+                    item.setNotebookName(notebookName);
+                }))
+        }
+
+        emitDataChangedForRows(rows, Columns::NotebookName,
+                               Columns::NotebookName);
+    }
+
+    checkAddedNoteItemsPendingNotebookData(notebook.localUid());
+}
+
+bool NoteModel::setNoteFavorited(
+    const QString & noteLocalUid, const bool favorited,
+    ErrorString & errorDescription)
+{
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    auto it = localUidIndex.find(noteLocalUid);
+    if (Q_UNLIKELY(it == localUidIndex.end())) {
+        errorDescription.setBase(QT_TR_NOOP("internal error, the note to be "
+                                            "favorited/unfavorited was "
+                                            "not found within the model"));
+        NMWARNING(errorDescription);
+        return false;
+    }
+
+    const NoteModelItem & item = *it;
+
+    if (favorited == item.isFavorited()) {
+        NMDEBUG("Favorited flag's value hasn't changed");
+        return true;
+    }
+
+    NoteModelItem itemCopy(item);
+    itemCopy.setFavorited(favorited);
+
+    localUidIndex.replace(it, itemCopy);
+    saveNoteInLocalStorage(itemCopy);
+
+    return true;
+}
+
+bool NoteModel::setNotesFavorited(
+    const QStringList & noteLocalUids, const bool favorited,
+    ErrorString & errorDescription)
+{
+    QList<NoteModelItem> items;
+    if (!findNoteItemsToUpdate(noteLocalUids, items, errorDescription)) {
+        return false;
+    }
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    for(auto it = items.begin(), end = items.end(); it != end; ++it)
+    {
+        NoteModelItem & item = *it;
+        if (favorited == item.isFavorited()) {
+            continue;
+        }
+
+        // Favorited property is not represented as a column so no signals
+        // are emitted for the changed items
+        item.setFavorited(favorited);
+        localUidIndex.replace(localUidIndex.find(item.localUid()), item);
+        saveNoteInLocalStorage(item);
+    }
+
+    return true;
+}
+
+bool NoteModel::setNotesTagged(
+    const QStringList & noteLocalUids, const QString & tagLocalUid,
+    const bool tagged, ErrorString & errorDescription)
+{
+    if (Q_UNLIKELY(tagLocalUid.isEmpty())) {
+        errorDescription.setBase(QT_TR_NOOP("the local uid of the tag "
+                                            "is empty"));
+        return false;
+    }
+
+    QList<NoteModelItem> items;
+    if (!findNoteItemsToUpdate(noteLocalUids, items, errorDescription)) {
+        return false;
+    }
+
+    // The evicted items don't keep the tags so they can't be updated without
+    // the notes being loaded first
+    for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it)
+    {
+        if (it->isEvicted()) {
+            errorDescription.setBase(QT_TR_NOOP("Can't change the tags of "
+                                                "the note which is not fully "
+                                                "loaded"));
+            NMDEBUG(errorDescription << ", note local uid = "
+                    << it->localUid());
+            return false;
+        }
+    }
+
+    QString tagGuid;
+    auto tagDataIt = m_tagDataByTagLocalUid.constFind(tagLocalUid);
+    if (tagDataIt != m_tagDataByTagLocalUid.constEnd()) {
+        tagGuid = tagDataIt->m_guid;
+    }
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    for(auto it = items.begin(); it != items.end(); )
+    {
+        NoteModelItem & item = *it;
+        if (item.hasTagLocalUid(tagLocalUid) == tagged) {
+            it = items.erase(it);
+            continue;
+        }
+
+        if (tagged) {
+            item.addTagLocalUid(tagLocalUid);
+            if (!tagGuid.isEmpty()) {
+                item.addTagGuid(tagGuid);
+            }
+        }
+        else {
+            item.removeTagLocalUid(tagLocalUid);
+            if (!tagGuid.isEmpty()) {
+                item.removeTagGuid(tagGuid);
+            }
+        }
+
+        internItemStrings(item);
+
+        item.setDirty(true);
+        item.setModificationTimestamp(timestamp);
+        ++it;
     }
 
-    if (notebook.hasGuid()) {
-        notebookData.m_guid = notebook.guid();
+    if (items.isEmpty()) {
+        NMDEBUG("All notes already have the requested tag state, "
+                "nothing to do");
+        return true;
     }
 
-    NMTRACE("Collected notebook data from notebook with local uid "
-            << notebook.localUid() << ": guid = "
-            << notebookData.m_guid << "; name = "
-            << notebookData.m_name << ": can create notes = "
-            << (notebookData.m_canCreateNotes ? "true" : "false")
-            << ": can update notes = "
-            << (notebookData.m_canUpdateNotes ? "true" : "false"));
+    replaceNoteItems(items, Columns::ModificationTimestamp, Columns::Dirty);
 
-    checkAddedNoteItemsPendingNotebookData(notebook.localUid(), notebookData);
+    for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it)
+    {
+        if (tagged) {
+            // Keeps the per tag index up to date and requests the tag data
+            // if it is not known yet
+            findTagDataForItem(*it);
+        }
+
+        saveNoteInLocalStorage(*it, true);
+    }
+
+    return true;
 }
 
-bool NoteModel::setNoteFavorited(
-    const QString & noteLocalUid, const bool favorited,
-    ErrorString & errorDescription)
+bool NoteModel::findNoteItemsToUpdate(
+    const QStringList & noteLocalUids, QList<NoteModelItem> & items,
+    ErrorString & errorDescription) const
 {
-    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-    auto it = localUidIndex.find(noteLocalUid);
-    if (Q_UNLIKELY(it == localUidIndex.end())) {
-        errorDescription.setBase(QT_TR_NOOP("internal error, the note to be "
-                                            "favorited/unfavorited was "
-                                            "not found within the model"));
-        NMWARNING(errorDescription);
-        return false;
-    }
+    items.clear();
+    items.reserve(noteLocalUids.size());
 
-    const NoteModelItem & item = *it;
+    QSet<QString> processedNoteLocalUids;
+    processedNoteLocalUids.reserve(noteLocalUids.size());
 
-    if (favorited == item.isFavorited()) {
-        NMDEBUG("Favorited flag's value hasn't changed");
-        return true;
-    }
+    const NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    for(auto it = noteLocalUids.constBegin(),
+        end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        if (processedNoteLocalUids.contains(*it)) {
+            continue;
+        }
 
-    NoteModelItem itemCopy(item);
-    itemCopy.setFavorited(favorited);
+        Q_UNUSED(processedNoteLocalUids.insert(*it))
 
-    localUidIndex.replace(it, itemCopy);
-    saveNoteInLocalStorage(itemCopy);
+        auto itemIt = localUidIndex.find(*it);
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            errorDescription.setBase(QT_TR_NOOP("one of notes to be updated "
+                                                "was not found within the model"));
+            NMDEBUG(errorDescription << ", note local uid = " << *it);
+            items.clear();
+            return false;
+        }
+
+        if (!canUpdateNoteItem(*itemIt)) {
+            errorDescription.setBase(QT_TR_NOOP("one of notes cannot be "
+                                                "updated: notebook restrictions "
+                                                "apply"));
+            NMDEBUG(errorDescription << ", note local uid = " << *it);
+            items.clear();
+            return false;
+        }
+
+        items << *itemIt;
+    }
 
     return true;
 }
@@ -3425,9 +4737,13 @@ bool NoteModel::moveNoteToNotebookImpl(
         return false;
     }
 
+    // The notebook data is updated first so that the moved items get the name
+    // of the target notebook from it
+    updateNotebookData(notebook);
+
     item.setNotebookLocalUid(notebook.localUid());
-    item.setNotebookName(notebook.hasName() ? notebook.name() : QString());
     item.setNotebookGuid(notebook.hasGuid() ? notebook.guid() : QString());
+    internItemStrings(item);
 
     item.setDirty(true);
     item.setModificationTimestamp(QDateTime::currentMSecsSinceEpoch());
@@ -3448,6 +4764,111 @@ bool NoteModel::moveNoteToNotebookImpl(
     return true;
 }
 
+bool NoteModel::moveNotesToNotebookImpl(
+    const QStringList & noteLocalUids, const Notebook & notebook,
+    ErrorString & errorDescription)
+{
+    NMTRACE("NoteModel::moveNotesToNotebookImpl: notebook = " << notebook
+            << "\nNote local uids: " << noteLocalUids.join(QStringLiteral(", ")));
+
+    if (!notebook.canCreateNotes()) {
+        errorDescription.setBase(QT_TR_NOOP("the target notebook doesn't allow "
+                                            "to create notes in it"));
+        NMINFO(errorDescription << ", notebook: " << notebook);
+        return false;
+    }
+
+    QList<NoteModelItem> items;
+    if (!findNoteItemsToUpdate(noteLocalUids, items, errorDescription)) {
+        return false;
+    }
+
+    // The notebook data is updated first so that the moved items get the name
+    // of the target notebook from it
+    updateNotebookData(notebook);
+
+    QString notebookGuid = (notebook.hasGuid() ? notebook.guid() : QString());
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+
+    for(auto it = items.begin(); it != items.end(); )
+    {
+        NoteModelItem & item = *it;
+        if (item.notebookLocalUid() == notebook.localUid()) {
+            it = items.erase(it);
+            continue;
+        }
+
+        item.setNotebookLocalUid(notebook.localUid());
+        item.setNotebookGuid(notebookGuid);
+        internItemStrings(item);
+
+        item.setDirty(true);
+        item.setModificationTimestamp(timestamp);
+        ++it;
+    }
+
+    if (items.isEmpty()) {
+        NMDEBUG("All notes are already within the target notebook, "
+                "nothing to do");
+        return true;
+    }
+
+    replaceNoteItems(items, Columns::ModificationTimestamp, Columns::Dirty);
+
+    for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it) {
+        saveNoteInLocalStorage(*it);
+    }
+
+    return true;
+}
+
+void NoteModel::replaceNoteItems(
+    const QList<NoteModelItem> & items, const Columns::type firstColumn,
+    const Columns::type lastColumn)
+{
+    NMDEBUG("NoteModel::replaceNoteItems: num items = " << items.size());
+
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+
+    int firstRow = -1;
+    int lastRow = -1;
+
+    for(auto it = items.constBegin(), end = items.constEnd(); it != end; ++it)
+    {
+        auto itemIt = localUidIndex.find(it->localUid());
+        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
+            NMWARNING("Can't find the note item to replace: " << *it);
+            continue;
+        }
+
+        auto indexIt = m_data.project<ByIndex>(itemIt);
+        int row = static_cast<int>(std::distance(index.begin(), indexIt));
+        if ((firstRow < 0) || (row < firstRow)) {
+            firstRow = row;
+        }
+
+        if (row > lastRow) {
+            lastRow = row;
+        }
+
+        Q_UNUSED(localUidIndex.replace(itemIt, *it))
+    }
+
+    if (firstRow < 0) {
+        return;
+    }
+
+    QModelIndex topLeftChangedIndex = createIndex(firstRow, firstColumn);
+    QModelIndex bottomRightChangedIndex = createIndex(lastRow, lastColumn);
+    Q_EMIT dataChanged(topLeftChangedIndex, bottomRightChangedIndex);
+
+    Columns::type column = sortingColumn();
+    if ((column >= firstColumn) && (column <= lastColumn)) {
+        sortLoadedItems(false);
+    }
+}
+
 void NoteModel::addOrUpdateNoteItem(
     NoteModelItem & item, const NotebookData & notebookData,
     const bool fromNotesListing)
@@ -3458,10 +4879,21 @@ void NoteModel::addOrUpdateNoteItem(
             << notebookData.m_name << ", from notes listing = "
             << (fromNotesListing ? "true" : "false"));
 
-    item.setNotebookName(notebookData.m_name);
+    internItemStrings(item);
 
     NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
     auto it = localUidIndex.find(item.localUid());
+
+    // The update of the evicted item outside of the notes listing keeps it
+    // evicted: the note might lack tags and the item would be rehydrated
+    // from the listing once it gets close to the visible rows anyway
+    if ((it != localUidIndex.end()) && it->isEvicted() && !fromNotesListing) {
+        shrinkItemToPlaceholder(item);
+    }
+    else if (m_windowedMode) {
+        Q_UNUSED(m_hydratedNoteLocalUids.insert(item.localUid()))
+    }
+
     if (it == localUidIndex.end())
     {
         switch(m_includedNotes)
@@ -3492,7 +4924,7 @@ void NoteModel::addOrUpdateNoteItem(
 
         if (fromNotesListing)
         {
-            findTagNamesForItem(item);
+            findTagDataForItem(item);
 
             int row = static_cast<int>(localUidIndex.size());
             beginInsertRows(QModelIndex(), row, row);
@@ -3505,7 +4937,7 @@ void NoteModel::addOrUpdateNoteItem(
                           << errorDescription << "; item: " << item);
             }
 
-            checkMaxNoteCountAndRemoveLastNoteIfNeeded();
+            checkMaxNoteCountAndRemoveLastNotesIfNeeded();
             return;
         }
 
@@ -3513,7 +4945,8 @@ void NoteModel::addOrUpdateNoteItem(
 
         auto positionIter = std::lower_bound(
             index.begin(), index.end(), item,
-            NoteComparator(sortingColumn(), sortOrder()));
+            NoteComparator(sortingColumn(), sortOrder(),
+                           m_notebookDataByNotebookLocalUid));
 
         int newRow = static_cast<int>(std::distance(index.begin(), positionIter));
 
@@ -3529,8 +4962,8 @@ void NoteModel::addOrUpdateNoteItem(
         Q_UNUSED(index.insert(positionIter, item))
         endInsertRows();
 
-        checkMaxNoteCountAndRemoveLastNoteIfNeeded();
-        findTagNamesForItem(item);
+        checkMaxNoteCountAndRemoveLastNotesIfNeeded();
+        findTagDataForItem(item);
     }
     else
     {
@@ -3580,6 +5013,7 @@ void NoteModel::addOrUpdateNoteItem(
             beginRemoveRows(QModelIndex(), row, row);
             Q_UNUSED(localUidIndex.erase(it))
             endRemoveRows();
+            pruneInternedStrings();
         }
         else
         {
@@ -3594,60 +5028,178 @@ void NoteModel::addOrUpdateNoteItem(
                           << errorDescription << "; item: " << item);
             }
 
-            findTagNamesForItem(item);
+            findTagDataForItem(item);
         }
     }
 }
 
-void NoteModel::checkMaxNoteCountAndRemoveLastNoteIfNeeded()
+void NoteModel::addOrUpdateNoteItemsFromNotesListing(
+    QList<NoteModelItem> & items)
 {
-    QNDEBUG("NoteModel::checkMaxNoteCountAndRemoveLastNoteIfNeeded");
+    NMTRACE("NoteModel::addOrUpdateNoteItemsFromNotesListing: num items = "
+            << items.size());
 
     NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-    size_t indexSize = localUidIndex.size();
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+    NoteComparator comparator(sortingColumn(), sortOrder());
+
+    QVector<NoteModelItem> newItems;
+    newItems.reserve(items.size());
+
+    QSet<QString> newItemLocalUids;
+
+    for(auto it = items.begin(), end = items.end(); it != end; ++it)
+    {
+        NoteModelItem & item = *it;
+
+        auto notebookIt =
+            m_notebookDataByNotebookLocalUid.find(item.notebookLocalUid());
+        if (notebookIt == m_notebookDataByNotebookLocalUid.end()) {
+            // The item would be added once the notebook data is found
+            onNoteItemAddedOrUpdated(item, true);
+            continue;
+        }
+
+        if (localUidIndex.find(item.localUid()) != localUidIndex.end()) {
+            addOrUpdateNoteItem(item, notebookIt.value(), true);
+            continue;
+        }
+
+        bool deleted = (item.deletionTimestamp() >= 0);
+        if ((deleted && (m_includedNotes == IncludedNotes::NonDeleted)) ||
+            (!deleted && (m_includedNotes == IncludedNotes::Deleted)))
+        {
+            continue;
+        }
+
+        internItemStrings(item);
+        findTagDataForItem(item);
+
+        if (m_windowedMode) {
+            Q_UNUSED(m_hydratedNoteLocalUids.insert(item.localUid()))
+        }
+
+        if (newItemLocalUids.contains(item.localUid()))
+        {
+            // The batch contains several versions of the same note, the later
+            // one wins
+            for(auto newItemIt = newItems.begin(),
+                newItemsEnd = newItems.end(); newItemIt != newItemsEnd;
+                ++newItemIt)
+            {
+                if (newItemIt->localUid() == item.localUid()) {
+                    *newItemIt = item;
+                    break;
+                }
+            }
+
+            continue;
+        }
+
+        Q_UNUSED(newItemLocalUids.insert(item.localUid()))
+        newItems << item;
+    }
+
+    if (newItems.isEmpty()) {
+        return;
+    }
+
+    std::stable_sort(newItems.begin(), newItems.end(), comparator);
+
+    // Positions of new items among the existing items; as the new items are
+    // sorted, the positions are non-decreasing
+    QVector<int> positions;
+    positions.reserve(newItems.size());
+
+    auto searchBeginIt = index.begin();
+    for(int i = 0, size = newItems.size(); i < size; ++i)
+    {
+        auto positionIt = std::lower_bound(
+            searchBeginIt, index.end(), newItems[i], comparator);
+
+        int row = static_cast<int>(std::distance(index.begin(), positionIt));
+
+        // The row the item would occupy once all new items are inserted
+        if (row + i >= static_cast<int>(m_maxNoteCount)) {
+            NMDEBUG("Skip adding " << (size - i) << " notes which would "
+                    << "appear beyond the max note count " << m_maxNoteCount);
+            newItems.resize(i);
+            break;
+        }
+
+        positions << row;
+        searchBeginIt = positionIt;
+    }
+
+    // Inserting contiguous runs of new items sharing the same position starting
+    // from the last one so that the positions of preceding runs stay valid
+    int runEnd = newItems.size();
+    while(runEnd > 0)
+    {
+        int position = positions[runEnd - 1];
+        int runBegin = runEnd - 1;
+        while((runBegin > 0) && (positions[runBegin - 1] == position)) {
+            --runBegin;
+        }
+
+        NMTRACE("Inserting " << (runEnd - runBegin) << " new items at row "
+                << position);
+
+        beginInsertRows(QModelIndex(), position,
+                        position + (runEnd - runBegin) - 1);
+        index.insert(index.begin() + position,
+                     newItems.begin() + runBegin,
+                     newItems.begin() + runEnd);
+        endInsertRows();
+
+        runEnd = runBegin;
+    }
+
+    checkMaxNoteCountAndRemoveLastNotesIfNeeded();
+}
+
+void NoteModel::checkMaxNoteCountAndRemoveLastNotesIfNeeded()
+{
+    QNDEBUG("NoteModel::checkMaxNoteCountAndRemoveLastNotesIfNeeded");
+
+    NoteDataByIndex & index = m_data.get<ByIndex>();
+    size_t indexSize = index.size();
     if (indexSize <= m_maxNoteCount) {
         return;
     }
 
     QNDEBUG("Note model's size is outside the acceptable range, "
-            "removing the last row's note to keep the cache minimal");
+            "removing the last rows' notes to keep the cache minimal");
 
+    int firstRow = static_cast<int>(m_maxNoteCount);
     int lastRow = static_cast<int>(indexSize - 1);
-    NoteDataByIndex & index = m_data.get<ByIndex>();
-    auto indexIt = index.begin();
-    std::advance(indexIt, lastRow);
-    auto it = m_data.project<ByLocalUid>(indexIt);
-    if (Q_UNLIKELY(it == localUidIndex.end())) {
-        REPORT_ERROR(QT_TR_NOOP("Internal error: can't project "
-                                "the random access index iterator "
-                                "to the local uid index iterator "
-                                "in note model"));
-    }
-    else {
-        beginRemoveRows(QModelIndex(), lastRow, lastRow);
-        Q_UNUSED(localUidIndex.erase(it))
-        endRemoveRows();
-    }
+
+    beginRemoveRows(QModelIndex(), firstRow, lastRow);
+    Q_UNUSED(index.erase(index.begin() + firstRow, index.end()))
+    endRemoveRows();
+
+    pruneInternedStrings();
 }
 
 void NoteModel::checkAddedNoteItemsPendingNotebookData(
-    const QString & notebookLocalUid, const NotebookData & notebookData)
+    const QString & notebookLocalUid)
 {
-    auto it = m_noteItemsPendingNotebookDataUpdate.find(notebookLocalUid);
-    while(it != m_noteItemsPendingNotebookDataUpdate.end())
-    {
-        if (it.key() != notebookLocalUid) {
-            break;
-        }
-
-        addOrUpdateNoteItem(it.value(), notebookData, true);
-        Q_UNUSED(m_noteItemsPendingNotebookDataUpdate.erase(it++))
+    QList<NoteModelItem> items = m_noteItemsPendingNotebookDataUpdate.values(
+        notebookLocalUid);
+    if (items.isEmpty()) {
+        return;
     }
+
+    Q_UNUSED(m_noteItemsPendingNotebookDataUpdate.remove(notebookLocalUid))
+
+    // QMultiHash::values returns the most recently inserted items first
+    std::reverse(items.begin(), items.end());
+    addOrUpdateNoteItemsFromNotesListing(items);
 }
 
-void NoteModel::findTagNamesForItem(NoteModelItem & item)
+void NoteModel::findTagDataForItem(const NoteModelItem & item)
 {
-    NMTRACE("NoteModel::findTagNamesForItem: " << item);
+    NMTRACE("NoteModel::findTagDataForItem: " << item);
 
     const QStringList & tagLocalUids = item.tagLocalUids();
     for(auto it = tagLocalUids.constBegin(),
@@ -3655,25 +5207,9 @@ void NoteModel::findTagNamesForItem(NoteModelItem & item)
     {
         const QString & tagLocalUid = *it;
 
-        bool alreadyGotNoteLocalUidMapped = false;
-
-        auto tagToNoteIt = m_tagLocalUidToNoteLocalUid.find(tagLocalUid);
-        while(tagToNoteIt != m_tagLocalUidToNoteLocalUid.end())
-        {
-            if (tagToNoteIt.key() != tagLocalUid) {
-                break;
-            }
-
-            if (tagToNoteIt.value() == item.localUid()) {
-                alreadyGotNoteLocalUidMapped = true;
-                break;
-            }
-
-            ++tagToNoteIt;
-        }
-
-        if (!alreadyGotNoteLocalUidMapped) {
-            Q_UNUSED(m_tagLocalUidToNoteLocalUid.insert(tagLocalUid, item.localUid()))
+        QSet<QString> & noteLocalUids = m_noteLocalUidsByTagLocalUid[tagLocalUid];
+        if (!noteLocalUids.contains(item.localUid())) {
+            Q_UNUSED(noteLocalUids.insert(item.localUid()))
             NMDEBUG("Tag local uid " << tagLocalUid
                     << " points to note model item " << item.localUid()
                     << ", title = " << item.title());
@@ -3683,7 +5219,6 @@ void NoteModel::findTagNamesForItem(NoteModelItem & item)
         if (tagDataIt != m_tagDataByTagLocalUid.end()) {
             NMTRACE("Found tag data for tag local uid " << tagLocalUid
                     << ": tag name = " << tagDataIt->m_name);
-            item.addTagName(tagDataIt->m_name);
             continue;
         }
 
@@ -3706,6 +5241,8 @@ void NoteModel::findTagNamesForItem(NoteModelItem & item)
         tag.setLocalUid(tagLocalUid);
         NMDEBUG("Emitting the request to find tag: tag local uid = "
                 << tagLocalUid << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findTag"), requestId);
         Q_EMIT findTag(tag, requestId);
     }
 }
@@ -3718,6 +5255,7 @@ void NoteModel::updateTagData(const Tag & tag)
     bool hasGuid = tag.hasGuid();
 
     TagData & tagData = m_tagDataByTagLocalUid[tag.localUid()];
+    QString previousTagGuid = tagData.m_guid;
 
     if (hasName) {
         tagData.m_name = tag.name();
@@ -3733,78 +5271,73 @@ void NoteModel::updateTagData(const Tag & tag)
         tagData.m_guid.resize(0);
     }
 
-    auto noteIt = m_tagLocalUidToNoteLocalUid.find(tag.localUid());
-    if (noteIt == m_tagLocalUidToNoteLocalUid.end()) {
+    auto postingIt = m_noteLocalUidsByTagLocalUid.find(tag.localUid());
+    if (postingIt == m_noteLocalUidsByTagLocalUid.end()) {
         return;
     }
 
-    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    // NOTE: the items don't store tag names so unless the tag guid has
+    // changed the items don't need to be updated, only the views need to be
+    // notified about the rows displaying the tag names
+    bool guidChanged = (tagData.m_guid != previousTagGuid);
+    QString tagGuid = internedString(tagData.m_guid);
 
-    QStringList affectedNotesLocalUids;
-    while(noteIt != m_tagLocalUidToNoteLocalUid.end())
-    {
-        if (noteIt.key() != tag.localUid()) {
-            break;
-        }
+    const QSet<QString> & affectedNoteLocalUids = postingIt.value();
+    NMTRACE("Number of affected notes: " << affectedNoteLocalUids.size());
 
-        affectedNotesLocalUids << noteIt.value();
-        ++noteIt;
-    }
+    NoteDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    const NoteDataByIndex & index = m_data.get<ByIndex>();
 
-    NMTRACE("Affected notes local uids: "
-            << affectedNotesLocalUids.join(QStringLiteral(", ")));
-    for(auto it = affectedNotesLocalUids.constBegin(),
-        end = affectedNotesLocalUids.constEnd(); it != end; ++it)
+    int firstRow = -1;
+    int lastRow = -1;
+    for(auto it = affectedNoteLocalUids.constBegin(),
+        end = affectedNoteLocalUids.constEnd(); it != end; ++it)
     {
         auto noteItemIt = localUidIndex.find(*it);
-        if (Q_UNLIKELY(noteItemIt == localUidIndex.end())) {
-            NMDEBUG("Can't find the note pointed to by a tag by "
-                    << "local uid: note local uid = " << *it);
+        if (noteItemIt == localUidIndex.end()) {
             continue;
         }
 
-        NoteModelItem item = *noteItemIt;
-        QStringList tagLocalUids = item.tagLocalUids();
-
-        // Need to refresh all the tag names and guids because it is generally
-        // unknown which particular tag was updated
-        item.setTagNameList(QStringList());
-        item.setTagGuids(QStringList());
+        if (!noteItemIt->hasTagLocalUid(tag.localUid())) {
+            // Stale posting: the tag was removed from the note
+            continue;
+        }
 
-        for(auto tagLocalUidIt = tagLocalUids.begin(),
-            tagLocalUidEnd = tagLocalUids.end();
-            tagLocalUidIt != tagLocalUidEnd; ++tagLocalUidIt)
+        if (guidChanged)
         {
-            auto tagDataIt = m_tagDataByTagLocalUid.find(*tagLocalUidIt);
-            if (tagDataIt == m_tagDataByTagLocalUid.end()) {
-                NMTRACE("Still no tag data for tag with local uid "
-                        << *tagLocalUidIt);
-                continue;
-            }
-
-            const TagData & tagData = tagDataIt.value();
-
-            if (!tagData.m_name.isEmpty()) {
-                item.addTagName(tagData.m_name);
-            }
-
-            if (!tagData.m_guid.isEmpty()) {
-                item.addTagGuid(tagData.m_guid);
-            }
+            Q_UNUSED(localUidIndex.modify(noteItemIt,
+                [&](NoteModelItem & item)
+                {
+                    if (!previousTagGuid.isEmpty()) {
+                        item.removeTagGuid(previousTagGuid);
+                    }
+
+                    if (!tagGuid.isEmpty()) {
+                        item.addTagGuid(tagGuid);
+                    }
+                }))
         }
 
-        Q_UNUSED(localUidIndex.replace(noteItemIt, item))
+        auto indexIt = m_data.project<ByIndex>(noteItemIt);
+        int row = static_cast<int>(std::distance(index.begin(), indexIt));
+        firstRow = ((firstRow < 0) ? row : std::min(firstRow, row));
+        lastRow = std::max(lastRow, row);
+    }
 
-        QModelIndex modelIndex = indexForLocalUid(item.localUid());
-        modelIndex = createIndex(modelIndex.row(), Columns::TagNameList);
-        Q_EMIT dataChanged(modelIndex, modelIndex);
+    if (firstRow >= 0) {
+        QModelIndex modelIndexFrom = createIndex(firstRow, Columns::TagNameList);
+        QModelIndex modelIndexTo = createIndex(lastRow, Columns::TagNameList);
+        Q_EMIT dataChanged(modelIndexFrom, modelIndexTo);
     }
 }
 
 NoteModel::NoteFilters::NoteFilters() :
     m_filteredNotebookLocalUids(),
+    m_filteredNotebookLocalUidsSet(),
     m_filteredTagLocalUids(),
-    m_filteredNoteLocalUids()
+    m_filteredTagLocalUidsSet(),
+    m_filteredNoteLocalUids(),
+    m_filteredNoteLocalUidsList()
 {}
 
 bool NoteModel::NoteFilters::isEmpty() const
@@ -3814,6 +5347,37 @@ bool NoteModel::NoteFilters::isEmpty() const
            m_filteredNoteLocalUids.isEmpty();
 }
 
+bool NoteModel::NoteFilters::noteConforms(
+    const QString & noteLocalUid, const QString & notebookLocalUid,
+    const QStringList & tagLocalUids) const
+{
+    if (!m_filteredNoteLocalUids.isEmpty() &&
+        !m_filteredNoteLocalUids.contains(noteLocalUid))
+    {
+        return false;
+    }
+
+    if (!m_filteredNotebookLocalUidsSet.isEmpty() &&
+        !m_filteredNotebookLocalUidsSet.contains(notebookLocalUid))
+    {
+        return false;
+    }
+
+    if (m_filteredTagLocalUidsSet.isEmpty()) {
+        return true;
+    }
+
+    for(auto it = tagLocalUids.constBegin(),
+        end = tagLocalUids.constEnd(); it != end; ++it)
+    {
+        if (m_filteredTagLocalUidsSet.contains(*it)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 const QStringList & NoteModel::NoteFilters::filteredNotebookLocalUids() const
 {
     return m_filteredNotebookLocalUids;
@@ -3823,11 +5387,13 @@ void NoteModel::NoteFilters::setFilteredNotebookLocalUids(
     const QStringList & notebookLocalUids)
 {
     m_filteredNotebookLocalUids = notebookLocalUids;
+    m_filteredNotebookLocalUidsSet = QSet<QString>::fromList(notebookLocalUids);
 }
 
 void NoteModel::NoteFilters::clearFilteredNotebookLocalUids()
 {
     m_filteredNotebookLocalUids.clear();
+    m_filteredNotebookLocalUidsSet.clear();
 }
 
 const QStringList & NoteModel::NoteFilters::filteredTagLocalUids() const
@@ -3839,11 +5405,13 @@ void NoteModel::NoteFilters::setFilteredTagLocalUids(
     const QStringList & tagLocalUids)
 {
     m_filteredTagLocalUids = tagLocalUids;
+    m_filteredTagLocalUidsSet = QSet<QString>::fromList(tagLocalUids);
 }
 
 void NoteModel::NoteFilters::clearFilteredTagLocalUids()
 {
     m_filteredTagLocalUids.clear();
+    m_filteredTagLocalUidsSet.clear();
 }
 
 const QSet<QString> & NoteModel::NoteFilters::filteredNoteLocalUids() const
@@ -3851,6 +5419,11 @@ const QSet<QString> & NoteModel::NoteFilters::filteredNoteLocalUids() const
     return m_filteredNoteLocalUids;
 }
 
+const QStringList & NoteModel::NoteFilters::filteredNoteLocalUidsList() const
+{
+    return m_filteredNoteLocalUidsList;
+}
+
 bool NoteModel::NoteFilters::setFilteredNoteLocalUids(
     const QSet<QString> & noteLocalUids)
 {
@@ -3859,6 +5432,7 @@ bool NoteModel::NoteFilters::setFilteredNoteLocalUids(
     }
 
     m_filteredNoteLocalUids = noteLocalUids;
+    m_filteredNoteLocalUidsList = m_filteredNoteLocalUids.toList();
     return true;
 }
 
@@ -3871,6 +5445,7 @@ bool NoteModel::NoteFilters::setFilteredNoteLocalUids(
 void NoteModel::NoteFilters::clearFilteredNoteLocalUids()
 {
     m_filteredNoteLocalUids.clear();
+    m_filteredNoteLocalUidsList.clear();
 }
 
 bool NoteModel::NoteComparator::operator()(
@@ -3932,7 +5507,7 @@ bool NoteModel::NoteComparator::operator()(
     case Columns::NotebookName:
         {
             int compareResult =
-                lhs.notebookName().localeAwareCompare(rhs.notebookName());
+                notebookName(lhs).localeAwareCompare(notebookName(rhs));
             less = (compareResult < 0);
             greater = (compareResult > 0);
             break;
@@ -3968,4 +5543,16 @@ bool NoteModel::NoteComparator::operator()(
     }
 }
 
+QString NoteModel::NoteComparator::notebookName(
+    const NoteModelItem & item) const
+{
+    auto it = m_pNotebookDataByNotebookLocalUid->constFind(
+        item.notebookLocalUid());
+    if (it == m_pNotebookDataByNotebookLocalUid->constEnd()) {
+        return QString();
+    }
+
+    return it->m_name;
+}
+
 } // namespace quentier
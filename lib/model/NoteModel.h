@@ -22,6 +22,10 @@
 #include "NoteModelItem.h"
 #include "NoteCache.h"
 #include "NotebookCache.h"
+#include "ModelInstrumentation.h"
+#include "NoteIndexAsync.h"
+#include "NoteSummaryListerAsync.h"
+#include "NotePreviewTextExtractor.h"
 
 #include <lib/utility/IStartable.h>
 
@@ -30,7 +34,10 @@
 #include <quentier/utility/SuppressWarnings.h>
 
 #include <QAbstractItemModel>
+#include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QScopedPointer>
+#include <QVector>
 
 SAVE_WARNINGS
 GCC_SUPPRESS_WARNING(-Wdeprecated-declarations)
@@ -102,6 +109,15 @@ public:
 
         bool isEmpty() const;
 
+        /**
+         * @return                  True if the note with the given local uid,
+         *                          notebook local uid and tag local uids passes
+         *                          all the filters, false otherwise
+         */
+        bool noteConforms(
+            const QString & noteLocalUid, const QString & notebookLocalUid,
+            const QStringList & tagLocalUids) const;
+
         const QStringList & filteredNotebookLocalUids() const;
         void setFilteredNotebookLocalUids(const QStringList & notebookLocalUids);
         void clearFilteredNotebookLocalUids();
@@ -111,6 +127,15 @@ public:
         void clearFilteredTagLocalUids();
 
         const QSet<QString> & filteredNoteLocalUids() const;
+
+        /**
+         * @return                  The same local uids as
+         *                          filteredNoteLocalUids() but in the form
+         *                          of a list which stays the same until
+         *                          the filtered note local uids change
+         */
+        const QStringList & filteredNoteLocalUidsList() const;
+
         bool setFilteredNoteLocalUids(const QSet<QString> & noteLocalUids);
         bool setFilteredNoteLocalUids(const QStringList & noteLocalUids);
         void clearFilteredNoteLocalUids();
@@ -120,8 +145,11 @@ public:
 
     private:
         QStringList             m_filteredNotebookLocalUids;
+        QSet<QString>           m_filteredNotebookLocalUidsSet;
         QStringList             m_filteredTagLocalUids;
+        QSet<QString>           m_filteredTagLocalUidsSet;
         QSet<QString>           m_filteredNoteLocalUids;
+        QStringList             m_filteredNoteLocalUidsList;
     };
 
 
@@ -132,13 +160,19 @@ public:
         QObject * parent = nullptr,
         const IncludedNotes::type includedNotes = IncludedNotes::NonDeleted,
         const NoteSortingMode::type noteSortingMode = NoteSortingMode::ModifiedAscending,
-        NoteFilters * pFilters = nullptr);
+        NoteFilters * pFilters = nullptr,
+        NoteIndexAsync * pNoteIndex = nullptr);
 
     virtual ~NoteModel();
 
     const Account & account() const { return m_account; }
     void updateAccount(const Account & account);
 
+    const ModelInstrumentation & instrumentation() const
+    { return m_instrumentation; }
+
+    void resetInstrumentation() { m_instrumentation.reset(); }
+
     Columns::type sortingColumn() const;
     Qt::SortOrder sortOrder() const;
 
@@ -181,6 +215,45 @@ public:
      */
     qint32 totalAccountNotesCount() const;
 
+    /**
+     * @brief setViewportRowCount - lets the model know how many rows the view
+     * displaying it can show at once
+     *
+     * The model uses this number to size the batches of notes requested from
+     * the local storage on fetchMore: each batch covers one screen worth of
+     * rows ahead of what is already loaded or two screens when the view
+     * scrolls fast.
+     *
+     * @param rowCount              The number of rows fitting into the view's
+     *                              viewport
+     */
+    void setViewportRowCount(const int rowCount);
+
+    /**
+     * @brief setWindowedMode - switches the sliding window mode of the model
+     * on or off
+     *
+     * In the sliding window mode the model keeps full note items only for
+     * the band of rows around the visible row range reported via
+     * setVisibleRowRange. Items outside of this band are evicted: their
+     * preview text and thumbnail data are dropped while the data required for
+     * sorting is kept. Evicted items are re-requested from the local storage
+     * once they get back into the band. This way the memory occupied by
+     * the model doesn't grow with the number of loaded notes as fast as
+     * it would otherwise.
+     */
+    void setWindowedMode(const bool windowed);
+    bool isWindowedMode() const { return m_windowedMode; }
+
+    /**
+     * @brief setVisibleRowRange - lets the model know which rows are currently
+     * visible within the view; only used in the sliding window mode
+     *
+     * @param firstRow              The first visible row
+     * @param lastRow               The last visible row
+     */
+    void setVisibleRowRange(const int firstRow, const int lastRow);
+
 public:
     /**
      * @brief createNoteItem - attempts to create a new note within the notebook
@@ -289,6 +362,96 @@ public:
     bool unfavoriteNote(
         const QString & noteLocalUid, ErrorString & errorDescription);
 
+    /**
+     * @brief deleteNotes - attempts to mark the notes with the specified
+     * local uids as deleted
+     *
+     * Unlike calling deleteNote for each note, the model is updated once
+     * for all notes: if the model only includes non-deleted notes, the rows
+     * of deleted notes are removed right away, contiguous rows at once;
+     * otherwise a single dataChanged signal is emitted for all notes.
+     *
+     * The notes are checked before any of them is changed: if any of them
+     * is not contained within the model or cannot be updated, none of
+     * the notes are deleted.
+     *
+     * @param noteLocalUids         The local uids of notes to be marked
+     *                              as deleted
+     * @param errorDescription      Textual description of the error if
+     *                              the notes could not be marked as deleted
+     * @return                      True if the notes were deleted successfully,
+     *                              false otherwise
+     */
+    bool deleteNotes(
+        const QStringList & noteLocalUids, ErrorString & errorDescription);
+
+    /**
+     * @brief moveNotesToNotebook - attempts to move the notes to a different
+     * notebook
+     *
+     * Just like moveNoteToNotebook, the method only sends the requests to
+     * update the notes within the local storage but returns before their
+     * completion. The model is updated once for all notes.
+     *
+     * @param noteLocalUids         The local uids of notes to be moved to
+     *                              another notebook
+     * @param notebookName          The name of the notebook into which
+     *                              the notes need to be moved
+     * @param errorDescription      Textual description of the error if
+     *                              the notes could not be moved to
+     *                              the specified notebook
+     * @return                      True if the notes were moved to
+     *                              the specified notebook successfully,
+     *                              false otherwise
+     */
+    bool moveNotesToNotebook(
+        const QStringList & noteLocalUids, const QString & notebookName,
+        ErrorString & errorDescription);
+
+    /**
+     * @brief favoriteNotes - attempts to mark the notes with the specified
+     * local uids as favorited; see favoriteNote for details
+     */
+    bool favoriteNotes(
+        const QStringList & noteLocalUids, ErrorString & errorDescription);
+
+    /**
+     * @brief unfavoriteNotes - attempts to remove the favorited mark from
+     * the notes with the specified local uids; see unfavoriteNote for details
+     */
+    bool unfavoriteNotes(
+        const QStringList & noteLocalUids, ErrorString & errorDescription);
+
+    /**
+     * @brief tagNotes - attempts to add the tag with the specified local uid
+     * to the notes with the specified local uids
+     *
+     * Just like moveNotesToNotebook, the method only sends the requests to
+     * update the notes within the local storage but returns before their
+     * completion. The model is updated once for all notes. The notes which
+     * already have the tag are left intact.
+     *
+     * @param noteLocalUids         The local uids of notes to be tagged
+     * @param tagLocalUid           The local uid of the tag to be added
+     *                              to the notes
+     * @param errorDescription      Textual description of the error if
+     *                              the notes could not be tagged
+     * @return                      True if the notes were tagged successfully,
+     *                              false otherwise
+     */
+    bool tagNotes(
+        const QStringList & noteLocalUids, const QString & tagLocalUid,
+        ErrorString & errorDescription);
+
+    /**
+     * @brief untagNotes - attempts to remove the tag with the specified local
+     * uid from the notes with the specified local uids; see tagNotes
+     * for details
+     */
+    bool untagNotes(
+        const QStringList & noteLocalUids, const QString & tagLocalUid,
+        ErrorString & errorDescription);
+
 public:
     // QAbstractItemModel interface
     virtual Qt::ItemFlags flags(
@@ -381,32 +544,42 @@ Q_SIGNALS:
         Note note, LocalStorageManager::GetNoteOptions options,
         QUuid requestId);
 
-    void listNotes(
+    void listNoteSummaries(
         LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
         size_t limit, size_t offset,
         LocalStorageManager::ListNotesOrder order,
         LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QUuid requestId);
+        QUuid requestId);
 
-    void listNotesPerNotebooksAndTags(
+    void listNoteSummariesPerNotebooksAndTags(
         QStringList notebookLocalUids, QStringList tagLocalUids,
-        LocalStorageManager::GetNoteOptions options,
         LocalStorageManager::ListObjectsOptions flag,
         size_t limit, size_t offset,
         LocalStorageManager::ListNotesOrder order,
         LocalStorageManager::OrderDirection orderDirection,
         QUuid requestId);
 
-    void listNotesByLocalUids(
+    void listNoteSummariesByLocalUids(
         QStringList noteLocalUids,
-        LocalStorageManager::GetNoteOptions options,
         LocalStorageManager::ListObjectsOptions flag,
         size_t limit, size_t offset,
         LocalStorageManager::ListNotesOrder order,
         LocalStorageManager::OrderDirection orderDirection,
         QUuid requestId);
 
+    void listOrderedNoteSummariesByLocalUids(
+        QStringList noteLocalUids,
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListNotesOrder order, bool orderBySize,
+        LocalStorageManager::OrderDirection orderDirection,
+        QUuid requestId);
+
+    void listIndexedNoteSummaries(
+        NoteIndexQuery query,
+        LocalStorageManager::OrderDirection orderDirection,
+        size_t limit, size_t offset, QUuid requestId);
+
     void getNoteCount(
         LocalStorageManager::NoteCountOptions options, QUuid requestId);
 
@@ -444,60 +617,10 @@ private Q_SLOTS:
         Note note, LocalStorageManager::GetNoteOptions options,
         ErrorString errorDescription, QUuid requestId);
 
-    void onListNotesComplete(
-        LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, QList<Note> foundNotes,
-        QUuid requestId);
-
-    void onListNotesFailed(
-        LocalStorageManager::ListObjectsOptions flag,
-        LocalStorageManager::GetNoteOptions options,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QString linkedNotebookGuid, ErrorString errorDescription,
-        QUuid requestId);
-
-    void onListNotesPerNotebooksAndTagsComplete(
-        QStringList notebookLocalUids,
-        QStringList tagLocalUids,
-        LocalStorageManager::GetNoteOptions options,
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QList<Note> foundNotes, QUuid requestId);
+    void onListNoteSummariesComplete(
+        QList<NoteModelItem> summaries, QUuid requestId);
 
-    void onListNotesPerNotebooksAndTagsFailed(
-        QStringList notebookLocalUids,
-        QStringList tagLocalUids,
-        LocalStorageManager::GetNoteOptions options,
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        ErrorString errorDescription, QUuid requestId);
-
-    void onListNotesByLocalUidsComplete(
-        QStringList noteLocalUids,
-        LocalStorageManager::GetNoteOptions options,
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
-        QList<Note> foundNotes, QUuid requestId);
-
-    void onListNotesByLocalUidsFailed(
-        QStringList noteLocalUids,
-        LocalStorageManager::GetNoteOptions options,
-        LocalStorageManager::ListObjectsOptions flag,
-        size_t limit, size_t offset,
-        LocalStorageManager::ListNotesOrder order,
-        LocalStorageManager::OrderDirection orderDirection,
+    void onListNoteSummariesFailed(
         ErrorString errorDescription, QUuid requestId);
 
     void onGetNoteCountComplete(
@@ -543,6 +666,13 @@ private Q_SLOTS:
     void onExpungeTagComplete(
         Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId);
 
+    // Slots for the asynchronous extraction of notes preview texts
+    void extractPendingNotePreviewTexts();
+
+    void onNotePreviewTextsExtracted(
+        quint64 sequenceNumber, QStringList noteLocalUids,
+        QStringList previewTexts);
+
 private:
     void connectToLocalStorage();
     void disconnectFromLocalStorage();
@@ -550,21 +680,93 @@ private:
     void onNoteAddedOrUpdated(
         const Note & note, const bool fromNotesListing = false);
 
-    void noteToItem(const Note & note, NoteModelItem & item);
+    void onNoteItemAddedOrUpdated(
+        NoteModelItem & item, const bool fromNotesListing);
+
+    void noteToItem(
+        const Note & note, NoteModelItem & item,
+        const bool withPreviewText = true);
+
+    void scheduleNotePreviewTextExtraction(const Note & note);
+    void cancelNotePreviewTextExtraction(const QString & noteLocalUid);
+
+    // The items don't store notebook and tag names, these are looked up
+    // by local uids when the data is requested
+    QString notebookNameForItem(const NoteModelItem & item) const;
+    QStringList tagNamesForItem(const NoteModelItem & item) const;
+
+    // Makes the item share the strings with the same values with other items
+    void internItemStrings(NoteModelItem & item);
+    QString internedString(const QString & str);
+
+    // Drops the interned strings no longer used by any item, called after
+    // the removal of items
+    void pruneInternedStrings();
     bool noteConformsToFilter(const Note & note) const;
-    void onListNotesCompleteImpl(const QList<Note> foundNotes);
+
+    // Emits dataChanged signals for the given rows coalesced into contiguous
+    // ranges; the rows are sorted in the process
+    void emitDataChangedForRows(
+        QVector<int> & rows, const Columns::type firstColumn,
+        const Columns::type lastColumn);
+
+    void onListNotesCompleteImpl(const QList<NoteModelItem> & summaries);
+
+    void evictItemsOutsideOfWindow();
+    void removeExcessEvictedItems(const int lastWindowRow);
+    static void shrinkItemToPlaceholder(NoteModelItem & item);
+    void rehydrateEvictedItems(int firstRow, int lastRow);
+    void onRehydrateNotesComplete(const QList<NoteModelItem> & summaries);
+    int windowMargin() const;
 
     void requestNotesListAndCount();
     void requestNotesList();
+
+    void requestNotesListImpl(
+        const size_t offset, const size_t limit, const QUuid & requestId);
+
+    size_t listNotesQueryLimit() const;
+    size_t fetchMoreBatchSize();
     void requestNotesCount();
     void requestTotalNotesCountPerAccount();
     void requestTotalFilteredNotesCount();
 
+    /**
+     * @brief scheduleNoteCountsReconciliation - schedules the requests of both
+     * note counts from the local storage; the requests are sent no more often
+     * than once per NOTE_COUNT_RECONCILIATION_INTERVAL_MSEC
+     */
+    void scheduleNoteCountsReconciliation();
+
+    /**
+     * @brief notifyNoteCountsUpdated - emits noteCountPerAccountUpdated and
+     * filteredNotesCountUpdated signals for the counts changed since the last
+     * notification; the signals are emitted no more often than once per
+     * NOTE_COUNT_NOTIFICATION_INTERVAL_MSEC, the notifications in between are
+     * coalesced into a single one
+     */
+    void notifyNoteCountsUpdated();
+    void emitNoteCountsUpdated();
+
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
     void findNoteToRestoreFailedUpdate(const Note & note);
 
     void clearModel();
     void resetModel();
 
+    /**
+     * @brief sortLoadedItems - reorders the already loaded items according to
+     * the current sorting column and order without resetting the model
+     *
+     * @param orderReversed         True if only the sort order has changed
+     *                              so the loaded items just need to be reversed
+     */
+    void sortLoadedItems(const bool orderReversed);
+
+    void reconcileLoadedItemsWithSorting();
+    void onReconcileSortingComplete(const QList<NoteModelItem> & summaries);
+
     LocalStorageManager::NoteCountOptions noteCountOptions() const;
 
     /**
@@ -580,6 +782,12 @@ private:
 
     void removeItemByLocalUid(const QString & localUid);
 
+    /**
+     * @brief removeItemsByLocalUids - removes the items with the specified
+     * local uids from the model, contiguous rows are removed at once
+     */
+    void removeItemsByLocalUids(const QSet<QString> & localUids);
+
     bool updateItemRowWithRespectToSorting(
         const NoteModelItem & item, ErrorString & errorDescription);
 
@@ -602,6 +810,25 @@ private:
         const QString & noteLocalUid, const bool favorited,
         ErrorString & errorDescription);
 
+    bool setNotesFavorited(
+        const QStringList & noteLocalUids, const bool favorited,
+        ErrorString & errorDescription);
+
+    bool setNotesTagged(
+        const QStringList & noteLocalUids, const QString & tagLocalUid,
+        const bool tagged, ErrorString & errorDescription);
+
+    /**
+     * @brief findNoteItemsToUpdate - finds the items of notes to be updated
+     * by one of bulk operations
+     *
+     * @return                      False if any of the notes is not contained
+     *                              within the model or cannot be updated
+     */
+    bool findNoteItemsToUpdate(
+        const QStringList & noteLocalUids, QList<NoteModelItem> & items,
+        ErrorString & errorDescription) const;
+
     void setSortingColumnAndOrder(const int column, const Qt::SortOrder order);
     void setSortingOrder(const Qt::SortOrder order);
 
@@ -633,22 +860,6 @@ private:
     typedef NoteData::index<ByLocalUid>::type NoteDataByLocalUid;
     typedef NoteData::index<ByNotebookLocalUid>::type NoteDataByNotebookLocalUid;
 
-    class NoteComparator
-    {
-    public:
-        NoteComparator(const Columns::type column,
-                       const Qt::SortOrder sortOrder) :
-            m_sortedColumn(column),
-            m_sortOrder(sortOrder)
-        {}
-
-        bool operator()(const NoteModelItem & lhs, const NoteModelItem & rhs) const;
-
-    private:
-        Columns::type   m_sortedColumn;
-        Qt::SortOrder   m_sortOrder;
-    };
-
     struct NotebookData
     {
         NotebookData() :
@@ -670,6 +881,31 @@ private:
         QString m_guid;
     };
 
+    class NoteComparator
+    {
+    public:
+        NoteComparator(
+                const Columns::type column, const Qt::SortOrder sortOrder,
+                const QHash<QString, NotebookData> & notebookData) :
+            m_sortedColumn(column),
+            m_sortOrder(sortOrder),
+            m_pNotebookDataByNotebookLocalUid(&notebookData)
+        {}
+
+        bool operator()(const NoteModelItem & lhs, const NoteModelItem & rhs) const;
+
+    private:
+        QString notebookName(const NoteModelItem & item) const;
+
+    private:
+        Columns::type   m_sortedColumn;
+        Qt::SortOrder   m_sortOrder;
+
+        // NOTE: notebook names are looked up by notebook local uid the same
+        // way NoteModel::data() does it
+        const QHash<QString, NotebookData> * m_pNotebookDataByNotebookLocalUid;
+    };
+
     typedef boost::bimap<QString, QUuid> LocalUidToRequestIdBimap;
 
 private:
@@ -678,16 +914,38 @@ private:
         NoteDataByLocalUid::iterator it, const Notebook & notebook,
         ErrorString & errorDescription);
 
+    bool moveNotesToNotebookImpl(
+        const QStringList & noteLocalUids, const Notebook & notebook,
+        ErrorString & errorDescription);
+
+    /**
+     * @brief replaceNoteItems - replaces the items of several notes at once,
+     * emits a single dataChanged signal for all of them and re-sorts
+     * the items once if the sorting column is within the changed columns
+     */
+    void replaceNoteItems(
+        const QList<NoteModelItem> & items, const Columns::type firstColumn,
+        const Columns::type lastColumn);
+
     void addOrUpdateNoteItem(
         NoteModelItem & item, const NotebookData & notebookData,
         const bool fromNotesListing);
 
-    void checkMaxNoteCountAndRemoveLastNoteIfNeeded();
+    /**
+     * @brief addOrUpdateNoteItemsFromNotesListing - applies the batch of
+     * items coming from the notes listing to the model
+     *
+     * The new items are sorted once and merged into the model with a single
+     * rows insertion notification per contiguous run of new rows instead of
+     * being inserted and moved to their sorted position one by one.
+     */
+    void addOrUpdateNoteItemsFromNotesListing(QList<NoteModelItem> & items);
+
+    void checkMaxNoteCountAndRemoveLastNotesIfNeeded();
 
-    void checkAddedNoteItemsPendingNotebookData(
-        const QString & notebookLocalUid, const NotebookData & notebookData);
+    void checkAddedNoteItemsPendingNotebookData(const QString & notebookLocalUid);
 
-    void findTagNamesForItem(NoteModelItem & item);
+    void findTagDataForItem(const NoteModelItem & item);
 
     void updateTagData(const Tag & tag);
 
@@ -699,6 +957,16 @@ private:
     LocalStorageManagerAsync &  m_localStorageManagerAsync;
     bool                        m_connectedToLocalStorage;
 
+    // Lives in the local storage thread, lists notes in the form of
+    // note summaries
+    NoteSummaryListerAsync *    m_pNoteSummaryLister;
+
+    // Lives in the local storage thread, serves the listings of notes
+    // the local storage can't handle efficiently; might be shared with
+    // other models
+    NoteIndexAsync *            m_pNoteIndex;
+    bool                        m_ownsNoteIndex;
+
     bool                        m_isStarted;
 
     NoteData                    m_data;
@@ -706,6 +974,7 @@ private:
 
     NoteCache &                 m_cache;
     NotebookCache &             m_notebookCache;
+    ModelInstrumentation        m_instrumentation;
 
     QScopedPointer<NoteFilters> m_pFilters;
     QScopedPointer<NoteFilters> m_pUpdatedNoteFilters;
@@ -714,13 +983,60 @@ private:
     // Can be increased through calls to fetchMore()
     size_t                      m_maxNoteCount;
 
+    // Number of rows the view can display at once, used to size the batches
+    // of notes loaded on fetchMore
+    int                         m_viewportRowCount;
+
+    // Measures the time between consequent fetchMore calls to detect fast
+    // scrolling
+    QElapsedTimer               m_fetchMoreTimer;
+
+    // Set when fetchMore was called while the previous list notes request
+    // was still pending; such calls are coalesced into a single request
+    // sent once the pending one completes
+    bool                        m_pendingFetchMore;
+
+    // Sliding window mode data
+    bool                        m_windowedMode;
+    int                         m_firstVisibleRow;
+    int                         m_lastVisibleRow;
+    QSet<QString>               m_hydratedNoteLocalUids;
+    QSet<QString>               m_noteLocalUidsPendingRehydration;
+    QHash<QUuid, QStringList>   m_noteLocalUidsByRehydrateRequestId;
+
+    // Notes which preview texts are to be extracted in the thread pool
+    // on the next event loop iteration
+    QList<Note>                 m_notesPendingPreviewTextExtraction;
+
+    // Sequence number of the most recent preview text extraction batch
+    // for each note which preview text is being extracted; the results of
+    // batches with other sequence numbers are stale and get ignored
+    QHash<QString, quint64>     m_previewTextSequenceNumberByNoteLocalUid;
+    quint64                     m_lastPreviewTextSequenceNumber;
+
     size_t                      m_listNotesOffset;
     QUuid                       m_listNotesRequestId;
+
+    // The request to list the notes in the new order after the sorting
+    // change, the loaded items not listed by it are removed from the model
+    QUuid                       m_reconcileSortingRequestId;
+    size_t                      m_reconcileSortingLimit;
     QUuid                       m_getNoteCountRequestId;
 
     qint32                      m_totalAccountNotesCount;
     QUuid                       m_getFullNoteCountPerAccountRequestId;
 
+    // The note counts are maintained incrementally on note additions,
+    // updates and expunges; the changes the model cannot account for, like
+    // the updates of notes not loaded into the model, are reconciled with
+    // the local storage by the delayed count requests
+    QBasicTimer                 m_noteCountsReconciliationTimer;
+
+    QBasicTimer                 m_noteCountsNotificationTimer;
+    bool                        m_pendingNoteCountsNotification;
+    qint32                      m_lastNotifiedAccountNotesCount;
+    qint32                      m_lastNotifiedFilteredNotesCount;
+
     QHash<QString, NotebookData>    m_notebookDataByNotebookLocalUid;
     LocalUidToRequestIdBimap        m_findNotebookRequestForNotebookLocalUid;
 
@@ -737,11 +1053,23 @@ private:
     QMultiHash<QString, NoteModelItem>  m_noteItemsPendingNotebookDataUpdate;
 
     LocalUidToRequestIdBimap    m_noteLocalUidToFindNotebookRequestIdForMoveNoteToNotebookBimap;
+    QHash<QUuid, QStringList>   m_noteLocalUidsByFindNotebookRequestIdForMoveNotesToNotebook;
+
+    // Items of deleted notes removed from the model before the completion of
+    // the requests to update them in the local storage
+    QHash<QString, NoteModelItem>   m_deletedNoteItemsPendingUpdate;
 
     QHash<QString, TagData>     m_tagDataByTagLocalUid;
 
     LocalUidToRequestIdBimap        m_findTagRequestForTagLocalUid;
-    QMultiHash<QString, QString>    m_tagLocalUidToNoteLocalUid;
+
+    // Local uids of loaded notes per tag local uid; the entries are not removed
+    // when the tag is removed from the note so they need to be checked
+    // against the note items on use
+    QHash<QString, QSet<QString> >  m_noteLocalUidsByTagLocalUid;
+
+    // Notebook and tag local uids and guids shared by note items
+    QSet<QString>                   m_internedStrings;
 };
 
 } // namespace quentier
@@ -33,7 +33,6 @@ NoteModelItem::NoteModelItem() :
     m_notebookName(),
     m_tagLocalUids(),
     m_tagGuids(),
-    m_tagNameList(),
     m_creationTimestamp(-1),
     m_modificationTimestamp(-1),
     m_deletionTimestamp(-1),
@@ -47,7 +46,8 @@ NoteModelItem::NoteModelItem() :
     m_canUpdateContent(true),
     m_canEmail(true),
     m_canShare(true),
-    m_canSharePublicly(true)
+    m_canSharePublicly(true),
+    m_isEvicted(false)
 {}
 
 NoteModelItem::~NoteModelItem()
@@ -113,36 +113,6 @@ int NoteModelItem::numTagGuids() const
     return m_tagGuids.size();
 }
 
-void NoteModelItem::addTagName(const QString & tagName)
-{
-    int index = m_tagNameList.indexOf(tagName);
-    if (index >= 0) {
-        return;
-    }
-
-    m_tagNameList << tagName;
-}
-
-void NoteModelItem::removeTagName(const QString & tagName)
-{
-    int index = m_tagNameList.indexOf(tagName);
-    if (index < 0) {
-        return;
-    }
-
-    m_tagNameList.removeAt(index);
-}
-
-bool NoteModelItem::hasTagName(const QString & tagName) const
-{
-    return m_tagNameList.contains(tagName);
-}
-
-int NoteModelItem::numTagNames() const
-{
-    return m_tagNameList.size();
-}
-
 QTextStream & NoteModelItem::print(QTextStream & strm) const
 {
     strm << "NoteModelItem: local uid = " << m_localUid
@@ -158,8 +128,6 @@ QTextStream & NoteModelItem::print(QTextStream & strm) const
          << m_tagLocalUids.join(QStringLiteral(", "))
          << ", tag guids = "
          << m_tagGuids.join(QStringLiteral(", "))
-         << ", tag name list = "
-         << m_tagNameList.join(QStringLiteral(", "))
          << ", creation timestamp = " << m_creationTimestamp
          << " ("
          << printableDateTimeFromTimestamp(m_creationTimestamp)
@@ -189,7 +157,9 @@ QTextStream & NoteModelItem::print(QTextStream & strm) const
          << ", can share = "
          << (m_canShare ? "true" : "false")
          << ", can share publicly = "
-         << (m_canSharePublicly ? "true" : "false");
+         << (m_canSharePublicly ? "true" : "false")
+         << ", is evicted = "
+         << (m_isEvicted ? "true" : "false");
 
     return strm;
 }
@@ -23,6 +23,7 @@
 
 #include <QStringList>
 #include <QByteArray>
+#include <QMetaType>
 
 namespace quentier {
 
@@ -57,6 +58,8 @@ public:
     void setThumbnailData(const QByteArray & thumbnailData)
     { m_thumbnailData = thumbnailData; }
 
+    // NOTE: NoteModel fills the notebook name from its notebook data so that
+    // the name is shared by all items from the same notebook
     const QString & notebookName() const { return m_notebookName; }
     void setNotebookName(const QString & notebookName)
     { m_notebookName = notebookName; }
@@ -77,15 +80,6 @@ public:
     bool hasTagGuid(const QString & tagGuid) const;
     int numTagGuids() const;
 
-    const QStringList & tagNameList() const { return m_tagNameList; }
-    void setTagNameList(const QStringList & tagNameList)
-    { m_tagNameList = tagNameList; }
-
-    void addTagName(const QString & tagName);
-    void removeTagName(const QString & tagName);
-    bool hasTagName(const QString & tagName) const;
-    int numTagNames() const;
-
     qint64 creationTimestamp() const { return m_creationTimestamp; }
     void setCreationTimestamp(const qint64 creationTimestamp)
     { m_creationTimestamp = creationTimestamp; }
@@ -136,6 +130,15 @@ public:
     void setCanSharePublicly(const bool canSharePublicly)
     { m_canSharePublicly = canSharePublicly; }
 
+    /**
+     * Evicted item is a lightweight placeholder for a note far from the visible
+     * part of the note list: it keeps the local uid, the notebook local uid
+     * and the data required for sorting but not the guids, tags, preview text
+     * and thumbnail
+     */
+    bool isEvicted() const { return m_isEvicted; }
+    void setEvicted(const bool evicted) { m_isEvicted = evicted; }
+
     virtual QTextStream & print(QTextStream & strm) const override;
 
 private:
@@ -149,7 +152,6 @@ private:
     QString     m_notebookName;
     QStringList m_tagLocalUids;
     QStringList m_tagGuids;
-    QStringList m_tagNameList;
     qint64      m_creationTimestamp;
     qint64      m_modificationTimestamp;
     qint64      m_deletionTimestamp;
@@ -164,8 +166,11 @@ private:
     bool        m_canEmail;
     bool        m_canShare;
     bool        m_canSharePublicly;
+    bool        m_isEvicted;
 };
 
 } // namespace quentier
 
+Q_DECLARE_METATYPE(quentier::NoteModelItem)
+
 #endif // QUENTIER_LIB_MODEL_NOTE_MODEL_ITEM_H
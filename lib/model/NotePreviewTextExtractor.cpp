@@ -0,0 +1,56 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotePreviewTextExtractor.h"
+#include "NoteSummaryListerAsync.h"
+
+#include <quentier/logging/QuentierLogger.h>
+
+namespace quentier {
+
+NotePreviewTextExtractor::NotePreviewTextExtractor(
+        const QList<Note> & notes, const quint64 sequenceNumber,
+        QObject * parent) :
+    QObject(parent),
+    QRunnable(),
+    m_notes(notes),
+    m_sequenceNumber(sequenceNumber)
+{}
+
+void NotePreviewTextExtractor::run()
+{
+    QNTRACE("NotePreviewTextExtractor::run: sequence number = "
+            << m_sequenceNumber << ", num notes = " << m_notes.size());
+
+    QStringList noteLocalUids;
+    noteLocalUids.reserve(m_notes.size());
+
+    QStringList previewTexts;
+    previewTexts.reserve(m_notes.size());
+
+    for(auto it = m_notes.constBegin(), end = m_notes.constEnd(); it != end; ++it)
+    {
+        const Note & note = *it;
+        noteLocalUids << note.localUid();
+        previewTexts << NoteSummaryListerAsync::notePreviewText(note);
+    }
+
+    Q_EMIT previewTextsExtracted(m_sequenceNumber, noteLocalUids, previewTexts);
+}
+
+} // namespace quentier
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
+#define QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
+
+#include <quentier/types/Note.h>
+
+#include <QList>
+#include <QObject>
+#include <QRunnable>
+#include <QStringList>
+
+namespace quentier {
+
+/**
+ * @brief The NotePreviewTextExtractor class converts the ENML content of
+ * a batch of notes into preview texts within a thread pool thread
+ *
+ * Each extractor carries the sequence number assigned to its batch by
+ * the model so that the model can tell the results of a stale batch from
+ * the results of the most recent one for any particular note.
+ */
+class NotePreviewTextExtractor: public QObject,
+                                public QRunnable
+{
+    Q_OBJECT
+public:
+    explicit NotePreviewTextExtractor(
+        const QList<Note> & notes, const quint64 sequenceNumber,
+        QObject * parent = nullptr);
+
+Q_SIGNALS:
+    void previewTextsExtracted(
+        quint64 sequenceNumber, QStringList noteLocalUids,
+        QStringList previewTexts);
+
+private:
+    virtual void run() override;
+
+private:
+    QList<Note>     m_notes;
+    quint64         m_sequenceNumber;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTE_PREVIEW_TEXT_EXTRACTOR_H
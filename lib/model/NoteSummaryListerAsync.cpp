@@ -0,0 +1,354 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NoteSummaryListerAsync.h"
+
+#include <quentier/local_storage/LocalStorageManager.h>
+#include <quentier/logging/QuentierLogger.h>
+
+#include <algorithm>
+
+#define NOTE_PREVIEW_TEXT_SIZE (500)
+
+namespace quentier {
+
+NoteSummaryListerAsync::NoteSummaryListerAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync)
+{
+    qRegisterMetaType<QList<NoteModelItem> >("QList<NoteModelItem>");
+}
+
+NoteSummaryListerAsync::~NoteSummaryListerAsync()
+{}
+
+void NoteSummaryListerAsync::noteToSummary(
+    const Note & note, NoteModelItem & summary, const bool withPreviewText)
+{
+    summary.setLocalUid(note.localUid());
+
+    if (note.hasGuid()) {
+        summary.setGuid(note.guid());
+    }
+
+    if (note.hasNotebookGuid()) {
+        summary.setNotebookGuid(note.notebookGuid());
+    }
+
+    if (note.hasNotebookLocalUid()) {
+        summary.setNotebookLocalUid(note.notebookLocalUid());
+    }
+
+    if (note.hasTitle()) {
+        summary.setTitle(note.title());
+    }
+
+    if (withPreviewText && note.hasContent()) {
+        summary.setPreviewText(notePreviewText(note));
+    }
+
+    summary.setThumbnailData(note.thumbnailData());
+
+    if (note.hasTagLocalUids()) {
+        summary.setTagLocalUids(note.tagLocalUids());
+    }
+
+    if (note.hasTagGuids()) {
+        summary.setTagGuids(note.tagGuids());
+    }
+
+    if (note.hasCreationTimestamp()) {
+        summary.setCreationTimestamp(note.creationTimestamp());
+    }
+
+    if (note.hasModificationTimestamp()) {
+        summary.setModificationTimestamp(note.modificationTimestamp());
+    }
+
+    if (note.hasDeletionTimestamp()) {
+        summary.setDeletionTimestamp(note.deletionTimestamp());
+    }
+
+    summary.setSynchronizable(!note.isLocal());
+    summary.setDirty(note.isDirty());
+    summary.setFavorited(note.isFavorited());
+    summary.setActive(note.hasActive() ? note.active() : true);
+    summary.setHasResources(note.hasResources() && (note.numResources() > 0));
+
+    if (note.hasNoteRestrictions())
+    {
+        const qevercloud::NoteRestrictions & restrictions = note.noteRestrictions();
+        summary.setCanUpdateTitle(!restrictions.noUpdateTitle.isSet() ||
+                                  !restrictions.noUpdateTitle.ref());
+        summary.setCanUpdateContent(!restrictions.noUpdateContent.isSet() ||
+                                    !restrictions.noUpdateContent.ref());
+        summary.setCanEmail(!restrictions.noEmail.isSet() ||
+                            !restrictions.noEmail.ref());
+        summary.setCanShare(!restrictions.noShare.isSet() ||
+                            !restrictions.noShare.ref());
+        summary.setCanSharePublicly(!restrictions.noSharePublicly.isSet() ||
+                                    !restrictions.noSharePublicly.ref());
+    }
+    else
+    {
+        summary.setCanUpdateTitle(true);
+        summary.setCanUpdateContent(true);
+        summary.setCanEmail(true);
+        summary.setCanShare(true);
+        summary.setCanSharePublicly(true);
+    }
+
+    qint64 sizeInBytes = 0;
+    if (note.hasContent()) {
+        sizeInBytes += note.content().size();
+    }
+
+    // NOTE: the size is computed from the resource metadata rather than from
+    // the resource binary data so that it is the same for the notes listed
+    // without the binary data and for the notes coming with it
+    if (note.hasResources())
+    {
+        QList<Resource> resources = note.resources();
+        for(auto it = resources.constBegin(),
+            end = resources.constEnd(); it != end; ++it)
+        {
+            const Resource & resource = *it;
+
+            if (resource.hasDataSize()) {
+                sizeInBytes += resource.dataSize();
+            }
+            else if (resource.hasDataBody()) {
+                sizeInBytes += resource.dataBody().size();
+            }
+        }
+    }
+
+    sizeInBytes = std::max(qint64(0), sizeInBytes);
+    summary.setSizeInBytes(static_cast<quint64>(sizeInBytes));
+}
+
+QString NoteSummaryListerAsync::notePreviewText(const Note & note)
+{
+    if (!note.hasContent()) {
+        return QString();
+    }
+
+    QString previewText = note.plainText();
+    previewText.truncate(NOTE_PREVIEW_TEXT_SIZE);
+    return previewText;
+}
+
+LocalStorageManager::GetNoteOptions
+NoteSummaryListerAsync::noteSummaryOptions()
+{
+    // Resource metadata is required for the note size and for the flag
+    // telling whether the note has resources; the binary data is never needed
+    return LocalStorageManager::GetNoteOptions(
+        LocalStorageManager::GetNoteOption::WithResourceMetadata);
+}
+
+QList<NoteModelItem> NoteSummaryListerAsync::listNoteSummariesPage(
+    LocalStorageManager & localStorageManager,
+    const QStringList & pageNoteLocalUids,
+    const LocalStorageManager::ListObjectsOptions flag,
+    ErrorString & errorDescription)
+{
+    if (pageNoteLocalUids.isEmpty()) {
+        return QList<NoteModelItem>();
+    }
+
+    QList<Note> notes = localStorageManager.listNotesByLocalUids(
+        pageNoteLocalUids, noteSummaryOptions(),
+        errorDescription, flag, 0, 0,
+        LocalStorageManager::ListNotesOrder::NoOrder,
+        LocalStorageManager::OrderDirection::Ascending);
+    if (notes.isEmpty()) {
+        return QList<NoteModelItem>();
+    }
+
+    // Restoring the order of notes within the page
+    QHash<QString, int> positionByNoteLocalUid;
+    positionByNoteLocalUid.reserve(pageNoteLocalUids.size());
+    for(int i = 0, size = pageNoteLocalUids.size(); i < size; ++i) {
+        positionByNoteLocalUid[pageNoteLocalUids[i]] = i;
+    }
+
+    QVector<Note> orderedNotes(pageNoteLocalUids.size());
+    QVector<bool> foundNotes(pageNoteLocalUids.size(), false);
+    for(auto it = notes.constBegin(), end = notes.constEnd(); it != end; ++it)
+    {
+        auto positionIt = positionByNoteLocalUid.find(it->localUid());
+        if (positionIt == positionByNoteLocalUid.end()) {
+            continue;
+        }
+
+        orderedNotes[positionIt.value()] = *it;
+        foundNotes[positionIt.value()] = true;
+    }
+
+    notes.clear();
+    for(int i = 0, size = orderedNotes.size(); i < size; ++i)
+    {
+        if (foundNotes[i]) {
+            notes << orderedNotes[i];
+        }
+    }
+
+    return notesToSummaries(notes);
+}
+
+QList<NoteModelItem> NoteSummaryListerAsync::notesToSummaries(
+    const QList<Note> & notes)
+{
+    QList<NoteModelItem> summaries;
+    summaries.reserve(notes.size());
+
+    for(auto it = notes.constBegin(), end = notes.constEnd(); it != end; ++it)
+    {
+        NoteModelItem summary;
+        noteToSummary(*it, summary);
+        summaries << summary;
+    }
+
+    return summaries;
+}
+
+void NoteSummaryListerAsync::onListNoteSummariesRequest(
+    LocalStorageManager::ListObjectsOptions flag,
+    size_t limit, size_t offset,
+    LocalStorageManager::ListNotesOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QUuid requestId)
+{
+    QNDEBUG("NoteSummaryListerAsync::onListNoteSummariesRequest: flag = "
+            << flag << ", limit = " << limit << ", offset = " << offset
+            << ", order = " << order << ", direction = " << orderDirection
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Note> notes = pLocalStorageManager->listNotes(
+        flag, noteSummaryOptions(), errorDescription,
+        limit, offset, order, orderDirection, QString());
+    processFoundNotes(notes, errorDescription, requestId);
+}
+
+void NoteSummaryListerAsync::onListNoteSummariesPerNotebooksAndTagsRequest(
+    QStringList notebookLocalUids, QStringList tagLocalUids,
+    LocalStorageManager::ListObjectsOptions flag,
+    size_t limit, size_t offset,
+    LocalStorageManager::ListNotesOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QUuid requestId)
+{
+    QNDEBUG("NoteSummaryListerAsync::"
+            << "onListNoteSummariesPerNotebooksAndTagsRequest: flag = "
+            << flag << ", limit = " << limit << ", offset = " << offset
+            << ", order = " << order << ", direction = " << orderDirection
+            << ", notebook local uids: "
+            << notebookLocalUids.join(QStringLiteral(", "))
+            << ", tag local uids: "
+            << tagLocalUids.join(QStringLiteral(", "))
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Note> notes = pLocalStorageManager->listNotesPerNotebooksAndTags(
+        notebookLocalUids, tagLocalUids,
+        noteSummaryOptions(), errorDescription,
+        flag, limit, offset, order, orderDirection);
+    processFoundNotes(notes, errorDescription, requestId);
+}
+
+void NoteSummaryListerAsync::onListNoteSummariesByLocalUidsRequest(
+    QStringList noteLocalUids,
+    LocalStorageManager::ListObjectsOptions flag,
+    size_t limit, size_t offset,
+    LocalStorageManager::ListNotesOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QUuid requestId)
+{
+    QNDEBUG("NoteSummaryListerAsync::onListNoteSummariesByLocalUidsRequest: "
+            << "flag = " << flag << ", limit = " << limit
+            << ", offset = " << offset << ", order = " << order
+            << ", direction = " << orderDirection
+            << ", note local uids: "
+            << noteLocalUids.join(QStringLiteral(", "))
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<Note> notes = pLocalStorageManager->listNotesByLocalUids(
+        noteLocalUids, noteSummaryOptions(),
+        errorDescription, flag, limit, offset, order, orderDirection);
+    processFoundNotes(notes, errorDescription, requestId);
+}
+
+LocalStorageManager * NoteSummaryListerAsync::localStorageManager(
+    ErrorString & errorDescription)
+{
+    LocalStorageManager * pLocalStorageManager =
+        m_localStorageManagerAsync.localStorageManager();
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        errorDescription.setBase(QT_TR_NOOP("Can't list notes: local storage "
+                                            "is not initialized yet"));
+        QNWARNING(errorDescription);
+    }
+
+    return pLocalStorageManager;
+}
+
+void NoteSummaryListerAsync::processFoundNotes(
+    const QList<Note> & notes, const ErrorString & errorDescription,
+    const QUuid & requestId)
+{
+    if (notes.isEmpty() && !errorDescription.isEmpty()) {
+        QNWARNING("Failed to list notes: " << errorDescription
+                  << ", request id = " << requestId);
+        Q_EMIT listNoteSummariesFailed(errorDescription, requestId);
+        return;
+    }
+
+    QList<NoteModelItem> summaries = notesToSummaries(notes);
+
+    QNTRACE("Listed " << summaries.size() << " note summaries, request id = "
+            << requestId);
+    Q_EMIT listNoteSummariesComplete(summaries, requestId);
+}
+
+} // namespace quentier
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTE_SUMMARY_LISTER_ASYNC_H
+#define QUENTIER_LIB_MODEL_NOTE_SUMMARY_LISTER_ASYNC_H
+
+#include "NoteModelItem.h"
+
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/types/Note.h>
+
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The NoteSummaryListerAsync class lists notes from the local storage
+ * in the form of note summaries: note model items containing only the data
+ * required to display notes in lists plus precomputed preview text
+ *
+ * The object is meant to live in the same thread as LocalStorageManagerAsync:
+ * it uses the LocalStorageManager owned by the latter directly so that
+ * the full notes with their ENML content never leave the local storage thread
+ * and the conversion of ENML into the preview text doesn't happen
+ * in the GUI thread.
+ *
+ * The lister keeps no state between requests; the listings which need
+ * the index of all notes are served by NoteIndexAsync.
+ */
+class NoteSummaryListerAsync: public QObject
+{
+    Q_OBJECT
+public:
+    explicit NoteSummaryListerAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        QObject * parent = nullptr);
+
+    virtual ~NoteSummaryListerAsync();
+
+    /**
+     * @brief noteToSummary - fills the note model item with the data from
+     * the note except for notebook name and tag names which only the model
+     * can provide
+     *
+     * @param note                  The note to fill the summary from
+     * @param summary               The note model item to be filled
+     * @param withPreviewText       If false, the preview text is not computed
+     *                              and the summary's preview text is left
+     *                              intact
+     *
+     * The note size is the size of the note's content plus the data sizes
+     * of its resources taken from the resource metadata.
+     */
+    static void noteToSummary(
+        const Note & note, NoteModelItem & summary,
+        const bool withPreviewText = true);
+
+    /**
+     * @return                      The preview text for the note: the beginning
+     *                              of the plain text converted from the note's
+     *                              ENML content
+     */
+    static QString notePreviewText(const Note & note);
+
+    /**
+     * @return                      The options for listing notes from the local
+     *                              storage with all the data note summaries
+     *                              need
+     */
+    static LocalStorageManager::GetNoteOptions noteSummaryOptions();
+
+    /**
+     * @brief listNoteSummariesPage - lists the summaries of notes with
+     * the given local uids in the order of the local uids
+     *
+     * @param localStorageManager   The local storage manager to list notes
+     *                              from; must be used from the local storage
+     *                              thread
+     * @param pageNoteLocalUids     Local uids of notes to be listed
+     * @param flag                  The flag for listing notes; the notes not
+     *                              matching it are left out
+     * @param errorDescription      The textual description of the error if
+     *                              the notes could not be listed
+     * @return                      The summaries of the found notes; empty list
+     *                              with non-empty error description in case
+     *                              of error
+     */
+    static QList<NoteModelItem> listNoteSummariesPage(
+        LocalStorageManager & localStorageManager,
+        const QStringList & pageNoteLocalUids,
+        const LocalStorageManager::ListObjectsOptions flag,
+        ErrorString & errorDescription);
+
+    static QList<NoteModelItem> notesToSummaries(const QList<Note> & notes);
+
+Q_SIGNALS:
+    void listNoteSummariesComplete(
+        QList<NoteModelItem> summaries, QUuid requestId);
+
+    void listNoteSummariesFailed(ErrorString errorDescription, QUuid requestId);
+
+public Q_SLOTS:
+    void onListNoteSummariesRequest(
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListNotesOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QUuid requestId);
+
+    void onListNoteSummariesPerNotebooksAndTagsRequest(
+        QStringList notebookLocalUids, QStringList tagLocalUids,
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListNotesOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QUuid requestId);
+
+    void onListNoteSummariesByLocalUidsRequest(
+        QStringList noteLocalUids,
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListNotesOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QUuid requestId);
+
+private:
+    LocalStorageManager * localStorageManager(ErrorString & errorDescription);
+
+    void processFoundNotes(
+        const QList<Note> & notes, const ErrorString & errorDescription,
+        const QUuid & requestId);
+
+private:
+    Q_DISABLE_COPY(NoteSummaryListerAsync)
+
+private:
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTE_SUMMARY_LISTER_ASYNC_H
@@ -19,12 +19,33 @@
 #ifndef QUENTIER_LIB_MODEL_NOTEBOOK_CACHE_H
 #define QUENTIER_LIB_MODEL_NOTEBOOK_CACHE_H
 
-#include <quentier/utility/LRUCache.hpp>
+#include "ItemCache.hpp"
+
 #include <quentier/types/Notebook.h>
 
 namespace quentier {
 
-typedef LRUCache<QString, Notebook> NotebookCache;
+struct NotebookCacheCostEstimator
+{
+    quint64 operator()(const Notebook & notebook) const
+    {
+        quint64 cost = sizeof(Notebook);
+
+        if (notebook.hasName()) {
+            cost += static_cast<quint64>(notebook.name().size()) *
+                    sizeof(QChar);
+        }
+
+        if (notebook.hasStack()) {
+            cost += static_cast<quint64>(notebook.stack().size()) *
+                    sizeof(QChar);
+        }
+
+        return cost;
+    }
+};
+
+typedef ItemCache<QString, Notebook, NotebookCacheCostEstimator> NotebookCache;
 
 } // namespace quentier
 
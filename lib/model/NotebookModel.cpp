@@ -17,11 +17,11 @@
  */
 
 #include "NotebookModel.h"
-#include "NewItemNameGenerator.hpp"
 
 #include <quentier/logging/QuentierLogger.h>
 
 #include <QMimeData>
+#include <QTimerEvent>
 
 namespace quentier {
 
@@ -29,6 +29,14 @@ namespace quentier {
 #define NOTEBOOK_LIST_LIMIT (40)
 #define LINKED_NOTEBOOK_LIST_LIMIT (40)
 
+// The note counts updates caused by note additions and expunges are collected
+// for this time and then requested from the local storage at once
+#define NOTEBOOK_NOTE_COUNTS_UPDATE_DELAY_MSEC (100)
+
+// Note counts per notebook are kept up to date in memory on note events;
+// to correct any drift the counts are re-requested from the local storage
+// no more often than once per this interval after such events
+#define NOTEBOOK_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC (5000)
 
 #define NUM_NOTEBOOK_MODEL_COLUMNS (8)
 
@@ -41,7 +49,8 @@ namespace quentier {
 NotebookModel::NotebookModel(
         const Account & account,
         LocalStorageManagerAsync & localStorageManagerAsync,
-        NotebookCache & cache, QObject * parent) :
+        NotebookCache & cache, QObject * parent,
+        NoteIndexAsync * pNoteIndex) :
     ItemModel(parent),
     m_account(account),
     m_data(),
@@ -59,6 +68,7 @@ NotebookModel::NotebookModel(
     m_indexIdToLinkedNotebookGuidBimap(),
     m_lastFreeIndexId(1),
     m_cache(cache),
+    m_instrumentation(QStringLiteral("NotebookModel")),
     m_listNotebooksOffset(0),
     m_listNotebooksRequestId(),
     m_addNotebookRequestIds(),
@@ -67,15 +77,24 @@ NotebookModel::NotebookModel(
     m_findNotebookToRestoreFailedUpdateRequestIds(),
     m_findNotebookToPerformUpdateRequestIds(),
     m_noteCountPerNotebookRequestIds(),
+    m_pNotebookNoteCounter(
+        new NotebookNoteCounterAsync(localStorageManagerAsync, pNoteIndex)),
+    m_noteCountsPerNotebooksRequestIds(),
+    m_noteCountsPerAllNotebooksRequestId(),
+    m_notebookLocalUidsPendingNoteCountUpdate(),
+    m_noteCountsUpdateTimer(),
+    m_noteCountsReconciliationTimer(),
     m_linkedNotebookOwnerUsernamesByLinkedNotebookGuids(),
     m_listLinkedNotebooksOffset(0),
     m_listLinkedNotebooksRequestId(),
     m_sortedColumn(Columns::Name),
     m_sortOrder(Qt::AscendingOrder),
-    m_lastNewNotebookNameCounter(0),
+    m_newNotebookNameCounters(),
     m_allNotebooksListed(false),
     m_allLinkedNotebooksListed(false)
 {
+    m_pNotebookNoteCounter->moveToThread(localStorageManagerAsync.thread());
+
     createConnections(localStorageManagerAsync);
 
     requestNotebooksList();
@@ -85,6 +104,9 @@ NotebookModel::NotebookModel(
 NotebookModel::~NotebookModel()
 {
     delete m_fakeRootItem;
+
+    m_pNotebookNoteCounter->disconnect(this);
+    m_pNotebookNoteCounter->deleteLater();
 }
 
 void NotebookModel::updateAccount(const Account & account)
@@ -339,6 +361,7 @@ QStringList NotebookModel::notebookNames(
         result << it->name();
     }
 
+    sortItemNames(result);
     return result;
 }
 
@@ -909,9 +932,11 @@ QString NotebookModel::itemNameForLocalUid(const QString & localUid) const
     return it->name();
 }
 
-QStringList NotebookModel::itemNames(const QString & linkedNotebookGuid) const
+QStringList NotebookModel::itemNamesImpl(
+    const QString & linkedNotebookGuid) const
 {
     QStringList result;
+    QSet<QString> addedNames;
     const NotebookDataByNameUpper & nameIndex = m_data.get<ByNameUpper>();
     result.reserve(static_cast<int>(nameIndex.size()));
     for(auto it = nameIndex.begin(), end = nameIndex.end(); it != end; ++it)
@@ -922,15 +947,11 @@ QStringList NotebookModel::itemNames(const QString & linkedNotebookGuid) const
         if (linkedNotebookGuid.isNull())
         {
             // Prevent the occurrence of identical names within the returned result
-            if (Q_LIKELY(it != nameIndex.begin()))
-            {
-                auto prevIt = it;
-                --prevIt;
-                if (prevIt->name() == name) {
-                    continue;
-                }
+            if (addedNames.contains(name)) {
+                continue;
             }
 
+            Q_UNUSED(addedNames.insert(name))
             result << name;
         }
         else if (linkedNotebookGuid.isEmpty() && item.linkedNotebookGuid().isEmpty())
@@ -943,6 +964,7 @@ QStringList NotebookModel::itemNames(const QString & linkedNotebookGuid) const
         }
     }
 
+    sortItemNames(result);
     return result;
 }
 
@@ -2476,6 +2498,8 @@ bool NotebookModel::dropMimeData(
 
 void NotebookModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onAddNotebookComplete: notebook = "
             << notebook << "\nRequest id = " << requestId);
 
@@ -2492,6 +2516,8 @@ void NotebookModel::onAddNotebookComplete(Notebook notebook, QUuid requestId)
 void NotebookModel::onAddNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_addNotebookRequestIds.find(requestId);
     if (it == m_addNotebookRequestIds.end()) {
         return;
@@ -2511,6 +2537,8 @@ void NotebookModel::onAddNotebookFailed(
 
 void NotebookModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onUpdateNotebookComplete: notebook = "
             << notebook << "\nRequest id = " << requestId);
 
@@ -2526,6 +2554,8 @@ void NotebookModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 void NotebookModel::onUpdateNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateNotebookRequestIds.find(requestId);
     if (it == m_updateNotebookRequestIds.end()) {
         return;
@@ -2542,11 +2572,15 @@ void NotebookModel::onUpdateNotebookFailed(
     QNTRACE("Emitting the request to find the notebook: local uid = "
             << notebook.localUid() << ", request id = "
             << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNotebook"), requestId);
     Q_EMIT findNotebook(notebook, requestId);
 }
 
 void NotebookModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt =
         m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
@@ -2579,6 +2613,8 @@ void NotebookModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 void NotebookModel::onFindNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt =
         m_findNotebookToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findNotebookToPerformUpdateRequestIds.find(requestId);
@@ -2610,6 +2646,8 @@ void NotebookModel::onListNotebooksComplete(
     LocalStorageManager::OrderDirection orderDirection,
     QString linkedNotebookGuid, QList<Notebook> foundNotebooks, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -2630,7 +2668,6 @@ void NotebookModel::onListNotebooksComplete(
         end = foundNotebooks.constEnd(); it != end; ++it)
     {
         onNotebookAddedOrUpdated(*it);
-        requestNoteCountForNotebook(*it);
     }
 
     m_listNotebooksRequestId = QUuid();
@@ -2644,6 +2681,7 @@ void NotebookModel::onListNotebooksComplete(
     }
 
     m_allNotebooksListed = true;
+    requestNoteCountForAllNotebooks();
 
     if (m_allLinkedNotebooksListed) {
         Q_EMIT notifyAllNotebooksListed();
@@ -2658,6 +2696,8 @@ void NotebookModel::onListNotebooksFailed(
     LocalStorageManager::OrderDirection orderDirection,
     QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     if (requestId != m_listNotebooksRequestId) {
         return;
     }
@@ -2681,6 +2721,8 @@ void NotebookModel::onListNotebooksFailed(
 
 void NotebookModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onExpungeNotebookComplete: notebook = "
             << notebook << "\nRequest id = " << requestId);
 
@@ -2698,6 +2740,8 @@ void NotebookModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId
 void NotebookModel::onExpungeNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_expungeNotebookRequestIds.find(requestId);
     if (it == m_expungeNotebookRequestIds.end()) {
         return;
@@ -2719,6 +2763,8 @@ void NotebookModel::onGetNoteCountPerNotebookComplete(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
@@ -2754,6 +2800,8 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_noteCountPerNotebookRequestIds.find(requestId);
@@ -2787,8 +2835,111 @@ void NotebookModel::onGetNoteCountPerNotebookFailed(
     Q_UNUSED(updateNoteCountPerNotebookIndex(item, itemIt))
 }
 
+void NotebookModel::onGetNoteCountsPerNotebooksComplete(
+    QHash<QString, int> noteCountsPerNotebookLocalUid,
+    LocalStorageManager::NoteCountOptions options, QUuid requestId)
+{
+    m_instrumentation.recordRequestCompleted(requestId);
+
+    Q_UNUSED(options)
+
+    bool forAllNotebooks = (requestId == m_noteCountsPerAllNotebooksRequestId);
+    auto it = m_noteCountsPerNotebooksRequestIds.find(requestId);
+    if (!forAllNotebooks && (it == m_noteCountsPerNotebooksRequestIds.end())) {
+        return;
+    }
+
+    QNTRACE("NotebookModel::onGetNoteCountsPerNotebooksComplete: note "
+            << "counts were received for "
+            << noteCountsPerNotebookLocalUid.size()
+            << " notebook local uids; request id = " << requestId);
+
+    if (forAllNotebooks) {
+        m_noteCountsPerAllNotebooksRequestId = QUuid();
+    }
+    else {
+        Q_UNUSED(m_noteCountsPerNotebooksRequestIds.erase(it))
+    }
+
+    NotebookDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    if (forAllNotebooks)
+    {
+        for(auto itemIt = localUidIndex.begin(),
+            end = localUidIndex.end(); itemIt != end; ++itemIt)
+        {
+            // NOTE: notebooks without notes might be missing from the result
+            int noteCount =
+                noteCountsPerNotebookLocalUid.value(itemIt->localUid(), 0);
+            if (itemIt->numNotesPerNotebook() == noteCount) {
+                continue;
+            }
+
+            NotebookItem item = *itemIt;
+            item.setNumNotesPerNotebook(noteCount);
+            Q_UNUSED(updateNoteCountPerNotebookIndex(item, itemIt))
+        }
+
+        return;
+    }
+
+    for(auto countIt = noteCountsPerNotebookLocalUid.constBegin(),
+        countEnd = noteCountsPerNotebookLocalUid.constEnd();
+        countIt != countEnd; ++countIt)
+    {
+        auto itemIt = localUidIndex.find(countIt.key());
+        if (itemIt == localUidIndex.end()) {
+            QNDEBUG("Can't find the notebook item by local uid: "
+                    << countIt.key());
+            continue;
+        }
+
+        if (itemIt->numNotesPerNotebook() == countIt.value()) {
+            continue;
+        }
+
+        NotebookItem item = *itemIt;
+        item.setNumNotesPerNotebook(countIt.value());
+        Q_UNUSED(updateNoteCountPerNotebookIndex(item, itemIt))
+    }
+}
+
+void NotebookModel::onGetNoteCountsPerNotebooksFailed(
+    ErrorString errorDescription,
+    LocalStorageManager::NoteCountOptions options, QUuid requestId)
+{
+    m_instrumentation.recordRequestFailed(requestId);
+
+    Q_UNUSED(options)
+
+    bool forAllNotebooks = (requestId == m_noteCountsPerAllNotebooksRequestId);
+    auto it = m_noteCountsPerNotebooksRequestIds.find(requestId);
+    if (!forAllNotebooks && (it == m_noteCountsPerNotebooksRequestIds.end())) {
+        return;
+    }
+
+    QNWARNING("NotebookModel::onGetNoteCountsPerNotebooksFailed: "
+              << "error description = " << errorDescription
+              << ", request id = " << requestId);
+
+    if (forAllNotebooks) {
+        m_noteCountsPerAllNotebooksRequestId = QUuid();
+    }
+    else {
+        Q_UNUSED(m_noteCountsPerNotebooksRequestIds.erase(it))
+    }
+
+    ErrorString error(QT_TR_NOOP("Failed to get note counts for notebooks"));
+    error.appendBase(errorDescription.base());
+    error.appendBase(errorDescription.additionalBases());
+    error.details() = errorDescription.details();
+    Q_EMIT notifyError(error);
+}
+
 void NotebookModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onAddNoteComplete: note = " << note
             << ", request id = " << requestId);
 
@@ -2800,6 +2951,7 @@ void NotebookModel::onAddNoteComplete(Note note, QUuid requestId)
     {
         bool res = incrementNoteCountForNotebook(note.notebookLocalUid());
         if (res) {
+            scheduleNoteCountsReconciliation();
             return;
         }
     }
@@ -2833,10 +2985,13 @@ void NotebookModel::onNoteMovedToAnotherNotebook(
 
     Q_UNUSED(decrementNoteCountForNotebook(previousNotebookLocalUid))
     Q_UNUSED(incrementNoteCountForNotebook(newNotebookLocalUid))
+    scheduleNoteCountsReconciliation();
 }
 
 void NotebookModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onExpungeNoteComplete: note = "
             << note << "\nRequest id = " << requestId);
 
@@ -2845,9 +3000,21 @@ void NotebookModel::onExpungeNoteComplete(Note note, QUuid requestId)
         notebookLocalUid = note.notebookLocalUid();
     }
 
-    // NOTE: it's not sufficient to decrement note count for notebook
-    // as this note might have had deletion timestamp set so it did not
-    // actually contribute to the displayed note count for this notebook
+    // NOTE: deleted notes are not counted; if the expunged note doesn't carry
+    // the deletion timestamp while it actually had one, the count would be
+    // corrected by the reconciliation
+    if (!notebookLocalUid.isEmpty())
+    {
+        bool res = true;
+        if (!note.hasDeletionTimestamp()) {
+            res = decrementNoteCountForNotebook(notebookLocalUid);
+        }
+
+        if (res) {
+            scheduleNoteCountsReconciliation();
+            return;
+        }
+    }
 
     Notebook notebook;
     if (!notebookLocalUid.isEmpty()) {
@@ -2870,6 +3037,8 @@ void NotebookModel::onExpungeNoteComplete(Note note, QUuid requestId)
 void NotebookModel::onAddLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onAddLinkedNotebookComplete: "
             << "request id = " << requestId
             << ", linked notebook: " << linkedNotebook);
@@ -2879,6 +3048,8 @@ void NotebookModel::onAddLinkedNotebookComplete(
 void NotebookModel::onUpdateLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onUpdateLinkedNotebookComplete: "
             << "request id = " << requestId
             << ", linked notebook: " << linkedNotebook);
@@ -2888,6 +3059,8 @@ void NotebookModel::onUpdateLinkedNotebookComplete(
 void NotebookModel::onExpungeLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("NotebookModel::onExpungeLinkedNotebookComplete: "
             << "request id = " << requestId
             << ", linked notebook: " << linkedNotebook);
@@ -2961,6 +3134,8 @@ void NotebookModel::onListAllLinkedNotebooksComplete(
     QList<LinkedNotebook> foundLinkedNotebooks,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -3003,6 +3178,8 @@ void NotebookModel::onListAllLinkedNotebooksFailed(
     LocalStorageManager::OrderDirection orderDirection,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -3067,6 +3244,15 @@ void NotebookModel::createConnections(
                      QNSLOT(LocalStorageManagerAsync,
                             onGetNoteCountPerNotebookRequest,
                             Notebook,LocalStorageManager::NoteCountOptions,QUuid));
+    QObject::connect(this,
+                     QNSIGNAL(NotebookModel,requestNoteCountsPerNotebooks,
+                              QStringList,LocalStorageManager::NoteCountOptions,
+                              QUuid),
+                     m_pNotebookNoteCounter,
+                     QNSLOT(NotebookNoteCounterAsync,
+                            onGetNoteCountsPerNotebooksRequest,
+                            QStringList,LocalStorageManager::NoteCountOptions,
+                            QUuid));
     QObject::connect(this,
                      QNSIGNAL(NotebookModel,listAllLinkedNotebooks,size_t,size_t,
                               LocalStorageManager::ListLinkedNotebooksOrder,
@@ -3186,6 +3372,24 @@ void NotebookModel::createConnections(
                      QNSLOT(NotebookModel,onGetNoteCountPerNotebookFailed,
                             ErrorString,Notebook,
                             LocalStorageManager::NoteCountOptions,QUuid));
+    QObject::connect(m_pNotebookNoteCounter,
+                     QNSIGNAL(NotebookNoteCounterAsync,
+                              getNoteCountsPerNotebooksComplete,
+                              QHash<QString,int>,
+                              LocalStorageManager::NoteCountOptions,QUuid),
+                     this,
+                     QNSLOT(NotebookModel,onGetNoteCountsPerNotebooksComplete,
+                            QHash<QString,int>,
+                            LocalStorageManager::NoteCountOptions,QUuid));
+    QObject::connect(m_pNotebookNoteCounter,
+                     QNSIGNAL(NotebookNoteCounterAsync,
+                              getNoteCountsPerNotebooksFailed,
+                              ErrorString,
+                              LocalStorageManager::NoteCountOptions,QUuid),
+                     this,
+                     QNSLOT(NotebookModel,onGetNoteCountsPerNotebooksFailed,
+                            ErrorString,
+                            LocalStorageManager::NoteCountOptions,QUuid));
     QObject::connect(&localStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,
                               addLinkedNotebookComplete,LinkedNotebook,QUuid),
@@ -3247,6 +3451,8 @@ void NotebookModel::requestNotebooksList()
     QNTRACE("Emitting the request to list notebooks: offset = "
             << m_listNotebooksOffset << ", request id = "
             << m_listNotebooksRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listNotebooks"), m_listNotebooksRequestId);
     Q_EMIT listNotebooks(flags, NOTEBOOK_LIST_LIMIT, m_listNotebooksOffset,
                          order, direction, QString(), m_listNotebooksRequestId);
 }
@@ -3255,12 +3461,30 @@ void NotebookModel::requestNoteCountForNotebook(const Notebook & notebook)
 {
     QNTRACE("NotebookModel::requestNoteCountForNotebook: " << notebook);
 
+    // Note counts for notebooks already within the model are requested
+    // in batches
+    const NotebookDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    if (localUidIndex.find(notebook.localUid()) != localUidIndex.end())
+    {
+        Q_UNUSED(m_notebookLocalUidsPendingNoteCountUpdate.insert(
+            notebook.localUid()))
+
+        if (!m_noteCountsUpdateTimer.isActive()) {
+            m_noteCountsUpdateTimer.start(
+                NOTEBOOK_NOTE_COUNTS_UPDATE_DELAY_MSEC, this);
+        }
+
+        return;
+    }
+
     QUuid requestId = QUuid::createUuid();
     Q_UNUSED(m_noteCountPerNotebookRequestIds.insert(requestId))
     QNTRACE("Emitting request to get the note count per notebook: "
             << "request id = " << requestId);
     LocalStorageManager::NoteCountOptions options(
         LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("requestNoteCountPerNotebook"), requestId);
     Q_EMIT requestNoteCountPerNotebook(notebook, options, requestId);
 }
 
@@ -3268,16 +3492,82 @@ void NotebookModel::requestNoteCountForAllNotebooks()
 {
     QNTRACE("NotebookModel::requestNoteCountForAllNotebooks");
 
-    const NotebookDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+    // The pending updates and reconciliation are covered by this request
+    m_noteCountsUpdateTimer.stop();
+    m_noteCountsReconciliationTimer.stop();
+    m_notebookLocalUidsPendingNoteCountUpdate.clear();
 
-    for(auto it = localUidIndex.begin(),
-        end = localUidIndex.end(); it != end; ++it)
+    m_noteCountsPerAllNotebooksRequestId = QUuid::createUuid();
+    QNTRACE("Emitting the request to get note counts for all notebooks: "
+            << "request id = " << m_noteCountsPerAllNotebooksRequestId);
+    LocalStorageManager::NoteCountOptions options(
+        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("requestNoteCountsPerNotebooks"),
+        m_noteCountsPerAllNotebooksRequestId);
+    Q_EMIT requestNoteCountsPerNotebooks(QStringList(), options,
+                                         m_noteCountsPerAllNotebooksRequestId);
+}
+
+void NotebookModel::requestNoteCountsForPendingNotebooks()
+{
+    QNTRACE("NotebookModel::requestNoteCountsForPendingNotebooks: "
+            << m_notebookLocalUidsPendingNoteCountUpdate.size()
+            << " notebooks");
+
+    if (m_notebookLocalUidsPendingNoteCountUpdate.isEmpty()) {
+        return;
+    }
+
+    QStringList notebookLocalUids =
+        m_notebookLocalUidsPendingNoteCountUpdate.values();
+    m_notebookLocalUidsPendingNoteCountUpdate.clear();
+
+    QUuid requestId = QUuid::createUuid();
+    Q_UNUSED(m_noteCountsPerNotebooksRequestIds.insert(requestId))
+    QNTRACE("Emitting the request to get note counts for notebooks: "
+            << notebookLocalUids.join(QStringLiteral(", "))
+            << "; request id = " << requestId);
+    LocalStorageManager::NoteCountOptions options(
+        LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("requestNoteCountsPerNotebooks"), requestId);
+    Q_EMIT requestNoteCountsPerNotebooks(notebookLocalUids, options, requestId);
+}
+
+void NotebookModel::scheduleNoteCountsReconciliation()
+{
+    if (m_noteCountsReconciliationTimer.isActive()) {
+        return;
+    }
+
+    QNTRACE("NotebookModel::scheduleNoteCountsReconciliation");
+    m_noteCountsReconciliationTimer.start(
+        NOTEBOOK_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC, this);
+}
+
+void NotebookModel::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_noteCountsReconciliationTimer.timerId())
     {
-        const NotebookItem & item = *it;
-        Notebook notebook;
-        notebook.setLocalUid(item.localUid());
-        requestNoteCountForNotebook(notebook);
+        m_noteCountsReconciliationTimer.stop();
+
+        QNDEBUG("Reconciling note counts per notebook with the local storage");
+        requestNoteCountForAllNotebooks();
+        return;
     }
+
+    if (pEvent->timerId() == m_noteCountsUpdateTimer.timerId()) {
+        m_noteCountsUpdateTimer.stop();
+        requestNoteCountsForPendingNotebooks();
+        return;
+    }
+
+    ItemModel::timerEvent(pEvent);
 }
 
 void NotebookModel::requestLinkedNotebooksList()
@@ -3294,6 +3584,9 @@ void NotebookModel::requestLinkedNotebooksList()
     QNTRACE("Emitting the request to list linked notebooks: offset = "
             << m_listLinkedNotebooksOffset << ", request id = "
             << m_listLinkedNotebooksRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listAllLinkedNotebooks"),
+        m_listLinkedNotebooksRequestId);
     Q_EMIT listAllLinkedNotebooks(LINKED_NOTEBOOK_LIST_LIMIT,
                                   m_listLinkedNotebooksOffset, order, direction,
                                   m_listLinkedNotebooksRequestId);
@@ -3553,12 +3846,16 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
         QNDEBUG("Updating the notebook");
 
         const Notebook * pCachedNotebook = m_cache.get(item.localUid());
+        m_instrumentation.recordCacheLookup(QStringLiteral("Notebook"),
+                                             (pCachedNotebook != nullptr));
         if (Q_UNLIKELY(!pCachedNotebook))
         {
             QUuid requestId = QUuid::createUuid();
             Q_UNUSED(m_findNotebookToPerformUpdateRequestIds.insert(requestId))
             Notebook dummy;
             dummy.setLocalUid(item.localUid());
+            m_instrumentation.recordRequestIssued(
+                QStringLiteral("findNotebook"), requestId);
             Q_EMIT findNotebook(dummy, requestId);
             QNTRACE("Emitted the request to find the notebook: "
                     << "local uid = " << item.localUid()
@@ -3606,6 +3903,8 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
         QNTRACE("Emitting the request to add the notebook "
                 << "to the local storage: id = " << requestId
                 << ", notebook = " << notebook);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("addNotebook"), requestId);
         Q_EMIT addNotebook(notebook, requestId);
 
         Q_UNUSED(m_notebookItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
@@ -3621,6 +3920,8 @@ void NotebookModel::updateNotebookInLocalStorage(const NotebookItem & item)
         QNTRACE("Emitting the request to update notebook in "
                 << "the local storage: id = " << requestId
                 << ", notebook = " << notebook);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("updateNotebook"), requestId);
         Q_EMIT updateNotebook(notebook, requestId);
     }
 }
@@ -3640,6 +3941,8 @@ void NotebookModel::expungeNotebookFromLocalStorage(const QString & localUid)
     QNDEBUG("Emitting the request to expunge the notebook from "
             << "the local storage: request id = " << requestId
             << ", local uid = " << localUid);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("expungeNotebook"), requestId);
     Q_EMIT expungeNotebook(dummyNotebook, requestId);
 }
 
@@ -3648,7 +3951,7 @@ QString NotebookModel::nameForNewNotebook() const
     QString baseName = tr("New notebook");
     const NotebookDataByNameUpper & nameIndex = m_data.get<ByNameUpper>();
     return newItemName<NotebookDataByNameUpper>(nameIndex,
-                                                m_lastNewNotebookNameCounter,
+                                                m_newNotebookNameCounters,
                                                 baseName);
 }
 
@@ -22,12 +22,16 @@
 #include "ItemModel.h"
 #include "NotebookModelItem.h"
 #include "NotebookCache.h"
+#include "ModelInstrumentation.h"
+#include "NewItemNameGenerator.hpp"
+#include "NotebookNoteCounterAsync.h"
 
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 #include <quentier/types/Account.h>
 #include <quentier/utility/SuppressWarnings.h>
 
 #include <QAbstractItemModel>
+#include <QBasicTimer>
 #include <QUuid>
 #include <QSet>
 #include <QMap>
@@ -39,6 +43,7 @@ GCC_SUPPRESS_WARNING(-Wdeprecated-declarations)
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/bimap.hpp>
 
@@ -61,13 +66,19 @@ public:
     explicit NotebookModel(
         const Account & account,
         LocalStorageManagerAsync & localStorageManagerAsync,
-        NotebookCache & cache, QObject * parent = nullptr);
+        NotebookCache & cache, QObject * parent = nullptr,
+        NoteIndexAsync * pNoteIndex = nullptr);
 
     virtual ~NotebookModel();
 
     const Account & account() const { return m_account; }
     void updateAccount(const Account & account);
 
+    const ModelInstrumentation & instrumentation() const
+    { return m_instrumentation; }
+
+    void resetInstrumentation() { m_instrumentation.reset(); }
+
     struct Columns
     {
         enum type {
@@ -290,9 +301,6 @@ public:
     virtual QString itemNameForLocalUid(
         const QString & localUid) const override;
 
-    virtual QStringList itemNames(
-        const QString & linkedNotebookGuid) const override;
-
     virtual int nameColumn() const override { return Columns::Name; }
     virtual int sortingColumn() const override { return m_sortedColumn; }
 
@@ -302,6 +310,11 @@ public:
     virtual bool allItemsListed() const override
     { return allNotebooksListed(); }
 
+protected:
+    // ItemModel interface
+    virtual QStringList itemNamesImpl(
+        const QString & linkedNotebookGuid) const override;
+
 public:
     // QAbstractItemModel interface
     virtual Qt::ItemFlags flags(const QModelIndex & index) const override;
@@ -419,6 +432,10 @@ Q_SIGNALS:
         Notebook notebook, LocalStorageManager::NoteCountOptions options,
         QUuid requestId);
 
+    void requestNoteCountsPerNotebooks(
+        QStringList notebookLocalUids,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
     void listAllLinkedNotebooks(
         const size_t limit, const size_t offset,
         const LocalStorageManager::ListLinkedNotebooksOrder order,
@@ -473,6 +490,14 @@ private Q_SLOTS:
         LocalStorageManager::NoteCountOptions options,
         QUuid requestId);
 
+    void onGetNoteCountsPerNotebooksComplete(
+        QHash<QString, int> noteCountsPerNotebookLocalUid,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
+    void onGetNoteCountsPerNotebooksFailed(
+        ErrorString errorDescription,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
     void onAddNoteComplete(Note note, QUuid requestId);
 
     void onNoteMovedToAnotherNotebook(
@@ -508,6 +533,26 @@ private:
     void requestNotebooksList();
     void requestNoteCountForNotebook(const Notebook & notebook);
     void requestNoteCountForAllNotebooks();
+
+    /**
+     * @brief requestNoteCountsForPendingNotebooks - requests note counts
+     * for all notebooks which note counts were scheduled to be updated within
+     * a single request; the updates of note counts caused by note additions
+     * and expunges are collected for NOTEBOOK_NOTE_COUNTS_UPDATE_DELAY_MSEC
+     * before being requested
+     */
+    void requestNoteCountsForPendingNotebooks();
+
+    /**
+     * @brief scheduleNoteCountsReconciliation - schedules the request of note
+     * counts for all notebooks from the local storage correcting any drift
+     * of the counts updated in memory on note events; the request is sent
+     * no more often than once per
+     * NOTEBOOK_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC
+     */
+    void scheduleNoteCountsReconciliation();
+
+    virtual void timerEvent(QTimerEvent * pEvent) override;
     void requestLinkedNotebooksList();
 
     QVariant dataImpl(
@@ -565,6 +610,14 @@ private:
     struct ByStack{};
     struct ByLinkedNotebookGuid{};
 
+    struct NameUpperHash
+    {
+        std::size_t operator()(const QString & nameUpper) const
+        {
+            return qHash(nameUpper);
+        }
+    };
+
     typedef boost::multi_index_container<
         NotebookItem,
         boost::multi_index::indexed_by<
@@ -573,10 +626,11 @@ private:
                 boost::multi_index::const_mem_fun<
                     NotebookItem,const QString&,&NotebookItem::localUid>
             >,
-            boost::multi_index::ordered_non_unique<
+            boost::multi_index::hashed_non_unique<
                 boost::multi_index::tag<ByNameUpper>,
                 boost::multi_index::const_mem_fun<
-                    NotebookItem,QString,&NotebookItem::nameUpper>
+                    NotebookItem,QString,&NotebookItem::nameUpper>,
+                NameUpperHash
             >,
             boost::multi_index::ordered_non_unique<
                 boost::multi_index::tag<ByStack>,
@@ -709,6 +763,7 @@ private:
     mutable IndexId                                     m_lastFreeIndexId;
 
     NotebookCache &         m_cache;
+    ModelInstrumentation    m_instrumentation;
 
     size_t                  m_listNotebooksOffset;
     QUuid                   m_listNotebooksRequestId;
@@ -723,6 +778,16 @@ private:
 
     QSet<QUuid>             m_noteCountPerNotebookRequestIds;
 
+    // Lives in the local storage thread, computes note counts for many
+    // notebooks within a single request
+    NotebookNoteCounterAsync *  m_pNotebookNoteCounter;
+
+    QSet<QUuid>             m_noteCountsPerNotebooksRequestIds;
+    QUuid                   m_noteCountsPerAllNotebooksRequestId;
+    QSet<QString>           m_notebookLocalUidsPendingNoteCountUpdate;
+    QBasicTimer             m_noteCountsUpdateTimer;
+    QBasicTimer             m_noteCountsReconciliationTimer;
+
     QHash<QString,QString>  m_linkedNotebookOwnerUsernamesByLinkedNotebookGuids;
     size_t                  m_listLinkedNotebooksOffset;
     QUuid                   m_listLinkedNotebooksRequestId;
@@ -730,7 +795,7 @@ private:
     Columns::type           m_sortedColumn;
     Qt::SortOrder           m_sortOrder;
 
-    mutable int             m_lastNewNotebookNameCounter;
+    mutable NewItemNameCounters m_newNotebookNameCounters;
 
     bool                    m_allNotebooksListed;
     bool                    m_allLinkedNotebooksListed;
@@ -31,7 +31,8 @@ NotebookModelItem::NotebookModelItem(
     m_pNotebookStackItem(notebookStackItem),
     m_pNotebookLinkedNotebookItem(notebookLinkedNotebookItem),
     m_pParent(nullptr),
-    m_children()
+    m_children(),
+    m_row(-1)
 {
     if (parent) {
         setParent(parent);
@@ -61,6 +62,17 @@ const NotebookModelItem * NotebookModelItem::childAtRow(const int row) const
 
 int NotebookModelItem::rowForChild(const NotebookModelItem * child) const
 {
+    if (Q_UNLIKELY(!child)) {
+        return -1;
+    }
+
+    if ((child->m_pParent == this) && (child->m_row >= 0) &&
+        (child->m_row < m_children.size()) &&
+        (m_children[child->m_row] == child))
+    {
+        return child->m_row;
+    }
+
     return m_children.indexOf(child);
 }
 
@@ -73,6 +85,7 @@ void NotebookModelItem::insertChild(
 
     item->m_pParent = this;
     m_children.insert(row, item);
+    updateChildRows(row);
 }
 
 void NotebookModelItem::addChild(const NotebookModelItem * item) const
@@ -82,6 +95,7 @@ void NotebookModelItem::addChild(const NotebookModelItem * item) const
     }
 
     item->m_pParent = this;
+    item->m_row = m_children.size();
     m_children.push_back(item);
 }
 
@@ -99,6 +113,9 @@ bool NotebookModelItem::swapChildren(const int sourceRow, const int destRow) con
     m_children.swap(sourceRow, destRow);
 #endif
 
+    m_children[sourceRow]->m_row = sourceRow;
+    m_children[destRow]->m_row = destRow;
+
     return true;
 }
 
@@ -111,11 +128,21 @@ const NotebookModelItem * NotebookModelItem::takeChild(const int row) const
     const NotebookModelItem * item = m_children.takeAt(row);
     if (item) {
         item->m_pParent = nullptr;
+        item->m_row = -1;
     }
 
+    updateChildRows(row);
+
     return item;
 }
 
+void NotebookModelItem::updateChildRows(const int startRow) const
+{
+    for(int i = startRow, size = m_children.size(); i < size; ++i) {
+        m_children[i]->m_row = i;
+    }
+}
+
 QTextStream & NotebookModelItem::print(QTextStream & strm) const
 {
     strm << "Notebook model item ("
@@ -89,6 +89,9 @@ public:
     friend QDataStream & operator<<(QDataStream & out, const NotebookModelItem & item);
     friend QDataStream & operator>>(QDataStream & in, NotebookModelItem & item);
 
+private:
+    void updateChildRows(const int startRow) const;
+
 private:
     Type::type                  m_type;
     const NotebookItem *        m_pNotebookItem;
@@ -102,6 +105,11 @@ private:
     // that container's indices
     mutable const NotebookModelItem *       m_pParent;
     mutable QList<const NotebookModelItem*> m_children;
+
+    // Row of this item within its parent's children, kept in sync with
+    // the parent's list of children so that looking up the row doesn't
+    // require scanning the whole list of siblings
+    mutable int                             m_row;
 };
 
 } // namespace quentier
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NotebookNoteCounterAsync.h"
+
+#include <quentier/local_storage/LocalStorageManager.h>
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/types/Notebook.h>
+
+namespace quentier {
+
+NotebookNoteCounterAsync::NotebookNoteCounterAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        NoteIndexAsync * pNoteIndex, QObject * parent) :
+    QObject(parent),
+    m_localStorageManagerAsync(localStorageManagerAsync),
+    m_pNoteIndex(pNoteIndex)
+{}
+
+NotebookNoteCounterAsync::~NotebookNoteCounterAsync()
+{}
+
+void NotebookNoteCounterAsync::onGetNoteCountsPerNotebooksRequest(
+    QStringList notebookLocalUids,
+    LocalStorageManager::NoteCountOptions options, QUuid requestId)
+{
+    QNDEBUG("NotebookNoteCounterAsync::onGetNoteCountsPerNotebooksRequest: "
+            << "notebook local uids: "
+            << (notebookLocalUids.isEmpty()
+                ? QStringLiteral("<all>")
+                : notebookLocalUids.join(QStringLiteral(", ")))
+            << ", request id = " << requestId);
+
+    ErrorString errorDescription;
+    LocalStorageManager * pLocalStorageManager =
+        localStorageManager(errorDescription);
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        Q_EMIT getNoteCountsPerNotebooksFailed(errorDescription, options,
+                                               requestId);
+        return;
+    }
+
+    QHash<QString, int> noteCountsPerNotebookLocalUid;
+    noteCountsPerNotebookLocalUid.reserve(notebookLocalUids.size());
+    for(auto it = notebookLocalUids.constBegin(),
+        end = notebookLocalUids.constEnd(); it != end; ++it)
+    {
+        noteCountsPerNotebookLocalUid[*it] = 0;
+    }
+
+    // If the note index is built, it has everything required for counting
+    // notes so there's no need to query the local storage for each notebook;
+    // notebooks without notes are missing from the result when note counts
+    // for all notebooks are requested
+    QHash<QString, int> noteCountsPerTagLocalUid;
+    if (!m_pNoteIndex.isNull() &&
+        m_pNoteIndex->countNotes(options, noteCountsPerNotebookLocalUid,
+                                 noteCountsPerTagLocalUid,
+                                 notebookLocalUids.isEmpty()))
+    {
+        Q_EMIT getNoteCountsPerNotebooksComplete(noteCountsPerNotebookLocalUid,
+                                                 options, requestId);
+        return;
+    }
+
+    if (notebookLocalUids.isEmpty())
+    {
+        QList<Notebook> notebooks =
+            pLocalStorageManager->listAllNotebooks(errorDescription);
+        if (notebooks.isEmpty() && !errorDescription.isEmpty()) {
+            Q_EMIT getNoteCountsPerNotebooksFailed(errorDescription, options,
+                                                   requestId);
+            return;
+        }
+
+        notebookLocalUids.reserve(notebooks.size());
+        for(auto it = notebooks.constBegin(),
+            end = notebooks.constEnd(); it != end; ++it)
+        {
+            notebookLocalUids << it->localUid();
+        }
+    }
+
+    for(auto it = notebookLocalUids.constBegin(),
+        end = notebookLocalUids.constEnd(); it != end; ++it)
+    {
+        Notebook notebook;
+        notebook.setLocalUid(*it);
+
+        int noteCount = pLocalStorageManager->noteCountPerNotebook(
+            notebook, errorDescription, options);
+        if (noteCount < 0) {
+            Q_EMIT getNoteCountsPerNotebooksFailed(errorDescription, options,
+                                                   requestId);
+            return;
+        }
+
+        noteCountsPerNotebookLocalUid[*it] = noteCount;
+    }
+
+    Q_EMIT getNoteCountsPerNotebooksComplete(noteCountsPerNotebookLocalUid,
+                                             options, requestId);
+}
+
+LocalStorageManager * NotebookNoteCounterAsync::localStorageManager(
+    ErrorString & errorDescription)
+{
+    LocalStorageManager * pLocalStorageManager =
+        m_localStorageManagerAsync.localStorageManager();
+    if (Q_UNLIKELY(!pLocalStorageManager)) {
+        errorDescription.setBase(QT_TR_NOOP("Can't count notes: local "
+                                            "storage is not initialized yet"));
+        QNWARNING(errorDescription);
+    }
+
+    return pLocalStorageManager;
+}
+
+} // namespace quentier
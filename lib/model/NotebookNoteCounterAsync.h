@@ -0,0 +1,93 @@
+/*
+ * Copyright 2020 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_MODEL_NOTEBOOK_NOTE_COUNTER_ASYNC_H
+#define QUENTIER_LIB_MODEL_NOTEBOOK_NOTE_COUNTER_ASYNC_H
+
+#include "NoteIndexAsync.h"
+
+#include <quentier/local_storage/LocalStorageManagerAsync.h>
+#include <quentier/types/ErrorString.h>
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QUuid>
+
+namespace quentier {
+
+/**
+ * @brief The NotebookNoteCounterAsync class computes note counts for many
+ * notebooks within a single request so that the notebook model doesn't need
+ * to send a separate request to the local storage for each notebook
+ *
+ * The object is meant to live in the same thread as LocalStorageManagerAsync
+ * and uses the LocalStorageManager owned by the latter directly. If the note
+ * index is given and built, the notes are counted using the index instead
+ * of the local storage.
+ */
+class NotebookNoteCounterAsync: public QObject
+{
+    Q_OBJECT
+public:
+    explicit NotebookNoteCounterAsync(
+        LocalStorageManagerAsync & localStorageManagerAsync,
+        NoteIndexAsync * pNoteIndex = nullptr,
+        QObject * parent = nullptr);
+
+    virtual ~NotebookNoteCounterAsync();
+
+Q_SIGNALS:
+    void getNoteCountsPerNotebooksComplete(
+        QHash<QString, int> noteCountsPerNotebookLocalUid,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
+    void getNoteCountsPerNotebooksFailed(
+        ErrorString errorDescription,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
+public Q_SLOTS:
+    /**
+     * @brief onGetNoteCountsPerNotebooksRequest - computes note counts
+     * for several notebooks within a single request
+     *
+     * @param notebookLocalUids     Local uids of notebooks to compute note
+     *                              counts for; if empty, note counts are
+     *                              computed for all notebooks
+     */
+    void onGetNoteCountsPerNotebooksRequest(
+        QStringList notebookLocalUids,
+        LocalStorageManager::NoteCountOptions options, QUuid requestId);
+
+private:
+    LocalStorageManager * localStorageManager(ErrorString & errorDescription);
+
+private:
+    Q_DISABLE_COPY(NotebookNoteCounterAsync)
+
+private:
+    LocalStorageManagerAsync &  m_localStorageManagerAsync;
+
+    // Might be shared with other objects and deleted before this one
+    QPointer<NoteIndexAsync>    m_pNoteIndex;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_MODEL_NOTEBOOK_NOTE_COUNTER_ASYNC_H
@@ -19,12 +19,34 @@
 #ifndef QUENTIER_LIB_MODEL_SAVED_SEARCH_CACHE_H
 #define QUENTIER_LIB_MODEL_SAVED_SEARCH_CACHE_H
 
-#include <quentier/utility/LRUCache.hpp>
+#include "ItemCache.hpp"
+
 #include <quentier/types/SavedSearch.h>
 
 namespace quentier {
 
-typedef LRUCache<QString, SavedSearch> SavedSearchCache;
+struct SavedSearchCacheCostEstimator
+{
+    quint64 operator()(const SavedSearch & search) const
+    {
+        quint64 cost = sizeof(SavedSearch);
+
+        if (search.hasName()) {
+            cost += static_cast<quint64>(search.name().size()) *
+                    sizeof(QChar);
+        }
+
+        if (search.hasQuery()) {
+            cost += static_cast<quint64>(search.query().size()) *
+                    sizeof(QChar);
+        }
+
+        return cost;
+    }
+};
+
+typedef ItemCache<QString, SavedSearch, SavedSearchCacheCostEstimator>
+    SavedSearchCache;
 
 } // namespace quentier
 
@@ -17,16 +17,13 @@
  */
 
 #include "SavedSearchModel.h"
-#include "NewItemNameGenerator.hpp"
 
 #include <quentier/logging/QuentierLogger.h>
 #include <quentier/utility/UidGenerator.h>
 
 #include <limits>
 #include <algorithm>
-
-// Limit for the queries to the local storage
-#define SAVED_SEARCH_LIST_LIMIT (100)
+#include <vector>
 
 #define NUM_SAVED_SEARCH_MODEL_COLUMNS (4)
 
@@ -45,10 +42,10 @@ SavedSearchModel::SavedSearchModel(
     ItemModel(parent),
     m_account(account),
     m_data(),
-    m_listSavedSearchesOffset(0),
     m_listSavedSearchesRequestId(),
     m_savedSearchItemsNotYetInLocalStorageUids(),
     m_cache(cache),
+    m_instrumentation(QStringLiteral("SavedSearchModel")),
     m_addSavedSearchRequestIds(),
     m_updateSavedSearchRequestIds(),
     m_expungeSavedSearchRequestIds(),
@@ -56,7 +53,7 @@ SavedSearchModel::SavedSearchModel(
     m_findSavedSearchToPerformUpdateRequestIds(),
     m_sortedColumn(Columns::Name),
     m_sortOrder(Qt::AscendingOrder),
-    m_lastNewSavedSearchNameCounter(0),
+    m_newSavedSearchNameCounters(),
     m_allSavedSearchesListed(false)
 {
     createConnections(localStorageManagerAsync);
@@ -226,6 +223,13 @@ QModelIndex SavedSearchModel::createSavedSearch(
 
     item.m_name = savedSearchName;
     item.m_query = searchQuery;
+
+    ErrorString parseError;
+    if (!item.parseQuery(parseError)) {
+        QNDEBUG("Failed to parse the new saved search's query: "
+                << parseError);
+    }
+
     item.m_isDirty = true;
     item.m_isSynchronizable = (m_account.type() != Account::Type::Local);
 
@@ -298,7 +302,8 @@ QString SavedSearchModel::itemNameForLocalUid(const QString & localUid) const
     return item.m_name;
 }
 
-QStringList SavedSearchModel::itemNames(const QString & linkedNotebookGuid) const
+QStringList SavedSearchModel::itemNamesImpl(
+    const QString & linkedNotebookGuid) const
 {
     if (!linkedNotebookGuid.isEmpty()) {
         return QStringList();
@@ -536,6 +541,13 @@ bool SavedSearchModel::setData(
 
             item.m_isDirty |= (query != item.m_query);
             item.m_query = query;
+
+            ErrorString parseError;
+            if (!item.parseQuery(parseError)) {
+                QNDEBUG("Failed to parse the saved search's query: "
+                        << parseError);
+            }
+
             break;
         }
     case Columns::Synchronizable:
@@ -679,6 +691,8 @@ bool SavedSearchModel::removeRows(int row, int count, const QModelIndex & parent
                 << "from the local storage: request id = "
                 << requestId << ", saved search local uid: "
                 << it->m_localUid);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("expungeSavedSearch"), requestId);
         Q_EMIT expungeSavedSearch(savedSearch, requestId);
     }
     Q_UNUSED(index.erase(index.begin() + row, index.begin() + row + count))
@@ -765,6 +779,8 @@ void SavedSearchModel::sort(int column, Qt::SortOrder order)
 void SavedSearchModel::onAddSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("SavedSearchModel::onAddSavedSearchComplete: " << search
             << "\nRequest id = " << requestId);
 
@@ -780,6 +796,8 @@ void SavedSearchModel::onAddSavedSearchComplete(
 void SavedSearchModel::onAddSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_addSavedSearchRequestIds.find(requestId);
     if (it == m_addSavedSearchRequestIds.end()) {
         return;
@@ -819,6 +837,8 @@ void SavedSearchModel::onAddSavedSearchFailed(
 void SavedSearchModel::onUpdateSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("SavedSearchModel::onUpdateSavedSearchComplete: "
             << search << "\nRequest id = " << requestId);
 
@@ -834,6 +854,8 @@ void SavedSearchModel::onUpdateSavedSearchComplete(
 void SavedSearchModel::onUpdateSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateSavedSearchRequestIds.find(requestId);
     if (it == m_updateSavedSearchRequestIds.end()) {
         return;
@@ -850,12 +872,16 @@ void SavedSearchModel::onUpdateSavedSearchFailed(
     QNTRACE("Emitting the request to find the saved search: "
             << "local uid = " << search.localUid()
             << ", request id = " << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findSavedSearch"), requestId);
     Q_EMIT findSavedSearch(search, requestId);
 }
 
 void SavedSearchModel::onFindSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt =
         m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt =
@@ -889,6 +915,8 @@ void SavedSearchModel::onFindSavedSearchComplete(
 void SavedSearchModel::onFindSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt =
         m_findSavedSearchToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt =
@@ -921,6 +949,8 @@ void SavedSearchModel::onListSavedSearchesComplete(
     LocalStorageManager::OrderDirection orderDirection,
     QList<SavedSearch> foundSearches, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -933,20 +963,44 @@ void SavedSearchModel::onListSavedSearchesComplete(
             << ", num found searches = " << foundSearches.size()
             << ", request id = " << requestId);
 
-    for(auto it = foundSearches.constBegin(),
-        end = foundSearches.constEnd(); it != end; ++it)
+    m_listSavedSearchesRequestId = QUuid();
+
+    if (!m_data.empty())
     {
-        onSavedSearchAddedOrUpdated(*it);
+        // Some saved searches were added to the model while the listing was
+        // in progress, merge the listed ones into the model one by one
+        for(auto it = foundSearches.constBegin(),
+            end = foundSearches.constEnd(); it != end; ++it)
+        {
+            onSavedSearchAddedOrUpdated(*it);
+        }
     }
+    else
+    {
+        std::vector<SavedSearchModelItem> items;
+        items.reserve(static_cast<size_t>(foundSearches.size()));
 
-    m_listSavedSearchesRequestId = QUuid();
-    if (!foundSearches.isEmpty()) {
-        QNTRACE("The number of found saved searches is greater "
-                "than zero, requesting more saved searches from "
-                "the local storage");
-        m_listSavedSearchesOffset += static_cast<size_t>(foundSearches.size());
-        requestSavedSearchesList();
-        return;
+        for(auto it = foundSearches.constBegin(),
+            end = foundSearches.constEnd(); it != end; ++it)
+        {
+            const SavedSearch & search = *it;
+            m_cache.put(search.localUid(), search);
+
+            items.push_back(SavedSearchModelItem());
+            savedSearchToItem(search, items.back());
+        }
+
+        if (m_sortOrder == Qt::AscendingOrder) {
+            std::sort(items.begin(), items.end(), LessByName());
+        }
+        else {
+            std::sort(items.begin(), items.end(), GreaterByName());
+        }
+
+        beginResetModel();
+        SavedSearchDataByIndex & rowIndex = m_data.get<ByIndex>();
+        Q_UNUSED(rowIndex.insert(rowIndex.end(), items.begin(), items.end()))
+        endResetModel();
     }
 
     m_allSavedSearchesListed = true;
@@ -961,6 +1015,8 @@ void SavedSearchModel::onListSavedSearchesFailed(
     LocalStorageManager::OrderDirection orderDirection,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     if (requestId != m_listSavedSearchesRequestId) {
         return;
     }
@@ -981,6 +1037,8 @@ void SavedSearchModel::onListSavedSearchesFailed(
 void SavedSearchModel::onExpungeSavedSearchComplete(
     SavedSearch search, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNDEBUG("SavedSearchModel::onExpungeSavedSearchComplete: search = "
             << search << "\nRequest id = " << requestId);
 
@@ -1023,6 +1081,8 @@ void SavedSearchModel::onExpungeSavedSearchComplete(
 void SavedSearchModel::onExpungeSavedSearchFailed(
     SavedSearch search, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_expungeSavedSearchRequestIds.find(requestId);
     if (it == m_expungeSavedSearchRequestIds.end()) {
         return;
@@ -1159,8 +1219,7 @@ void SavedSearchModel::createConnections(
 
 void SavedSearchModel::requestSavedSearchesList()
 {
-    QNDEBUG("SavedSearchModel::requestSavedSearchesList: offset = "
-            << m_listSavedSearchesOffset);
+    QNDEBUG("SavedSearchModel::requestSavedSearchesList");
 
     LocalStorageManager::ListObjectsOptions flags =
         LocalStorageManager::ListObjectsOption::ListAll;
@@ -1170,11 +1229,14 @@ void SavedSearchModel::requestSavedSearchesList()
         LocalStorageManager::OrderDirection::Ascending;
 
     m_listSavedSearchesRequestId = QUuid::createUuid();
-    QNTRACE("Emitting the request to list saved searches: offset = "
-            << m_listSavedSearchesOffset << ", request id = "
+    // The number of saved searches is small enough to list them all within
+    // a single request, zero limit means no limit
+    QNTRACE("Emitting the request to list saved searches: request id = "
             << m_listSavedSearchesRequestId);
-    Q_EMIT listSavedSearches(flags, SAVED_SEARCH_LIST_LIMIT, m_listSavedSearchesOffset,
-                             order, direction, m_listSavedSearchesRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listSavedSearches"), m_listSavedSearchesRequestId);
+    Q_EMIT listSavedSearches(flags, 0, 0, order, direction,
+                             m_listSavedSearchesRequestId);
 }
 
 void SavedSearchModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
@@ -1184,23 +1246,8 @@ void SavedSearchModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
 
     m_cache.put(search.localUid(), search);
 
-    SavedSearchModelItem item(search.localUid());
-
-    if (search.hasGuid()) {
-        item.m_guid = search.guid();
-    }
-
-    if (search.hasName()) {
-        item.m_name = search.name();
-    }
-
-    if (search.hasQuery()) {
-        item.m_query = search.query();
-    }
-
-    item.m_isSynchronizable = !search.isLocal();
-    item.m_isDirty = search.isDirty();
-    item.m_isFavorited = search.isFavorited();
+    SavedSearchModelItem item;
+    savedSearchToItem(search, item);
 
     SavedSearchDataByLocalUid::iterator itemIt = localUidIndex.find(search.localUid());
     bool newSavedSearch = (itemIt == localUidIndex.end());
@@ -1259,6 +1306,35 @@ void SavedSearchModel::onSavedSearchAddedOrUpdated(const SavedSearch & search)
     Q_EMIT updatedSavedSearch(savedSearchIndexAfter);
 }
 
+void SavedSearchModel::savedSearchToItem(
+    const SavedSearch & search, SavedSearchModelItem & item) const
+{
+    item.m_localUid = search.localUid();
+
+    if (search.hasGuid()) {
+        item.m_guid = search.guid();
+    }
+
+    if (search.hasName()) {
+        item.m_name = search.name();
+    }
+
+    if (search.hasQuery())
+    {
+        item.m_query = search.query();
+
+        ErrorString parseError;
+        if (!item.parseQuery(parseError)) {
+            QNDEBUG("Failed to parse the query of saved search with local "
+                    << "uid " << item.m_localUid << ": " << parseError);
+        }
+    }
+
+    item.m_isSynchronizable = !search.isLocal();
+    item.m_isDirty = search.isDirty();
+    item.m_isFavorited = search.isFavorited();
+}
+
 QVariant SavedSearchModel::dataImpl(
     const int row, const Columns::type column) const
 {
@@ -1330,7 +1406,7 @@ QString SavedSearchModel::nameForNewSavedSearch() const
     QString baseName = tr("New saved search");
     const SavedSearchDataByNameUpper & nameIndex = m_data.get<ByNameUpper>();
     return newItemName<SavedSearchDataByNameUpper>(
-        nameIndex, m_lastNewSavedSearchNameCounter, baseName);
+        nameIndex, m_newSavedSearchNameCounters, baseName);
 }
 
 int SavedSearchModel::rowForNewItem(const SavedSearchModelItem & newItem) const
@@ -1431,12 +1507,16 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(
         QNDEBUG("Updating the saved search");
 
         const SavedSearch * pCachedSearch = m_cache.get(item.m_localUid);
+        m_instrumentation.recordCacheLookup(QStringLiteral("SavedSearch"),
+                                             (pCachedSearch != nullptr));
         if (Q_UNLIKELY(!pCachedSearch))
         {
             QUuid requestId = QUuid::createUuid();
             Q_UNUSED(m_findSavedSearchToPerformUpdateRequestIds.insert(requestId))
                 SavedSearch dummy;
             dummy.setLocalUid(item.m_localUid);
+            m_instrumentation.recordRequestIssued(
+                QStringLiteral("findSavedSearch"), requestId);
             Q_EMIT findSavedSearch(dummy, requestId);
             QNDEBUG("Emitted the request to find the saved search: "
                     << "local uid = " << item.m_localUid
@@ -1460,6 +1540,8 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(
     if (notYetSavedItemIt != m_savedSearchItemsNotYetInLocalStorageUids.end())
     {
         Q_UNUSED(m_addSavedSearchRequestIds.insert(requestId));
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("addSavedSearch"), requestId);
         Q_EMIT addSavedSearch(savedSearch, requestId);
 
         QNTRACE("Emitted the request to add the saved search to "
@@ -1476,6 +1558,8 @@ void SavedSearchModel::updateSavedSearchInLocalStorage(
         // remove its stale copy from the cache
         Q_UNUSED(m_cache.remove(savedSearch.localUid()))
 
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("updateSavedSearch"), requestId);
         Q_EMIT updateSavedSearch(savedSearch, requestId);
 
         QNTRACE("Emitted the request to update the saved search "
@@ -22,6 +22,8 @@
 #include "ItemModel.h"
 #include "SavedSearchModelItem.h"
 #include "SavedSearchCache.h"
+#include "ModelInstrumentation.h"
+#include "NewItemNameGenerator.hpp"
 
 #include <quentier/types/SavedSearch.h>
 #include <quentier/types/Account.h>
@@ -61,6 +63,11 @@ public:
     const Account & account() const { return m_account; }
     void updateAccount(const Account & account);
 
+    const ModelInstrumentation & instrumentation() const
+    { return m_instrumentation; }
+
+    void resetInstrumentation() { m_instrumentation.reset(); }
+
     struct Columns
     {
         enum type {
@@ -143,15 +150,17 @@ public:
     virtual QString itemNameForLocalUid(
         const QString & localUid) const override;
 
-    virtual QStringList itemNames(
-        const QString & linkedNotebookGuid) const override;
-
     virtual int nameColumn() const override { return Columns::Name; }
     virtual int sortingColumn() const override { return m_sortedColumn; }
     virtual Qt::SortOrder sortOrder() const override { return m_sortOrder; }
     virtual bool allItemsListed() const override
     { return m_allSavedSearchesListed; }
 
+protected:
+    // ItemModel interface
+    virtual QStringList itemNamesImpl(
+        const QString & linkedNotebookGuid) const override;
+
 public:
     // QAbstractItemModel interface
     virtual Qt::ItemFlags flags(const QModelIndex & index) const override;
@@ -264,6 +273,8 @@ private:
     void requestSavedSearchesList();
 
     void onSavedSearchAddedOrUpdated(const SavedSearch & search);
+    void savedSearchToItem(const SavedSearch & search,
+                           SavedSearchModelItem & item) const;
 
     QVariant dataImpl(const int row, const Columns::type column) const;
     QVariant dataAccessibleText(const int row, const Columns::type column) const;
@@ -327,11 +338,11 @@ private:
 private:
     Account                 m_account;
     SavedSearchData         m_data;
-    size_t                  m_listSavedSearchesOffset;
     QUuid                   m_listSavedSearchesRequestId;
     QSet<QUuid>             m_savedSearchItemsNotYetInLocalStorageUids;
 
     SavedSearchCache &      m_cache;
+    ModelInstrumentation    m_instrumentation;
 
     QSet<QUuid>             m_addSavedSearchRequestIds;
     QSet<QUuid>             m_updateSavedSearchRequestIds;
@@ -343,7 +354,7 @@ private:
     Columns::type           m_sortedColumn;
     Qt::SortOrder           m_sortOrder;
 
-    mutable int             m_lastNewSavedSearchNameCounter;
+    mutable NewItemNameCounters m_newSavedSearchNameCounters;
 
     bool                    m_allSavedSearchesListed;
 };
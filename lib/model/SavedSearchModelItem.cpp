@@ -32,17 +32,43 @@ SavedSearchModelItem::SavedSearchModelItem(
     m_guid(guid),
     m_name(name),
     m_query(query),
+    m_noteSearchQuery(),
     m_isSynchronizable(isSynchronizable),
     m_isDirty(isDirty),
     m_isFavorited(isFavorited)
-{}
+{
+    if (!m_query.isEmpty()) {
+        ErrorString errorDescription;
+        Q_UNUSED(parseQuery(errorDescription))
+    }
+}
+
+bool SavedSearchModelItem::parseQuery(ErrorString & errorDescription)
+{
+    m_noteSearchQuery = NoteSearchQuery();
+
+    if (m_query.isEmpty()) {
+        errorDescription.setBase(QT_TR_NOOP("saved search's query is empty"));
+        return false;
+    }
+
+    NoteSearchQuery noteSearchQuery;
+    if (!noteSearchQuery.setQueryString(m_query, errorDescription)) {
+        return false;
+    }
+
+    m_noteSearchQuery = noteSearchQuery;
+    return true;
+}
 
 QTextStream & SavedSearchModelItem::print(QTextStream & strm) const
 {
     strm << "Saved search model item: local uid = " << m_localUid
          << ", guid = " << m_guid
          << ", name = " << m_name << ", query = "
-         << m_query << ", is synchronizable = "
+         << m_query << ", query is parsed = "
+         << (m_noteSearchQuery.isEmpty() ? "false" : "true")
+         << ", is synchronizable = "
          << (m_isSynchronizable ? "true" : "false")
          << ", is dirty = "
          << (m_isDirty ? "true" : "false")
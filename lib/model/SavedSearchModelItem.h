@@ -19,6 +19,8 @@
 #ifndef QUENTIER_LIB_MODEL_SAVED_SEARCH_MODEL_ITEM_H
 #define QUENTIER_LIB_MODEL_SAVED_SEARCH_MODEL_ITEM_H
 
+#include <quentier/local_storage/NoteSearchQuery.h>
+#include <quentier/types/ErrorString.h>
 #include <quentier/utility/Printable.h>
 
 namespace quentier {
@@ -39,13 +41,27 @@ public:
 
     QString nameUpper() const { return m_name.toUpper(); }
 
-    QString     m_localUid;
-    QString     m_guid;
-    QString     m_name;
-    QString     m_query;
-    bool        m_isSynchronizable;
-    bool        m_isDirty;
-    bool        m_isFavorited;
+    /**
+     * @brief parseQuery - parses m_query into m_noteSearchQuery so that
+     * the query doesn't need to be parsed again each time the saved search
+     * is used to filter notes
+     *
+     * @param errorDescription      The textual description of the error
+     *                              if the query could not be parsed
+     * @return                      True if the query was parsed successfully,
+     *                              false otherwise; in the latter case
+     *                              m_noteSearchQuery is empty
+     */
+    bool parseQuery(ErrorString & errorDescription);
+
+    QString             m_localUid;
+    QString             m_guid;
+    QString             m_name;
+    QString             m_query;
+    NoteSearchQuery     m_noteSearchQuery;
+    bool                m_isSynchronizable;
+    bool                m_isDirty;
+    bool                m_isFavorited;
 };
 
 } // namespace quentier
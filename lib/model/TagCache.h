@@ -19,12 +19,27 @@
 #ifndef QUENTIER_LIB_MODEL_TAG_CACHE_H
 #define QUENTIER_LIB_MODEL_TAG_CACHE_H
 
-#include <quentier/utility/LRUCache.hpp>
+#include "ItemCache.hpp"
+
 #include <quentier/types/Tag.h>
 
 namespace quentier {
 
-typedef LRUCache<QString, Tag> TagCache;
+struct TagCacheCostEstimator
+{
+    quint64 operator()(const Tag & tag) const
+    {
+        quint64 cost = sizeof(Tag);
+
+        if (tag.hasName()) {
+            cost += static_cast<quint64>(tag.name().size()) * sizeof(QChar);
+        }
+
+        return cost;
+    }
+};
+
+typedef ItemCache<QString, Tag, TagCacheCostEstimator> TagCache;
 
 } // namespace quentier
 
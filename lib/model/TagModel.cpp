@@ -17,21 +17,26 @@
  */
 
 #include "TagModel.h"
-#include "NewItemNameGenerator.hpp"
 
 #include <quentier/logging/QuentierLogger.h>
 
 #include <QByteArray>
 #include <QMimeData>
+#include <QTimerEvent>
 
 #include <limits>
 #include <vector>
 #include <algorithm>
 
 // Limit for the queries to the local storage
-#define TAG_LIST_LIMIT (100)
+#define TAG_LIST_LIMIT (500)
 #define LINKED_NOTEBOOK_LIST_LIMIT (40)
 
+// Note counts per tag are kept up to date in memory on note events; to correct
+// any drift the counts are re-requested from the local storage no more often
+// than once per this interval after such events
+#define TAG_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC (5000)
+
 #define NUM_TAG_MODEL_COLUMNS (5)
 
 #define REPORT_ERROR(error, ...)                                               \
@@ -57,6 +62,7 @@ TagModel::TagModel(
     m_data(),
     m_fakeRootItem(nullptr),
     m_cache(cache),
+    m_instrumentation(QStringLiteral("TagModel")),
     m_modelItemsByLocalUid(),
     m_modelItemsByLinkedNotebookGuid(),
     m_linkedNotebookItems(),
@@ -65,12 +71,14 @@ TagModel::TagModel(
     m_lastFreeIndexId(1),
     m_listTagsOffset(0),
     m_listTagsRequestId(),
+    m_listedTags(),
     m_tagItemsNotYetInLocalStorageUids(),
     m_addTagRequestIds(),
     m_updateTagRequestIds(),
     m_expungeTagRequestIds(),
     m_noteCountPerTagRequestIds(),
     m_noteCountsPerAllTagsRequestId(),
+    m_noteCountsReconciliationTimer(),
     m_findTagToRestoreFailedUpdateRequestIds(),
     m_findTagToPerformUpdateRequestIds(),
     m_findTagAfterNotelessTagsErasureRequestIds(),
@@ -82,8 +90,8 @@ TagModel::TagModel(
     m_sortOrder(Qt::AscendingOrder),
     m_tagRestrictionsByLinkedNotebookGuid(),
     m_findNotebookRequestForLinkedNotebookGuid(),
-    m_lastNewTagNameCounter(0),
-    m_lastNewTagNameCounterByLinkedNotebookGuid(),
+    m_newTagNameCounters(),
+    m_newTagNameCountersByLinkedNotebookGuid(),
     m_allTagsListed(false),
     m_allLinkedNotebooksListed(false)
 {
@@ -200,7 +208,8 @@ QString TagModel::itemNameForLocalUid(const QString & localUid) const
     return it->name();
 }
 
-QStringList TagModel::itemNames(const QString & linkedNotebookGuid) const
+QStringList TagModel::itemNamesImpl(
+    const QString & linkedNotebookGuid) const
 {
     return tagNames(linkedNotebookGuid);
 }
@@ -921,6 +930,8 @@ bool TagModel::removeRows(int row, int count, const QModelIndex & parent)
 
         QUuid requestId = QUuid::createUuid();
         Q_UNUSED(m_expungeTagRequestIds.insert(requestId))
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("expungeTag"), requestId);
         Q_EMIT expungeTag(tag, requestId);
         QNTRACE("Emitted the request to expunge the tag from "
                 << "the local storage: request id = " << requestId
@@ -991,38 +1002,7 @@ void TagModel::sort(int column, Qt::SortOrder order)
 
     Q_EMIT layoutAboutToBeChanged();
 
-    if (m_sortOrder == Qt::AscendingOrder)
-    {
-        for(auto it = m_modelItemsByLocalUid.constBegin();
-            it != m_modelItemsByLocalUid.constEnd(); ++it)
-        {
-            it->sortChildren(LessByName());
-        }
-
-        for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin();
-            it != m_modelItemsByLinkedNotebookGuid.constEnd(); ++it)
-        {
-            it->sortChildren(LessByName());
-        }
-
-        m_fakeRootItem->sortChildren(LessByName());
-    }
-    else
-    {
-        for(auto it = m_modelItemsByLocalUid.constBegin();
-            it != m_modelItemsByLocalUid.constEnd(); ++it)
-        {
-            it->sortChildren(GreaterByName());
-        }
-
-        for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin();
-            it != m_modelItemsByLinkedNotebookGuid.constEnd(); ++it)
-        {
-            it->sortChildren(GreaterByName());
-        }
-
-        m_fakeRootItem->sortChildren(GreaterByName());
-    }
+    sortChildItems();
 
     updatePersistentModelIndices();
     Q_EMIT layoutChanged();
@@ -1279,6 +1259,8 @@ bool TagModel::dropMimeData(
 
 void TagModel::onAddTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onAddTagComplete: tag = " << tag
             << "\nRequest id = " << requestId);
 
@@ -1295,6 +1277,8 @@ void TagModel::onAddTagComplete(Tag tag, QUuid requestId)
 void TagModel::onAddTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_addTagRequestIds.find(requestId);
     if (it == m_addTagRequestIds.end()) {
         return;
@@ -1313,6 +1297,8 @@ void TagModel::onAddTagFailed(
 
 void TagModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onUpdateTagComplete: tag = " << tag
             << "\nRequest id = " << requestId);
 
@@ -1331,6 +1317,8 @@ void TagModel::onUpdateTagComplete(Tag tag, QUuid requestId)
 void TagModel::onUpdateTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_updateTagRequestIds.find(requestId);
     if (it == m_updateTagRequestIds.end()) {
         return;
@@ -1346,11 +1334,14 @@ void TagModel::onUpdateTagFailed(
     Q_UNUSED(m_findTagToRestoreFailedUpdateRequestIds.insert(requestId))
     QNTRACE("Emitting the request to find a tag: local uid = "
             << tag.localUid() << ", request id = " << requestId);
+    m_instrumentation.recordRequestIssued(QStringLiteral("findTag"), requestId);
     Q_EMIT findTag(tag, requestId);
 }
 
 void TagModel::onFindTagComplete(Tag tag, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto checkAfterErasureIt =
@@ -1391,6 +1382,8 @@ void TagModel::onFindTagComplete(Tag tag, QUuid requestId)
 
 void TagModel::onFindTagFailed(Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto restoreUpdateIt = m_findTagToRestoreFailedUpdateRequestIds.find(requestId);
     auto performUpdateIt = m_findTagToPerformUpdateRequestIds.find(requestId);
     auto checkAfterErasureIt =
@@ -1429,6 +1422,8 @@ void TagModel::onListTagsComplete(
     LocalStorageManager::OrderDirection orderDirection,
     QString linkedNotebookGuid, QList<Tag> tags, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1443,10 +1438,7 @@ void TagModel::onListTagsComplete(
             << ", num found tags = " << tags.size()
             << ", request id = " << requestId);
 
-    for(auto it = tags.constBegin(), end = tags.constEnd(); it != end; ++it) {
-        onTagAddedOrUpdated(*it);
-    }
-
+    m_listedTags.append(tags);
     m_listTagsRequestId = QUuid();
 
     if (!tags.isEmpty()) {
@@ -1457,6 +1449,8 @@ void TagModel::onListTagsComplete(
         return;
     }
 
+    insertListedTags();
+
     m_allTagsListed = true;
     requestNoteCountsPerAllTags();
 
@@ -1473,6 +1467,8 @@ void TagModel::onListTagsFailed(
     LocalStorageManager::OrderDirection orderDirection,
     QString linkedNotebookGuid, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     if (requestId != m_listTagsRequestId) {
         return;
     }
@@ -1489,12 +1485,17 @@ void TagModel::onListTagsFailed(
 
     m_listTagsRequestId = QUuid();
 
+    // Show at least the tags listed before the failure
+    insertListedTags();
+
     Q_EMIT notifyError(errorDescription);
 }
 
 void TagModel::onExpungeTagComplete(
     Tag tag, QStringList expungedChildTagLocalUids, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onExpungeTagComplete: tag = " << tag
             << "\nExpunged child tag local uids: "
             << expungedChildTagLocalUids.join(QStringLiteral(", "))
@@ -1506,6 +1507,22 @@ void TagModel::onExpungeTagComplete(
         return;
     }
 
+    // The expunged tags must not get into the model if they have already been
+    // listed but not yet inserted
+    for(auto listedTagIt = m_listedTags.begin();
+        listedTagIt != m_listedTags.end(); )
+    {
+        const QString & listedTagLocalUid = listedTagIt->localUid();
+        if ((listedTagLocalUid == tag.localUid()) ||
+            expungedChildTagLocalUids.contains(listedTagLocalUid))
+        {
+            listedTagIt = m_listedTags.erase(listedTagIt);
+        }
+        else {
+            ++listedTagIt;
+        }
+    }
+
     Q_EMIT aboutToRemoveTags();
     // NOTE: all child items would be removed from the model automatically
     removeItemByLocalUid(tag.localUid());
@@ -1515,6 +1532,8 @@ void TagModel::onExpungeTagComplete(
 void TagModel::onExpungeTagFailed(
     Tag tag, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_expungeTagRequestIds.find(requestId);
     if (it == m_expungeTagRequestIds.end()) {
         return;
@@ -1533,6 +1552,8 @@ void TagModel::onGetNoteCountPerTagComplete(
     int noteCount, Tag tag, LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_noteCountPerTagRequestIds.find(requestId);
@@ -1553,6 +1574,8 @@ void TagModel::onGetNoteCountPerTagFailed(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     auto it = m_noteCountPerTagRequestIds.find(requestId);
@@ -1578,6 +1601,8 @@ void TagModel::onGetNoteCountsPerAllTagsComplete(
     LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     Q_UNUSED(options)
 
     if (requestId != m_noteCountsPerAllTagsRequestId) {
@@ -1594,15 +1619,14 @@ void TagModel::onGetNoteCountsPerAllTagsComplete(
     for(auto it = localUidIndex.begin(),
         end = localUidIndex.end(); it != end; ++it)
     {
-        TagItem item = *it;
-        auto noteCountIt = noteCountsPerTagLocalUid.find(item.localUid());
-        if (noteCountIt != noteCountsPerTagLocalUid.end()) {
-            item.setNumNotesPerTag(noteCountIt.value());
-        }
-        else {
-            item.setNumNotesPerTag(0);
+        int noteCount = noteCountsPerTagLocalUid.value(it->localUid(), 0);
+        if (it->numNotesPerTag() == noteCount) {
+            continue;
         }
 
+        TagItem item = *it;
+        item.setNumNotesPerTag(noteCount);
+
         localUidIndex.replace(it, item);
 
         const QString & parentLocalUid = item.parentLocalUid();
@@ -1632,6 +1656,8 @@ void TagModel::onGetNoteCountsPerAllTagsFailed(
     ErrorString errorDescription, LocalStorageManager::NoteCountOptions options,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     Q_UNUSED(options)
 
     if (requestId != m_noteCountsPerAllTagsRequestId) {
@@ -1653,6 +1679,8 @@ void TagModel::onGetNoteCountsPerAllTagsFailed(
 
 void TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete(QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete: "
             << "request id = " << requestId);
 
@@ -1676,12 +1704,16 @@ void TagModel::onExpungeNotelessTagsFromLinkedNotebooksComplete(QUuid requestId)
         QNTRACE("Emitting the request to find tag from linked "
                 << "notebook to check for its existence: "
                 << item.localUid() << ", request id = " << requestId);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("findTag"), requestId);
         Q_EMIT findTag(tag, requestId);
     }
 }
 
 void TagModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto it = m_findNotebookRequestForLinkedNotebookGuid.right.find(requestId);
     if (it == m_findNotebookRequestForLinkedNotebookGuid.right.end()) {
         return;
@@ -1698,6 +1730,8 @@ void TagModel::onFindNotebookComplete(Notebook notebook, QUuid requestId)
 void TagModel::onFindNotebookFailed(
     Notebook notebook, ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_findNotebookRequestForLinkedNotebookGuid.right.find(requestId);
     if (it == m_findNotebookRequestForLinkedNotebookGuid.right.end()) {
         return;
@@ -1712,6 +1746,8 @@ void TagModel::onFindNotebookFailed(
 
 void TagModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onUpdateNotebookComplete: local uid = "
             << notebook.localUid());
     Q_UNUSED(requestId)
@@ -1720,6 +1756,8 @@ void TagModel::onUpdateNotebookComplete(Notebook notebook, QUuid requestId)
 
 void TagModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onExpungeNotebookComplete: local uid = "
             << notebook.localUid() << ", linked notebook guid = "
             << (notebook.hasLinkedNotebookGuid()
@@ -1752,9 +1790,12 @@ void TagModel::onExpungeNotebookComplete(Notebook notebook, QUuid requestId)
 
 void TagModel::onAddNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onAddNoteComplete: note = " << note << "\nRequest id = "
             << requestId);
 
+    // NOTE: deleted notes are not counted, just like on their expunge
     if (Q_UNLIKELY(note.hasDeletionTimestamp())) {
         return;
     }
@@ -1780,10 +1821,10 @@ void TagModel::onAddNoteComplete(Note note, QUuid requestId)
     for(auto it = tagLocalUids.constBegin(),
         end = tagLocalUids.constEnd(); it != end; ++it)
     {
-        Tag dummy;
-        dummy.setLocalUid(*it);
-        requestNoteCountForTag(dummy);
+        adjustNoteCountForTag(*it, 1);
     }
+
+    scheduleNoteCountsReconciliation();
 }
 
 void TagModel::onNoteTagListChanged(
@@ -1796,81 +1837,64 @@ void TagModel::onNoteTagListChanged(
             << ", new note tag local uids = "
             << newNoteTagLocalUids.join(QStringLiteral(",")));
 
-    std::sort(previousNoteTagLocalUids.begin(), previousNoteTagLocalUids.end());
-    std::sort(newNoteTagLocalUids.begin(), newNoteTagLocalUids.end());
-
-    std::vector<QString> commonTagLocalUids;
-
-    std::set_intersection(previousNoteTagLocalUids.begin(),
-                          previousNoteTagLocalUids.end(),
-                          newNoteTagLocalUids.begin(), newNoteTagLocalUids.end(),
-                          std::back_inserter(commonTagLocalUids));
-
-    TagDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
-
+    QSet<QString> previousTagLocalUids;
+    previousTagLocalUids.reserve(previousNoteTagLocalUids.size());
     for(auto it = previousNoteTagLocalUids.constBegin(),
         end = previousNoteTagLocalUids.constEnd(); it != end; ++it)
     {
-        const QString & tagLocalUid = *it;
-        if (std::find(commonTagLocalUids.begin(), commonTagLocalUids.end(),
-                      tagLocalUid) != commonTagLocalUids.end())
-        {
-            continue;
-        }
-
-        auto itemIt = localUidIndex.find(tagLocalUid);
-        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-            // Probably this tag was expunged
-            QNDEBUG("No tag was found in the model: " << tagLocalUid);
-            continue;
-        }
-
-        int noteCount = itemIt->numNotesPerTag();
-        --noteCount;
-        noteCount = std::max(0, noteCount);
-        setNoteCountForTag(tagLocalUid, noteCount);
+        Q_UNUSED(previousTagLocalUids.insert(*it))
     }
 
+    QSet<QString> newTagLocalUids;
+    newTagLocalUids.reserve(newNoteTagLocalUids.size());
     for(auto it = newNoteTagLocalUids.constBegin(),
         end = newNoteTagLocalUids.constEnd(); it != end; ++it)
     {
-        const QString & tagLocalUid = *it;
-        if (std::find(commonTagLocalUids.begin(), commonTagLocalUids.end(),
-                      tagLocalUid) != commonTagLocalUids.end())
-        {
-            continue;
-        }
+        Q_UNUSED(newTagLocalUids.insert(*it))
+    }
 
-        auto itemIt = localUidIndex.find(tagLocalUid);
-        if (Q_UNLIKELY(itemIt == localUidIndex.end())) {
-            // Probably this tag was expunged
-            QNDEBUG("No tag was found in the model: " << tagLocalUid);
-            continue;
+    for(auto it = previousTagLocalUids.constBegin(),
+        end = previousTagLocalUids.constEnd(); it != end; ++it)
+    {
+        if (!newTagLocalUids.contains(*it)) {
+            adjustNoteCountForTag(*it, -1);
         }
+    }
 
-        int noteCount = itemIt->numNotesPerTag();
-        ++noteCount;
-        setNoteCountForTag(tagLocalUid, noteCount);
+    for(auto it = newTagLocalUids.constBegin(),
+        end = newTagLocalUids.constEnd(); it != end; ++it)
+    {
+        if (!previousTagLocalUids.contains(*it)) {
+            adjustNoteCountForTag(*it, 1);
+        }
     }
+
+    scheduleNoteCountsReconciliation();
 }
 
 void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onExpungeNoteComplete: note = " << note
             << "\nRequest id = " << requestId);
 
     if (note.hasTagLocalUids())
     {
-        const QStringList & tagLocalUids = note.tagLocalUids();
-        for(auto it = tagLocalUids.constBegin(),
-            end = tagLocalUids.constEnd(); it != end; ++it)
+        // NOTE: deleted notes are not counted; if the expunged note doesn't
+        // carry the deletion timestamp while it actually had one, the count
+        // would be corrected by the reconciliation
+        if (!note.hasDeletionTimestamp())
         {
-            const QString & tagLocalUid = *it;
-            Tag tag;
-            tag.setLocalUid(tagLocalUid);
-            requestNoteCountForTag(tag);
+            const QStringList & tagLocalUids = note.tagLocalUids();
+            for(auto it = tagLocalUids.constBegin(),
+                end = tagLocalUids.constEnd(); it != end; ++it)
+            {
+                adjustNoteCountForTag(*it, -1);
+            }
         }
 
+        scheduleNoteCountsReconciliation();
         return;
     }
 
@@ -1881,6 +1905,8 @@ void TagModel::onExpungeNoteComplete(Note note, QUuid requestId)
 void TagModel::onAddLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onAddLinkedNotebookComplete: request id = "
             << requestId << ", linked notebook: " << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -1889,6 +1915,8 @@ void TagModel::onAddLinkedNotebookComplete(
 void TagModel::onUpdateLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onUpdateLinkedNotebookComplete: request id = "
             << requestId << ", linked notebook: " << linkedNotebook);
     onLinkedNotebookAddedOrUpdated(linkedNotebook);
@@ -1897,6 +1925,8 @@ void TagModel::onUpdateLinkedNotebookComplete(
 void TagModel::onExpungeLinkedNotebookComplete(
     LinkedNotebook linkedNotebook, QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     QNTRACE("TagModel::onExpungeLinkedNotebookComplete: request id = "
             << requestId << ", linked notebook: " << linkedNotebook);
 
@@ -1964,6 +1994,8 @@ void TagModel::onListAllTagsPerNoteComplete(
     LocalStorageManager::OrderDirection orderDirection,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     auto it = m_listTagsPerNoteRequestIds.find(requestId);
     if (it == m_listTagsPerNoteRequestIds.end()) {
         return;
@@ -1989,6 +2021,8 @@ void TagModel::onListAllTagsPerNoteFailed(
     LocalStorageManager::OrderDirection orderDirection,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     auto it = m_listTagsPerNoteRequestIds.find(requestId);
     if (it == m_listTagsPerNoteRequestIds.end()) {
         return;
@@ -2012,6 +2046,8 @@ void TagModel::onListAllLinkedNotebooksComplete(
     QList<LinkedNotebook> foundLinkedNotebooks,
     QUuid requestId)
 {
+    m_instrumentation.recordRequestCompleted(requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -2053,6 +2089,8 @@ void TagModel::onListAllLinkedNotebooksFailed(
     LocalStorageManager::OrderDirection orderDirection,
     ErrorString errorDescription, QUuid requestId)
 {
+    m_instrumentation.recordRequestFailed(requestId);
+
     if (requestId != m_listLinkedNotebooksRequestId) {
         return;
     }
@@ -2358,6 +2396,8 @@ void TagModel::requestTagsList()
     m_listTagsRequestId = QUuid::createUuid();
     QNTRACE("Emitting the request to list tags: offset = " << m_listTagsOffset
             << ", request id = " << m_listTagsRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listTags"), m_listTagsRequestId);
     Q_EMIT listTags(flags, TAG_LIST_LIMIT, m_listTagsOffset, order, direction,
                     QString(), m_listTagsRequestId);
 }
@@ -2372,6 +2412,8 @@ void TagModel::requestNoteCountForTag(const Tag & tag)
             << "per tag, request id = " << requestId);
     LocalStorageManager::NoteCountOptions options(
         LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("requestNoteCountPerTag"), requestId);
     Q_EMIT requestNoteCountPerTag(tag, options, requestId);
 }
 
@@ -2383,6 +2425,8 @@ void TagModel::requestTagsPerNote(const Note & note)
     Q_UNUSED(m_listTagsPerNoteRequestIds.insert(requestId))
     QNTRACE("Emitting the request to list tags per note: request id = "
             << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listAllTagsPerNote"), requestId);
     Q_EMIT listAllTagsPerNote(
         note, LocalStorageManager::ListObjectsOption::ListAll,
         /* limit = */ 0, /* offset = */ 0,
@@ -2394,12 +2438,47 @@ void TagModel::requestNoteCountsPerAllTags()
 {
     QNTRACE("TagModel::requestNoteCountsPerAllTags");
 
+    // The pending reconciliation is covered by this request
+    m_noteCountsReconciliationTimer.stop();
+
     m_noteCountsPerAllTagsRequestId = QUuid::createUuid();
     LocalStorageManager::NoteCountOptions options(
         LocalStorageManager::NoteCountOption::IncludeNonDeletedNotes);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("requestNoteCountsForAllTags"),
+        m_noteCountsPerAllTagsRequestId);
     Q_EMIT requestNoteCountsForAllTags(options, m_noteCountsPerAllTagsRequestId);
 }
 
+void TagModel::scheduleNoteCountsReconciliation()
+{
+    if (m_noteCountsReconciliationTimer.isActive()) {
+        return;
+    }
+
+    QNTRACE("TagModel::scheduleNoteCountsReconciliation");
+    m_noteCountsReconciliationTimer.start(
+        TAG_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC, this);
+}
+
+void TagModel::timerEvent(QTimerEvent * pEvent)
+{
+    if (Q_UNLIKELY(!pEvent)) {
+        return;
+    }
+
+    if (pEvent->timerId() == m_noteCountsReconciliationTimer.timerId())
+    {
+        m_noteCountsReconciliationTimer.stop();
+
+        QNDEBUG("Reconciling note counts per tag with the local storage");
+        requestNoteCountsPerAllTags();
+        return;
+    }
+
+    ItemModel::timerEvent(pEvent);
+}
+
 void TagModel::requestLinkedNotebooksList()
 {
     QNTRACE("TagModel::requestLinkedNotebooksList");
@@ -2413,6 +2492,9 @@ void TagModel::requestLinkedNotebooksList()
     QNTRACE("Emitting the request to list linked notebooks: "
             << "offset = " << m_listLinkedNotebooksOffset
             << ", request id = " << m_listLinkedNotebooksRequestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("listAllLinkedNotebooks"),
+        m_listLinkedNotebooksRequestId);
     Q_EMIT listAllLinkedNotebooks(
         LINKED_NOTEBOOK_LIST_LIMIT, m_listLinkedNotebooksOffset, order,
         direction, m_listLinkedNotebooksRequestId);
@@ -2643,6 +2725,203 @@ void TagModel::onTagUpdated(
     updateItemRowWithRespectToSorting(modelItem);
 }
 
+void TagModel::insertListedTags()
+{
+    QNTRACE("TagModel::insertListedTags: " << m_listedTags.size()
+            << " listed tags");
+
+    if (m_listedTags.isEmpty()) {
+        return;
+    }
+
+    if (!m_fakeRootItem) {
+        m_fakeRootItem = new TagModelItem;
+    }
+
+    TagDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    QSet<QString> listedTagLocalUids;
+    listedTagLocalUids.reserve(m_listedTags.size());
+    for(auto it = m_listedTags.constBegin(),
+        end = m_listedTags.constEnd(); it != end; ++it)
+    {
+        Q_UNUSED(listedTagLocalUids.insert(it->localUid()))
+    }
+
+    // Linked notebook root items are inserted individually before the reset:
+    // there are only as many of them as there are linked notebooks
+    for(auto it = m_listedTags.constBegin(),
+        end = m_listedTags.constEnd(); it != end; ++it)
+    {
+        const Tag & tag = *it;
+        if (!tag.hasLinkedNotebookGuid()) {
+            continue;
+        }
+
+        if (tag.hasParentLocalUid() &&
+            (listedTagLocalUids.contains(tag.parentLocalUid()) ||
+             m_modelItemsByLocalUid.contains(tag.parentLocalUid())))
+        {
+            continue;
+        }
+
+        Q_UNUSED(findOrCreateLinkedNotebookModelItem(tag.linkedNotebookGuid()))
+    }
+
+    beginResetModel();
+
+    // 1) Create items for listed tags which are not yet within the model;
+    // tags which got into the model while the listing was in progress came
+    // from the local storage later than the listed ones so they are kept
+    for(auto it = m_listedTags.constBegin(),
+        end = m_listedTags.constEnd(); it != end; ++it)
+    {
+        const Tag & tag = *it;
+        if (localUidIndex.find(tag.localUid()) != localUidIndex.end()) {
+            continue;
+        }
+
+        m_cache.put(tag.localUid(), tag);
+
+        TagItem item;
+        tagToItem(tag, item);
+        checkAndFindLinkedNotebookRestrictions(item);
+
+        auto insertionResult = localUidIndex.insert(item);
+        const TagItem * pItem = &(*insertionResult.first);
+
+        Q_UNUSED(m_modelItemsByLocalUid.insert(
+            pItem->localUid(), TagModelItem(TagModelItem::Type::Tag, pItem)))
+    }
+
+    m_listedTags.clear();
+
+    // 2) Detach all items from their parents
+    for(auto it = m_modelItemsByLocalUid.constBegin(),
+        end = m_modelItemsByLocalUid.constEnd(); it != end; ++it)
+    {
+        const TagModelItem & modelItem = *it;
+        while(modelItem.hasChildren()) {
+            Q_UNUSED(modelItem.takeChild(modelItem.numChildren() - 1))
+        }
+    }
+
+    for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin(),
+        end = m_modelItemsByLinkedNotebookGuid.constEnd(); it != end; ++it)
+    {
+        const TagModelItem & modelItem = *it;
+        while(modelItem.hasChildren()) {
+            Q_UNUSED(modelItem.takeChild(modelItem.numChildren() - 1))
+        }
+    }
+
+    while(m_fakeRootItem->hasChildren()) {
+        Q_UNUSED(m_fakeRootItem->takeChild(m_fakeRootItem->numChildren() - 1))
+    }
+
+    // 3) Attach each item to its parent in one pass
+    for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin(),
+        end = m_modelItemsByLinkedNotebookGuid.constEnd(); it != end; ++it)
+    {
+        m_fakeRootItem->addChild(&(*it));
+    }
+
+    for(auto it = m_modelItemsByLocalUid.constBegin(),
+        end = m_modelItemsByLocalUid.constEnd(); it != end; ++it)
+    {
+        const TagModelItem & modelItem = *it;
+        const TagItem * pTagItem = modelItem.tagItem();
+        if (Q_UNLIKELY(!pTagItem)) {
+            continue;
+        }
+
+        const TagModelItem * pParentItem = nullptr;
+
+        const QString & parentLocalUid = pTagItem->parentLocalUid();
+        if (!parentLocalUid.isEmpty())
+        {
+            auto parentIt = m_modelItemsByLocalUid.constFind(parentLocalUid);
+            if (parentIt != m_modelItemsByLocalUid.constEnd()) {
+                pParentItem = &(*parentIt);
+            }
+        }
+
+        if (!pParentItem)
+        {
+            const QString & linkedNotebookGuid = pTagItem->linkedNotebookGuid();
+            if (!linkedNotebookGuid.isEmpty())
+            {
+                auto linkedNotebookModelItemIt =
+                    m_modelItemsByLinkedNotebookGuid.constFind(
+                        linkedNotebookGuid);
+                if (linkedNotebookModelItemIt !=
+                    m_modelItemsByLinkedNotebookGuid.constEnd())
+                {
+                    pParentItem = &(*linkedNotebookModelItemIt);
+                }
+            }
+        }
+
+        if (!pParentItem) {
+            pParentItem = m_fakeRootItem;
+        }
+
+        pParentItem->addChild(&modelItem);
+    }
+
+    // 4) Sort each list of siblings once
+    if (m_sortedColumn == Columns::Name) {
+        sortChildItems();
+    }
+
+    endResetModel();
+
+    QNDEBUG("Inserted listed tags into the model, total number of tags: "
+            << m_modelItemsByLocalUid.size());
+}
+
+void TagModel::sortChildItems()
+{
+    QNTRACE("TagModel::sortChildItems");
+
+    if (Q_UNLIKELY(!m_fakeRootItem)) {
+        return;
+    }
+
+    if (m_sortOrder == Qt::AscendingOrder)
+    {
+        for(auto it = m_modelItemsByLocalUid.constBegin();
+            it != m_modelItemsByLocalUid.constEnd(); ++it)
+        {
+            it->sortChildren(LessByName());
+        }
+
+        for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin();
+            it != m_modelItemsByLinkedNotebookGuid.constEnd(); ++it)
+        {
+            it->sortChildren(LessByName());
+        }
+
+        m_fakeRootItem->sortChildren(LessByName());
+    }
+    else
+    {
+        for(auto it = m_modelItemsByLocalUid.constBegin();
+            it != m_modelItemsByLocalUid.constEnd(); ++it)
+        {
+            it->sortChildren(GreaterByName());
+        }
+
+        for(auto it = m_modelItemsByLinkedNotebookGuid.constBegin();
+            it != m_modelItemsByLinkedNotebookGuid.constEnd(); ++it)
+        {
+            it->sortChildren(GreaterByName());
+        }
+
+        m_fakeRootItem->sortChildren(GreaterByName());
+    }
+}
+
 void TagModel::tagToItem(const Tag & tag, TagItem & item)
 {
     item.setLocalUid(tag.localUid());
@@ -3693,6 +3972,7 @@ QStringList TagModel::tagNames(const QString & linkedNotebookGuid) const
         result << tagName;
     }
 
+    sortItemNames(result);
     return result;
 }
 
@@ -3996,21 +4276,27 @@ QString TagModel::nameForNewTag(const QString & linkedNotebookGuid) const
 {
     QString baseName = tr("New tag");
     const TagDataByNameUpper & nameIndex = m_data.get<ByNameUpper>();
-    QSet<QString> tagNames;
-    for(auto it = nameIndex.begin(), end = nameIndex.end(); it != end; ++it)
-    {
-        if (it->linkedNotebookGuid() != linkedNotebookGuid) {
-            continue;
-        }
 
-        Q_UNUSED(tagNames.insert(it->nameUpper()))
-    }
+    // Tag names only need to be unique within the same linked notebook
+    auto isNameTaken =
+        [&](const QString & nameUpper) -> bool
+        {
+            auto range = nameIndex.equal_range(nameUpper);
+            for(auto it = range.first; it != range.second; ++it)
+            {
+                if (it->linkedNotebookGuid() == linkedNotebookGuid) {
+                    return true;
+                }
+            }
 
-    int & lastNewTagNameCounter =
+            return false;
+        };
+
+    NewItemNameCounters & newTagNameCounters =
         (linkedNotebookGuid.isEmpty()
-         ? m_lastNewTagNameCounter
-         : m_lastNewTagNameCounterByLinkedNotebookGuid[linkedNotebookGuid]);
-    return newItemName<QSet<QString> >(tagNames, lastNewTagNameCounter, baseName);
+         ? m_newTagNameCounters
+         : m_newTagNameCountersByLinkedNotebookGuid[linkedNotebookGuid]);
+    return newItemNameByPredicate(isNameTaken, newTagNameCounters, baseName);
 }
 
 void TagModel::removeItemByLocalUid(const QString & localUid)
@@ -4236,6 +4522,8 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
         QNDEBUG("Updating the tag");
 
         const Tag * pCachedTag = m_cache.get(item.localUid());
+        m_instrumentation.recordCacheLookup(QStringLiteral("Tag"),
+                                             (pCachedTag != nullptr));
         if (Q_UNLIKELY(!pCachedTag))
         {
             QUuid requestId = QUuid::createUuid();
@@ -4244,6 +4532,8 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
             dummy.setLocalUid(item.localUid());
             QNDEBUG("Emitting the request to find tag: local uid = "
                     << item.localUid() << ", request id = " << requestId);
+            m_instrumentation.recordRequestIssued(
+                QStringLiteral("findTag"), requestId);
             Q_EMIT findTag(dummy, requestId);
             return;
         }
@@ -4261,6 +4551,8 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
 
         QNTRACE("Emitting the request to add the tag to the local "
                 << "storage: id = " << requestId << ", tag: " << tag);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("addTag"), requestId);
         Q_EMIT addTag(tag, requestId);
 
         Q_UNUSED(m_tagItemsNotYetInLocalStorageUids.erase(notYetSavedItemIt))
@@ -4275,6 +4567,8 @@ void TagModel::updateTagInLocalStorage(const TagItem & item)
 
         QNTRACE("Emitting the request to update tag in the local "
                 << "storage: id = " << requestId << ", tag: " << tag);
+        m_instrumentation.recordRequestIssued(
+            QStringLiteral("updateTag"), requestId);
         Q_EMIT updateTag(tag, requestId);
     }
 }
@@ -4350,6 +4644,23 @@ void TagModel::setNoteCountForTag(
     // check if need to re-sort and Q_EMIT the layout changed signal
 }
 
+void TagModel::adjustNoteCountForTag(
+    const QString & tagLocalUid, const int delta)
+{
+    TagDataByLocalUid & localUidIndex = m_data.get<ByLocalUid>();
+
+    auto itemIt = localUidIndex.find(tagLocalUid);
+    if (itemIt == localUidIndex.end()) {
+        // Probably this tag was expunged
+        QNDEBUG("No tag was found in the model: " << tagLocalUid);
+        return;
+    }
+
+    int noteCount = std::max(itemIt->numNotesPerTag(), 0) + delta;
+    noteCount = std::max(noteCount, 0);
+    setNoteCountForTag(tagLocalUid, noteCount);
+}
+
 void TagModel::setTagFavorited(const QModelIndex & index, const bool favorited)
 {
     if (Q_UNLIKELY(!index.isValid())) {
@@ -4633,6 +4944,8 @@ void TagModel::checkAndFindLinkedNotebookRestrictions(const TagItem & tagItem)
             << "notebook guid: " << linkedNotebookGuid
             << ", for the purpose of finding the tag restrictions; "
             << "request id = " << requestId);
+    m_instrumentation.recordRequestIssued(
+        QStringLiteral("findNotebook"), requestId);
     Q_EMIT findNotebook(notebook, requestId);
 }
 
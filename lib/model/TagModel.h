@@ -22,6 +22,8 @@
 #include "ItemModel.h"
 #include "TagModelItem.h"
 #include "TagCache.h"
+#include "ModelInstrumentation.h"
+#include "NewItemNameGenerator.hpp"
 
 #include <quentier/types/Tag.h>
 #include <quentier/types/Notebook.h>
@@ -31,6 +33,7 @@
 #include <quentier/utility/SuppressWarnings.h>
 
 #include <QAbstractItemModel>
+#include <QBasicTimer>
 #include <QUuid>
 #include <QSet>
 #include <QHash>
@@ -41,6 +44,7 @@ GCC_SUPPRESS_WARNING(-Wdeprecated-declarations)
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/bimap.hpp>
 
@@ -68,6 +72,11 @@ public:
     const Account & account() const { return m_account; }
     void updateAccount(const Account & account);
 
+    const ModelInstrumentation & instrumentation() const
+    { return m_instrumentation; }
+
+    void resetInstrumentation() { m_instrumentation.reset(); }
+
     struct Columns
     {
         enum type {
@@ -245,14 +254,16 @@ public:
     virtual QString itemNameForLocalUid(
         const QString & localUid) const override;
 
-    virtual QStringList itemNames(
-        const QString & linkedNotebookGuid) const override;
-
     virtual int nameColumn() const override { return Columns::Name; }
     virtual int sortingColumn() const override { return m_sortedColumn; }
     virtual Qt::SortOrder sortOrder() const override { return m_sortOrder; }
     virtual bool allItemsListed() const override;
 
+protected:
+    // ItemModel interface
+    virtual QStringList itemNamesImpl(
+        const QString & linkedNotebookGuid) const override;
+
 public:
     // QAbstractItemModel interface
     virtual Qt::ItemFlags flags(const QModelIndex & index) const override;
@@ -472,6 +483,17 @@ private:
     void requestNoteCountForTag(const Tag & tag);
     void requestTagsPerNote(const Note & note);
     void requestNoteCountsPerAllTags();
+
+    /**
+     * @brief scheduleNoteCountsReconciliation - schedules the request of note
+     * counts for all tags from the local storage correcting any drift
+     * of the counts updated in memory on note events; the request is sent
+     * no more often than once per TAG_NOTE_COUNTS_RECONCILIATION_INTERVAL_MSEC
+     */
+    void scheduleNoteCountsReconciliation();
+
+    virtual void timerEvent(QTimerEvent * pEvent) override;
+
     void requestLinkedNotebooksList();
 
     QVariant dataImpl(
@@ -485,6 +507,15 @@ private:
     void mapChildItems();
     void mapChildItems(const TagModelItem & item);
 
+    // Inserts the tags accumulated during the listing from the local storage
+    // into the model at once: resolves parent links in one pass, sorts each
+    // list of siblings once and publishes the whole tree with a single
+    // model reset
+    void insertListedTags();
+
+    // Sorts children of all items according to the current sort order
+    void sortChildItems();
+
     QString nameForNewTag(const QString & linkedNotebookGuid) const;
     void removeItemByLocalUid(const QString & localUid);
 
@@ -502,6 +533,7 @@ private:
     void tagFromItem(const TagItem & item, Tag & tag) const;
 
     void setNoteCountForTag(const QString & tagLocalUid, const int noteCount);
+    void adjustNoteCountForTag(const QString & tagLocalUid, const int delta);
     void setTagFavorited(const QModelIndex & index, const bool favorited);
 
     void beginRemoveTags();
@@ -523,6 +555,14 @@ private:
     struct ByNameUpper{};
     struct ByLinkedNotebookGuid{};
 
+    struct NameUpperHash
+    {
+        std::size_t operator()(const QString & nameUpper) const
+        {
+            return qHash(nameUpper);
+        }
+    };
+
     typedef boost::multi_index_container<
         TagItem,
         boost::multi_index::indexed_by<
@@ -536,10 +576,11 @@ private:
                 boost::multi_index::const_mem_fun<
                     TagItem,const QString&,&TagItem::parentLocalUid>
             >,
-            boost::multi_index::ordered_non_unique<
+            boost::multi_index::hashed_non_unique<
                 boost::multi_index::tag<ByNameUpper>,
                 boost::multi_index::const_mem_fun<
-                    TagItem,QString,&TagItem::nameUpper>
+                    TagItem,QString,&TagItem::nameUpper>,
+                NameUpperHash
             >,
             boost::multi_index::ordered_non_unique<
                 boost::multi_index::tag<ByLinkedNotebookGuid>,
@@ -613,6 +654,7 @@ private:
     TagModelItem *          m_fakeRootItem;
 
     TagCache &              m_cache;
+    ModelInstrumentation    m_instrumentation;
 
     ModelItems              m_modelItemsByLocalUid;
     ModelItems              m_modelItemsByLinkedNotebookGuid;
@@ -625,6 +667,7 @@ private:
 
     size_t                  m_listTagsOffset;
     QUuid                   m_listTagsRequestId;
+    QList<Tag>              m_listedTags;
     QSet<QUuid>             m_tagItemsNotYetInLocalStorageUids;
 
     QSet<QUuid>             m_addTagRequestIds;
@@ -633,6 +676,7 @@ private:
 
     QSet<QUuid>             m_noteCountPerTagRequestIds;
     QUuid                   m_noteCountsPerAllTagsRequestId;
+    QBasicTimer             m_noteCountsReconciliationTimer;
 
     QSet<QUuid>             m_findTagToRestoreFailedUpdateRequestIds;
     QSet<QUuid>             m_findTagToPerformUpdateRequestIds;
@@ -663,8 +707,9 @@ private:
     typedef boost::bimap<QString, QUuid> LinkedNotebookGuidWithFindNotebookRequestIdBimap;
     LinkedNotebookGuidWithFindNotebookRequestIdBimap    m_findNotebookRequestForLinkedNotebookGuid;
 
-    mutable int                     m_lastNewTagNameCounter;
-    mutable QMap<QString,int>       m_lastNewTagNameCounterByLinkedNotebookGuid;
+    mutable NewItemNameCounters     m_newTagNameCounters;
+    mutable QMap<QString, NewItemNameCounters>
+                                    m_newTagNameCountersByLinkedNotebookGuid;
 
     bool                            m_allTagsListed;
     bool                            m_allLinkedNotebooksListed;
@@ -28,7 +28,8 @@ TagModelItem::TagModelItem(
     m_pTagItem(pTagItem),
     m_pTagLinkedNotebookRootItem(pTagLinkedNotebookRootItem),
     m_pParent(pParent),
-    m_children()
+    m_children(),
+    m_row(-1)
 {
     if (m_pParent) {
         m_pParent->addChild(this);
@@ -59,6 +60,17 @@ const TagModelItem * TagModelItem::childAtRow(const int row) const
 
 int TagModelItem::rowForChild(const TagModelItem * child) const
 {
+    if (Q_UNLIKELY(!child)) {
+        return -1;
+    }
+
+    if ((child->m_pParent == this) && (child->m_row >= 0) &&
+        (child->m_row < m_children.size()) &&
+        (m_children[child->m_row] == child))
+    {
+        return child->m_row;
+    }
+
     return m_children.indexOf(child);
 }
 
@@ -70,6 +82,7 @@ void TagModelItem::insertChild(const int row, const TagModelItem * pItem) const
 
     pItem->m_pParent = this;
     m_children.insert(row, pItem);
+    updateChildRows(row);
 }
 
 void TagModelItem::addChild(const TagModelItem * pItem) const
@@ -79,6 +92,7 @@ void TagModelItem::addChild(const TagModelItem * pItem) const
     }
 
     pItem->m_pParent = this;
+    pItem->m_row = m_children.size();
     m_children.push_back(pItem);
 }
 
@@ -96,6 +110,9 @@ bool TagModelItem::swapChildren(const int sourceRow, const int destRow) const
     m_children.swap(sourceRow, destRow);
 #endif
 
+    m_children[sourceRow]->m_row = sourceRow;
+    m_children[destRow]->m_row = destRow;
+
     return true;
 }
 
@@ -108,11 +125,21 @@ const TagModelItem * TagModelItem::takeChild(const int row) const
     const TagModelItem * pItem = m_children.takeAt(row);
     if (pItem) {
         pItem->m_pParent = nullptr;
+        pItem->m_row = -1;
     }
 
+    updateChildRows(row);
+
     return pItem;
 }
 
+void TagModelItem::updateChildRows(const int startRow) const
+{
+    for(int i = startRow, size = m_children.size(); i < size; ++i) {
+        m_children[i]->m_row = i;
+    }
+}
+
 QTextStream & TagModelItem::print(QTextStream & strm) const
 {
     strm << "Tag model item ("
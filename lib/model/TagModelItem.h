@@ -81,6 +81,7 @@ public:
     void sortChildren(Comparator comparator) const
     {
         std::sort(m_children.begin(), m_children.end(), comparator);
+        updateChildRows(0);
     }
 
     virtual QTextStream & print(QTextStream & strm) const override;
@@ -88,6 +89,9 @@ public:
     friend QDataStream & operator<<(QDataStream & out, const TagModelItem & item);
     friend QDataStream & operator>>(QDataStream & in, TagModelItem & item);
 
+private:
+    void updateChildRows(const int startRow) const;
+
 private:
     Type::type                          m_type;
     const TagItem *                     m_pTagItem;
@@ -100,6 +104,11 @@ private:
     // that container's indices
     mutable const TagModelItem *          m_pParent;
     mutable QList<const TagModelItem*>    m_children;
+
+    // Row of this item within its parent's children, kept in sync with
+    // the parent's list of children so that looking up the row doesn't
+    // require scanning the whole list of siblings
+    mutable int                           m_row;
 };
 
 } // namespace quentier
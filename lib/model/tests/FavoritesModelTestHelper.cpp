@@ -27,6 +27,8 @@
 #include <quentier/utility/SysInfo.h>
 #include <quentier/exception/IQuentierException.h>
 
+#include <QSignalSpy>
+
 namespace quentier {
 
 FavoritesModelTestHelper::FavoritesModelTestHelper(
@@ -792,6 +794,17 @@ void FavoritesModelTestHelper::launchTest()
             checkSorting(*model);
         }
 
+        // Renaming the items should keep the rows sorted by moving each renamed
+        // item's row at once rather than removing and re-inserting it
+        model->sort(FavoritesModel::Columns::DisplayName, Qt::AscendingOrder);
+
+        QSignalSpy rowsMovedSpy(
+            model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)));
+        QSignalSpy rowsRemovedSpy(
+            model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+        QSignalSpy rowsInsertedSpy(
+            model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
         // Ensure the modifications of favorites model items propagate properly
         // to the local storage
         m_expectingTagUpdateFromLocalStorage = true;
@@ -820,6 +833,8 @@ void FavoritesModelTestHelper::launchTest()
                  "model item");
         }
 
+        checkItemRowMove(*model, m_secondNotebook.localUid(), rowsMovedSpy);
+
         firstSavedSearchIndex = model->indexForLocalUid(m_firstSavedSearch.localUid());
         if (!firstSavedSearchIndex.isValid()) {
             FAIL("Can't get the valid model index for the favorites "
@@ -840,6 +855,8 @@ void FavoritesModelTestHelper::launchTest()
             FAIL("Can't change the display name of the favorites model item");
         }
 
+        checkItemRowMove(*model, m_firstSavedSearch.localUid(), rowsMovedSpy);
+
         QModelIndex fourthTagIndex = model->indexForLocalUid(m_fourthTag.localUid());
         if (!fourthTagIndex.isValid()) {
             FAIL("Can't get the valid model index for the favorites "
@@ -859,6 +876,8 @@ void FavoritesModelTestHelper::launchTest()
             FAIL("Can't change the display name of the favorites model item");
         }
 
+        checkItemRowMove(*model, m_fourthTag.localUid(), rowsMovedSpy);
+
         firstNoteIndex = model->indexForLocalUid(m_firstNote.localUid());
         if (!firstNoteIndex.isValid()) {
             FAIL("Can't get the valid model index for the favorites "
@@ -878,6 +897,13 @@ void FavoritesModelTestHelper::launchTest()
             FAIL("Can't change the display name of the favorites model item");
         }
 
+        checkItemRowMove(*model, m_firstNote.localUid(), rowsMovedSpy);
+
+        if (!rowsRemovedSpy.isEmpty() || !rowsInsertedSpy.isEmpty()) {
+            FAIL("Favorites model removed or inserted rows while renaming "
+                 "its items");
+        }
+
         return;
     }
     CATCH_EXCEPTION()
@@ -1250,6 +1276,48 @@ void FavoritesModelTestHelper::onListSavedSearchesFailed(
     notifyFailureWithStackTrace(errorDescription);
 }
 
+void FavoritesModelTestHelper::checkItemRowMove(
+    const FavoritesModel & model, const QString & localUid,
+    QList<QList<QVariant> > & rowsMovedSignals)
+{
+    QNDEBUG("FavoritesModelTestHelper::checkItemRowMove: local uid = "
+            << localUid);
+
+    checkSorting(model);
+
+    if (rowsMovedSignals.isEmpty()) {
+        return;
+    }
+
+    if (rowsMovedSignals.size() != 1) {
+        FAIL("Favorites model moved rows " << rowsMovedSignals.size()
+             << " times on the update of a single item, expected once");
+    }
+
+    QList<QVariant> arguments = rowsMovedSignals.takeFirst();
+    int firstRow = arguments.at(1).toInt();
+    int lastRow = arguments.at(2).toInt();
+    int destinationRow = arguments.at(4).toInt();
+
+    if (firstRow != lastRow) {
+        FAIL("Favorites model moved rows from " << firstRow << " to "
+             << lastRow << " on the update of a single item");
+    }
+
+    // The destination row passed to beginMoveRows counts the moved row
+    // when the row is moved down
+    int expectedRow = destinationRow;
+    if (destinationRow > firstRow) {
+        --expectedRow;
+    }
+
+    QModelIndex index = model.indexForLocalUid(localUid);
+    if (index.row() != expectedRow) {
+        FAIL("The moved favorites model item is at row " << index.row()
+             << " while the row move pointed to row " << expectedRow);
+    }
+}
+
 void FavoritesModelTestHelper::checkSorting(const FavoritesModel & model)
 {
     QNDEBUG("FavoritesModelTestHelper::checkSorting");
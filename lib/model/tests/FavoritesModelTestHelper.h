@@ -112,6 +112,11 @@ private Q_SLOTS:
 
 private:
     void checkSorting(const FavoritesModel & model);
+
+    void checkItemRowMove(
+        const FavoritesModel & model, const QString & localUid,
+        QList<QList<QVariant> > & rowsMovedSignals);
+
     void notifyFailureWithStackTrace(ErrorString errorDescription);
 
 private:
@@ -25,6 +25,8 @@
 
 #include <lib/model/SavedSearchModel.h>
 #include <lib/model/TagModel.h>
+#include <lib/model/NoteModel.h>
+#include <lib/model/NotebookModelItem.h>
 
 #include <quentier/exception/IQuentierException.h>
 #include <quentier/utility/SysInfo.h>
@@ -47,6 +49,21 @@
 
 #define qnPrintable(string) QString::fromUtf8(string).toLocal8Bit().constData()
 
+// The number of notes, tags and rows in the view used by the benchmarks;
+// the notes are added to the local storage one by one before the benchmarks
+// so their number is kept small enough for the tests to finish quickly
+#define NUM_BENCHMARK_NOTES (2000)
+#define NUM_BENCHMARK_TAGS (50)
+#define NUM_BENCHMARK_VIEWPORT_ROWS (40)
+
+// The number of filtered notebooks and tags and the number of notes checked
+// against them by the note filters benchmark
+#define NUM_BENCHMARK_FILTERED_ITEMS (1000)
+#define NUM_BENCHMARK_FILTERED_NOTES (20000)
+
+// The number of sibling items under one parent in tag and notebook models
+#define NUM_BENCHMARK_SIBLING_ITEMS (20000)
+
 ModelTester::ModelTester(QObject * parent) :
     QObject(parent),
     m_pLocalStorageManagerAsync(nullptr)
@@ -357,6 +374,368 @@ void ModelTester::testTagModelItemSerialization()
              qnPrintable("Wrong pointer to the tag item"));
 }
 
+void ModelTester::benchmarkNoteModelFetchMore()
+{
+    using namespace quentier;
+
+    setUpBenchmarkLocalStorage();
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+    int numRows = 0;
+    {
+        NoteModel model(account, *m_pLocalStorageManagerAsync, noteCache,
+                        notebookCache);
+        model.setViewportRowCount(NUM_BENCHMARK_VIEWPORT_ROWS);
+        model.start();
+
+        // Scrolling to the bottom of the note list the way the note list view
+        // does it: one fetchMore call per screen of rows; the loaded notes
+        // stay in the model so the scroll can only be timed once
+        QBENCHMARK_ONCE
+        {
+            for(int i = 0; (i < NUM_BENCHMARK_NOTES) &&
+                model.canFetchMore(QModelIndex()); ++i)
+            {
+                model.fetchMore(QModelIndex());
+            }
+        }
+
+        numRows = model.rowCount(QModelIndex());
+    }
+
+    // The note model releases its note summary lister via deleteLater
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    QVERIFY2(numRows == NUM_BENCHMARK_NOTES,
+             qnPrintable("Note model didn't load all notes"));
+}
+
+void ModelTester::benchmarkNoteSummaries()
+{
+    using namespace quentier;
+
+    QString paragraph = QStringLiteral("<div>Lorem ipsum dolor sit amet, "
+                                       "consectetur adipiscing elit, sed do "
+                                       "eiusmod tempor incididunt ut labore "
+                                       "et dolore magna aliqua.</div>");
+
+    QList<Note> notes;
+    notes.reserve(NUM_BENCHMARK_NOTES);
+    for(int i = 0; i < NUM_BENCHMARK_NOTES; ++i)
+    {
+        Note note;
+        note.setTitle(QStringLiteral("Benchmark note %1").arg(i));
+        note.setContent(QStringLiteral("<en-note><h1>Benchmark note %1</h1>")
+                        .arg(i) + paragraph.repeated(20) +
+                        QStringLiteral("</en-note>"));
+        note.setCreationTimestamp(QDateTime::currentMSecsSinceEpoch());
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setLocal(true);
+
+        Resource resource;
+        resource.setNoteLocalUid(note.localUid());
+        resource.setMime(QStringLiteral("image/png"));
+        resource.setDataBody(QByteArray(64 * 1024, 'x'));
+        resource.setDataSize(64 * 1024);
+        note.addResource(resource);
+
+        notes << note;
+    }
+
+    // Converting full notes into the summaries which NoteModel and
+    // FavoritesModel get from the notes listing
+    QList<NoteModelItem> summaries;
+    QBENCHMARK
+    {
+        summaries.clear();
+        summaries.reserve(notes.size());
+        for(auto it = notes.constBegin(), end = notes.constEnd();
+            it != end; ++it)
+        {
+            NoteModelItem summary;
+            NoteSummaryListerAsync::noteToSummary(*it, summary);
+            summaries << summary;
+        }
+    }
+
+    QVERIFY2(summaries.size() == NUM_BENCHMARK_NOTES,
+             qnPrintable("Unexpected number of note summaries"));
+    QVERIFY2(!summaries.front().previewText().isEmpty(),
+             qnPrintable("Note summary has no preview text"));
+    QVERIFY2(summaries.front().sizeInBytes() > 64 * 1024,
+             qnPrintable("Note summary's size doesn't include the resource"));
+}
+
+void ModelTester::benchmarkNoteModelNameColumns()
+{
+    using namespace quentier;
+
+    setUpBenchmarkLocalStorage();
+
+    NoteCache noteCache(20);
+    NotebookCache notebookCache(3);
+    Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+    int numRows = 0;
+    int numNotebookNames = 0;
+    int numTagNames = 0;
+    {
+        NoteModel model(account, *m_pLocalStorageManagerAsync, noteCache,
+                        notebookCache);
+        model.start();
+
+        for(int i = 0; (i < NUM_BENCHMARK_NOTES) &&
+            model.canFetchMore(QModelIndex()); ++i)
+        {
+            model.fetchMore(QModelIndex());
+        }
+
+        numRows = model.rowCount(QModelIndex());
+
+        // Notebook and tag names are looked up when the data is requested,
+        // the way the note list view repaints all the rows
+        QBENCHMARK
+        {
+            numNotebookNames = 0;
+            numTagNames = 0;
+            for(int row = 0; row < numRows; ++row)
+            {
+                QModelIndex notebookNameIndex =
+                    model.index(row, NoteModel::Columns::NotebookName,
+                                QModelIndex());
+                if (!model.data(notebookNameIndex).toString().isEmpty()) {
+                    ++numNotebookNames;
+                }
+
+                QModelIndex tagNameListIndex =
+                    model.index(row, NoteModel::Columns::TagNameList,
+                                QModelIndex());
+                numTagNames +=
+                    model.data(tagNameListIndex).toStringList().size();
+            }
+        }
+    }
+
+    // The note model releases its note summary lister via deleteLater
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+    QVERIFY2(numRows == NUM_BENCHMARK_NOTES,
+             qnPrintable("Note model didn't load all notes"));
+    QVERIFY2(numNotebookNames == numRows,
+             qnPrintable("Not every note has the notebook name"));
+    QVERIFY2(numTagNames == 2 * numRows,
+             qnPrintable("Not every note has both tag names"));
+}
+
+void ModelTester::benchmarkNoteFilters()
+{
+    using namespace quentier;
+
+    // Only the first half of the notebooks and tags is filtered
+    QStringList notebookLocalUids;
+    QStringList tagLocalUids;
+    notebookLocalUids.reserve(2 * NUM_BENCHMARK_FILTERED_ITEMS);
+    tagLocalUids.reserve(2 * NUM_BENCHMARK_FILTERED_ITEMS);
+    for(int i = 0; i < 2 * NUM_BENCHMARK_FILTERED_ITEMS; ++i) {
+        notebookLocalUids << UidGenerator::Generate();
+        tagLocalUids << UidGenerator::Generate();
+    }
+
+    NoteModel::NoteFilters filters;
+    filters.setFilteredNotebookLocalUids(
+        notebookLocalUids.mid(0, NUM_BENCHMARK_FILTERED_ITEMS));
+    filters.setFilteredTagLocalUids(
+        tagLocalUids.mid(0, NUM_BENCHMARK_FILTERED_ITEMS));
+
+    QStringList noteLocalUids;
+    QStringList noteNotebookLocalUids;
+    QList<QStringList> noteTagLocalUids;
+    noteLocalUids.reserve(NUM_BENCHMARK_FILTERED_NOTES);
+    noteNotebookLocalUids.reserve(NUM_BENCHMARK_FILTERED_NOTES);
+    noteTagLocalUids.reserve(NUM_BENCHMARK_FILTERED_NOTES);
+
+    int numExpectedConformingNotes = 0;
+    for(int i = 0; i < NUM_BENCHMARK_FILTERED_NOTES; ++i)
+    {
+        int notebookIndex = i % (2 * NUM_BENCHMARK_FILTERED_ITEMS);
+        int firstTagIndex = (7 * i) % (2 * NUM_BENCHMARK_FILTERED_ITEMS);
+        int secondTagIndex = (13 * i) % (2 * NUM_BENCHMARK_FILTERED_ITEMS);
+
+        noteLocalUids << UidGenerator::Generate();
+        noteNotebookLocalUids << notebookLocalUids[notebookIndex];
+        noteTagLocalUids << (QStringList() << tagLocalUids[firstTagIndex]
+                             << tagLocalUids[secondTagIndex]);
+
+        if ((notebookIndex < NUM_BENCHMARK_FILTERED_ITEMS) &&
+            ((firstTagIndex < NUM_BENCHMARK_FILTERED_ITEMS) ||
+             (secondTagIndex < NUM_BENCHMARK_FILTERED_ITEMS)))
+        {
+            ++numExpectedConformingNotes;
+        }
+    }
+
+    int numConformingNotes = 0;
+    QBENCHMARK
+    {
+        numConformingNotes = 0;
+        for(int i = 0; i < NUM_BENCHMARK_FILTERED_NOTES; ++i)
+        {
+            if (filters.noteConforms(noteLocalUids[i],
+                                     noteNotebookLocalUids[i],
+                                     noteTagLocalUids[i]))
+            {
+                ++numConformingNotes;
+            }
+        }
+    }
+
+    QVERIFY2(numConformingNotes == numExpectedConformingNotes,
+             qnPrintable("Unexpected number of notes passing the filters"));
+}
+
+void ModelTester::benchmarkTagModelItemRowForChild()
+{
+    using namespace quentier;
+
+    TagItem parentTagItem(UidGenerator::Generate());
+    TagModelItem parentItem(TagModelItem::Type::Tag, &parentTagItem);
+
+    // NOTE: vectors are not resized after this point so the pointers to their
+    // elements stay valid while the parent item refers to them
+    QVector<TagItem> tagItems(NUM_BENCHMARK_SIBLING_ITEMS);
+    QVector<TagModelItem> modelItems(NUM_BENCHMARK_SIBLING_ITEMS);
+    for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i)
+    {
+        tagItems[i].setLocalUid(UidGenerator::Generate());
+        tagItems[i].setName(QStringLiteral("Benchmark tag %1").arg(i));
+        modelItems[i].setTagItem(&tagItems[i]);
+
+        // Inserting the first item last to shift the rows of all others
+        if (i != 0) {
+            parentItem.addChild(&modelItems[i]);
+        }
+    }
+    parentItem.insertChild(0, &modelItems[0]);
+
+    for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i) {
+        QVERIFY2(parentItem.rowForChild(&modelItems[i]) == i,
+                 qnPrintable("Wrong row of the child tag model item"));
+    }
+
+    int rowSum = 0;
+    QBENCHMARK
+    {
+        rowSum = 0;
+        for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i) {
+            rowSum += parentItem.rowForChild(&modelItems[i]);
+        }
+    }
+
+    QVERIFY2(rowSum == (NUM_BENCHMARK_SIBLING_ITEMS *
+                        (NUM_BENCHMARK_SIBLING_ITEMS - 1) / 2),
+             qnPrintable("Wrong rows of the child tag model items"));
+}
+
+void ModelTester::benchmarkNotebookModelItemRowForChild()
+{
+    using namespace quentier;
+
+    NotebookStackItem stackItem(QStringLiteral("Benchmark stack"));
+    NotebookModelItem parentItem(NotebookModelItem::Type::Stack, nullptr,
+                                 &stackItem);
+
+    // NOTE: vectors are not resized after this point so the pointers to their
+    // elements stay valid while the parent item refers to them
+    QVector<NotebookItem> notebookItems(NUM_BENCHMARK_SIBLING_ITEMS);
+    QVector<NotebookModelItem> modelItems(NUM_BENCHMARK_SIBLING_ITEMS);
+    for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i)
+    {
+        notebookItems[i].setLocalUid(UidGenerator::Generate());
+        notebookItems[i].setName(
+            QStringLiteral("Benchmark notebook %1").arg(i));
+        modelItems[i].setNotebookItem(&notebookItems[i]);
+
+        // Inserting the first item last to shift the rows of all others
+        if (i != 0) {
+            parentItem.addChild(&modelItems[i]);
+        }
+    }
+    parentItem.insertChild(0, &modelItems[0]);
+
+    for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i) {
+        QVERIFY2(parentItem.rowForChild(&modelItems[i]) == i,
+                 qnPrintable("Wrong row of the child notebook model item"));
+    }
+
+    int rowSum = 0;
+    QBENCHMARK
+    {
+        rowSum = 0;
+        for(int i = 0; i < NUM_BENCHMARK_SIBLING_ITEMS; ++i) {
+            rowSum += parentItem.rowForChild(&modelItems[i]);
+        }
+    }
+
+    QVERIFY2(rowSum == (NUM_BENCHMARK_SIBLING_ITEMS *
+                        (NUM_BENCHMARK_SIBLING_ITEMS - 1) / 2),
+             qnPrintable("Wrong rows of the child notebook model items"));
+}
+
+void ModelTester::setUpBenchmarkLocalStorage()
+{
+    using namespace quentier;
+
+    delete m_pLocalStorageManagerAsync;
+    Account account(
+        QStringLiteral("ModelTester_benchmark_fake_user"),
+        Account::Type::Evernote, 900);
+    LocalStorageManager::StartupOptions startupOptions(
+        LocalStorageManager::StartupOption::ClearDatabase);
+    m_pLocalStorageManagerAsync =
+        new quentier::LocalStorageManagerAsync(account, startupOptions, this);
+    m_pLocalStorageManagerAsync->init();
+
+    // NOTE: exploiting the direct connection used in the current test
+    // environment: after the following lines the local storage would be
+    // filled with the benchmark objects
+    Notebook notebook;
+    notebook.setName(QStringLiteral("Benchmark notebook"));
+    notebook.setLocal(true);
+    m_pLocalStorageManagerAsync->onAddNotebookRequest(notebook, QUuid());
+
+    QStringList tagLocalUids;
+    tagLocalUids.reserve(NUM_BENCHMARK_TAGS);
+    for(int i = 0; i < NUM_BENCHMARK_TAGS; ++i)
+    {
+        Tag tag;
+        tag.setName(QStringLiteral("Benchmark tag %1").arg(i));
+        tag.setLocal(true);
+        m_pLocalStorageManagerAsync->onAddTagRequest(tag, QUuid());
+        tagLocalUids << tag.localUid();
+    }
+
+    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+    for(int i = 0; i < NUM_BENCHMARK_NOTES; ++i)
+    {
+        Note note;
+        note.setTitle(QStringLiteral("Benchmark note %1").arg(i));
+        note.setContent(QStringLiteral("<en-note><h1>Benchmark note %1</h1>"
+                                       "<div>Some text</div></en-note>")
+                        .arg(i));
+        note.setCreationTimestamp(timestamp + i);
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setNotebookLocalUid(notebook.localUid());
+        note.setLocal(true);
+        note.setTagLocalUids(QStringList()
+                             << tagLocalUids[i % NUM_BENCHMARK_TAGS]
+                             << tagLocalUids[(i + 1) % NUM_BENCHMARK_TAGS]);
+        m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+    }
+}
+
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
@@ -38,6 +38,16 @@ private Q_SLOTS:
     void testFavoritesModel();
     void testTagModelItemSerialization();
 
+    void benchmarkNoteModelFetchMore();
+    void benchmarkNoteSummaries();
+    void benchmarkNoteModelNameColumns();
+    void benchmarkNoteFilters();
+    void benchmarkTagModelItemRowForChild();
+    void benchmarkNotebookModelItemRowForChild();
+
+private:
+    void setUpBenchmarkLocalStorage();
+
 private:
     quentier::LocalStorageManagerAsync *    m_pLocalStorageManagerAsync;
 };
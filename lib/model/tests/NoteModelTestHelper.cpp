@@ -26,6 +26,8 @@
 #include <quentier/utility/SysInfo.h>
 #include <quentier/exception/IQuentierException.h>
 
+#include <QSignalSpy>
+
 namespace quentier {
 
 NoteModelTestHelper::NoteModelTestHelper(
@@ -271,8 +273,46 @@ void NoteModelTestHelper::launchTest()
         NoteModel * model = new NoteModel(account, *m_pLocalStorageManagerAsync,
                                           noteCache, notebookCache, this,
                                           NoteModel::IncludedNotes::All);
+
+        QSignalSpy rowsInsertedSpy(
+            model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+        QSignalSpy rowsRemovedSpy(
+            model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
         model->start();
 
+        // The listed notes should be merged into the model in batches: each
+        // note should be inserted right at its sorted position without being
+        // appended and then moved to that position
+        if (!rowsRemovedSpy.isEmpty()) {
+            FAIL("Note model removed rows while merging the listed notes "
+                 "into the empty model");
+        }
+
+        int numInsertedRows = 0;
+        for(auto it = rowsInsertedSpy.constBegin(),
+            end = rowsInsertedSpy.constEnd(); it != end; ++it)
+        {
+            const QList<QVariant> & arguments = *it;
+            numInsertedRows +=
+                arguments.at(2).toInt() - arguments.at(1).toInt() + 1;
+        }
+
+        if (numInsertedRows != 6) {
+            FAIL("Unexpected number of rows inserted into the note model "
+                 << "from the notes listing: " << numInsertedRows
+                 << ", expected 6");
+        }
+
+        if (model->rowCount(QModelIndex()) != numInsertedRows) {
+            FAIL("The number of rows in the note model doesn't match "
+                 << "the number of inserted rows: "
+                 << model->rowCount(QModelIndex()) << ", expected "
+                 << numInsertedRows);
+        }
+
+        checkSorting(*model);
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
@@ -527,6 +567,10 @@ void NoteModelTestHelper::launchTest()
                 << NoteModel::Columns::Synchronizable
                 << NoteModel::Columns::Dirty;
 
+        int numRows = model->rowCount(QModelIndex());
+
+        QSignalSpy modelResetSpy(model, SIGNAL(modelReset()));
+
         int numColumns = columns.size();
         for(int i = 0; i < numColumns; ++i)
         {
@@ -539,6 +583,19 @@ void NoteModelTestHelper::launchTest()
             checkSorting(*model);
         }
 
+        // All notes are loaded so the loaded items should have been re-sorted
+        // in place
+        if (!modelResetSpy.isEmpty()) {
+            FAIL("Note model was reset on sorting while all notes "
+                 "were loaded into it");
+        }
+
+        if (model->rowCount(QModelIndex()) != numRows) {
+            FAIL("The number of rows in the note model has changed "
+                 << "on sorting: " << model->rowCount(QModelIndex())
+                 << ", expected " << numRows);
+        }
+
         m_model = model;
         m_firstNotebook = firstNotebook;
         m_noteToExpungeLocalUid = secondNote.localUid();
@@ -812,7 +869,7 @@ void NoteModelTestHelper::onExpungeNoteComplete(Note note, QUuid requestId)
                  "expunged from local storage");
         }
 
-        Q_EMIT success();
+        checkSortingReconciliation();
         return;
     }
     CATCH_EXCEPTION()
@@ -976,6 +1033,571 @@ void NoteModelTestHelper::checkSorting(const NoteModel & model)
     }
 }
 
+void NoteModelTestHelper::checkSortingReconciliation()
+{
+    QNDEBUG("NoteModelTestHelper::checkSortingReconciliation");
+
+    ErrorString errorDescription;
+
+    try
+    {
+        // Adding more notes than the note model loads at once: the oldest ones
+        // come last in title order while the newest ones come first
+        qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+        for(int i = 0; i < 60; ++i)
+        {
+            Note oldNote;
+            oldNote.setTitle(QStringLiteral("Z old note %1")
+                             .arg(i, 3, 10, QChar::fromLatin1('0')));
+            oldNote.setContent(
+                QStringLiteral("<en-note><h1>Old note</h1></en-note>"));
+            oldNote.setCreationTimestamp(1000 + i);
+            oldNote.setModificationTimestamp(oldNote.creationTimestamp());
+            oldNote.setNotebookLocalUid(m_firstNotebook.localUid());
+            oldNote.setLocal(true);
+            m_pLocalStorageManagerAsync->onAddNoteRequest(oldNote, QUuid());
+
+            Note newNote;
+            newNote.setTitle(QStringLiteral("A new note %1")
+                             .arg(i, 3, 10, QChar::fromLatin1('0')));
+            newNote.setContent(
+                QStringLiteral("<en-note><h1>New note</h1></en-note>"));
+            newNote.setCreationTimestamp(timestamp + 1000 + i);
+            newNote.setModificationTimestamp(newNote.creationTimestamp());
+            newNote.setNotebookLocalUid(m_firstNotebook.localUid());
+            newNote.setLocal(true);
+            m_pLocalStorageManagerAsync->onAddNoteRequest(newNote, QUuid());
+        }
+
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+        Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+        NoteModel * model = new NoteModel(account, *m_pLocalStorageManagerAsync,
+                                          noteCache, notebookCache, this);
+        model->start();
+
+        ModelTest t1(model);
+        Q_UNUSED(t1)
+
+        int numRows = model->rowCount(QModelIndex());
+        if (numRows != 60) {
+            FAIL("Unexpected number of rows in the note model with "
+                 << "partially loaded notes: " << numRows << ", expected 60");
+        }
+
+        for(int i = 0; i < numRows; ++i)
+        {
+            const NoteModelItem * item = model->itemAtRow(i);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Unexpected null pointer to the note model item");
+            }
+
+            if (!item->title().startsWith(QStringLiteral("Z old note"))) {
+                FAIL("Unexpected note loaded into the note model sorted "
+                     << "by modification time: " << item->title());
+            }
+        }
+
+        // Sorting by title should re-sort the loaded old notes in place and
+        // then replace them with the new notes which come first in title
+        // order, all without resetting the model
+        QSignalSpy modelResetSpy(model, SIGNAL(modelReset()));
+        QSignalSpy layoutChangedSpy(model, SIGNAL(layoutChanged()));
+
+        model->sort(NoteModel::Columns::Title, Qt::AscendingOrder);
+
+        if (!modelResetSpy.isEmpty()) {
+            FAIL("Note model was reset on sorting");
+        }
+
+        if (layoutChangedSpy.isEmpty()) {
+            FAIL("Note model didn't re-sort the loaded notes in place");
+        }
+
+        numRows = model->rowCount(QModelIndex());
+        if (numRows != 60) {
+            FAIL("Unexpected number of rows in the note model after "
+                 << "the reconciliation with the new sorting order: "
+                 << numRows << ", expected 60");
+        }
+
+        for(int i = 0; i < numRows; ++i)
+        {
+            const NoteModelItem * item = model->itemAtRow(i);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Unexpected null pointer to the note model item");
+            }
+
+            QString expectedTitle = QStringLiteral("A new note %1")
+                                    .arg(i, 3, 10, QChar::fromLatin1('0'));
+            if (item->title() != expectedTitle) {
+                FAIL("Unexpected note at row " << i << " of the note model "
+                     << "after the reconciliation with the new sorting "
+                     << "order: " << item->title() << ", expected "
+                     << expectedTitle);
+            }
+        }
+
+        model->stop(IStartable::StopMode::Forced);
+        model->deleteLater();
+
+        checkNoteCountsUpdates();
+        return;
+    }
+    CATCH_EXCEPTION()
+
+    Q_EMIT failure(errorDescription);
+}
+
+void NoteModelTestHelper::checkNoteCountsUpdates()
+{
+    QNDEBUG("NoteModelTestHelper::checkNoteCountsUpdates");
+
+    ErrorString errorDescription;
+
+    try
+    {
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+        Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+        NoteModel * model = new NoteModel(account, *m_pLocalStorageManagerAsync,
+                                          noteCache, notebookCache, this);
+        model->start();
+
+        ModelTest t1(model);
+        Q_UNUSED(t1)
+
+        qint32 accountNotesCount = model->totalAccountNotesCount();
+        qint32 filteredNotesCount = model->totalFilteredNotesCount();
+        if ((accountNotesCount <= model->rowCount(QModelIndex())) ||
+            (filteredNotesCount != accountNotesCount))
+        {
+            FAIL("Unexpected note counts in the note model without filters: "
+                 << "per account = " << accountNotesCount
+                 << ", filtered = " << filteredNotesCount
+                 << ", num loaded notes = " << model->rowCount(QModelIndex()));
+        }
+
+        // The counts should follow the added and expunged notes without
+        // requesting them from the local storage again
+        QSignalSpy getNoteCountSpy(
+            model, SIGNAL(getNoteCount(LocalStorageManager::NoteCountOptions,
+                                       QUuid)));
+        QSignalSpy noteCountPerAccountUpdatedSpy(
+            model, SIGNAL(noteCountPerAccountUpdated(qint32)));
+
+        Note note;
+        note.setTitle(QStringLiteral("Counted note"));
+        note.setContent(
+            QStringLiteral("<en-note><h1>Counted note</h1></en-note>"));
+        note.setCreationTimestamp(QDateTime::currentMSecsSinceEpoch());
+        note.setModificationTimestamp(note.creationTimestamp());
+        note.setNotebookLocalUid(m_firstNotebook.localUid());
+        note.setLocal(true);
+        m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+
+        if ((model->totalAccountNotesCount() != accountNotesCount + 1) ||
+            (model->totalFilteredNotesCount() != filteredNotesCount + 1))
+        {
+            FAIL("Note counts were not increased right after adding "
+                 << "the note: per account = "
+                 << model->totalAccountNotesCount() << ", filtered = "
+                 << model->totalFilteredNotesCount() << ", expected "
+                 << (accountNotesCount + 1));
+        }
+
+        const NoteModelItem * item = model->itemAtRow(0);
+        if (Q_UNLIKELY(!item)) {
+            FAIL("Unexpected null pointer to the note model item");
+        }
+
+        Note noteToExpunge;
+        noteToExpunge.setLocalUid(item->localUid());
+        m_pLocalStorageManagerAsync->onExpungeNoteRequest(
+            noteToExpunge, QUuid());
+
+        if ((model->totalAccountNotesCount() != accountNotesCount) ||
+            (model->totalFilteredNotesCount() != filteredNotesCount))
+        {
+            FAIL("Note counts were not decreased right after expunging "
+                 << "the loaded note: per account = "
+                 << model->totalAccountNotesCount() << ", filtered = "
+                 << model->totalFilteredNotesCount() << ", expected "
+                 << accountNotesCount);
+        }
+
+        if (!getNoteCountSpy.isEmpty()) {
+            FAIL("Note model requested the note count from the local storage "
+                 "on adding and expunging the note");
+        }
+
+        // The count notifications are coalesced so the two changes within
+        // the notification interval yield at most one signal
+        if (noteCountPerAccountUpdatedSpy.size() > 1) {
+            FAIL("Note model emitted " << noteCountPerAccountUpdatedSpy.size()
+                 << " note count notifications for two quick changes");
+        }
+
+        model->stop(IStartable::StopMode::Forced);
+        model->deleteLater();
+
+        checkBulkNoteOperations();
+        return;
+    }
+    CATCH_EXCEPTION()
+
+    Q_EMIT failure(errorDescription);
+}
+
+void NoteModelTestHelper::checkBulkNoteOperations()
+{
+    QNDEBUG("NoteModelTestHelper::checkBulkNoteOperations");
+
+    ErrorString errorDescription;
+
+    try
+    {
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+        Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+        NoteModel * model = new NoteModel(
+            account, *m_pLocalStorageManagerAsync, noteCache, notebookCache,
+            this, NoteModel::IncludedNotes::NonDeleted,
+            NoteModel::NoteSortingMode::TitleAscending);
+        model->start();
+
+        ModelTest t1(model);
+        Q_UNUSED(t1)
+
+        int numRows = model->rowCount(QModelIndex());
+        if (numRows < 3) {
+            FAIL("Too few rows in the note model to check bulk operations: "
+                 << numRows);
+        }
+
+        QStringList noteLocalUids;
+        for(int i = 0; i < 3; ++i)
+        {
+            const NoteModelItem * item = model->itemAtRow(i);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Unexpected null pointer to the note model item");
+            }
+
+            noteLocalUids << item->localUid();
+        }
+
+        // Should be able to favorite several notes at once
+        QSignalSpy updateNoteSpy(
+            model, SIGNAL(updateNote(Note,
+                                     LocalStorageManager::UpdateNoteOptions,
+                                     QUuid)));
+
+        bool res = model->favoriteNotes(noteLocalUids, errorDescription);
+        if (!res) {
+            FAIL("Can't favorite several notes at once: "
+                 << errorDescription.nonLocalizedString());
+        }
+
+        if (updateNoteSpy.size() != noteLocalUids.size()) {
+            FAIL("Unexpected number of note updates sent to the local storage "
+                 << "on favoriting several notes: " << updateNoteSpy.size()
+                 << ", expected " << noteLocalUids.size());
+        }
+
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            const NoteModelItem * item = model->itemForLocalUid(*it);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Can't find the favorited note's item in the note model "
+                     "by local uid");
+            }
+
+            if (!item->isFavorited()) {
+                FAIL("The note model item is not favorited after favoriting "
+                     "several notes at once");
+            }
+        }
+
+        // Should be able to tag and untag several notes at once
+        QString tagLocalUid;
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            const NoteModelItem * item = model->itemForLocalUid(*it);
+            if (item && !item->tagLocalUids().isEmpty()) {
+                tagLocalUid = item->tagLocalUids().front();
+                break;
+            }
+        }
+
+        if (tagLocalUid.isEmpty()) {
+            FAIL("None of notes to check bulk operations has tags");
+        }
+
+        res = model->tagNotes(noteLocalUids, tagLocalUid, errorDescription);
+        if (!res) {
+            FAIL("Can't tag several notes at once: "
+                 << errorDescription.nonLocalizedString());
+        }
+
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            const NoteModelItem * item = model->itemForLocalUid(*it);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Can't find the tagged note's item in the note model "
+                     "by local uid");
+            }
+
+            if (!item->hasTagLocalUid(tagLocalUid)) {
+                FAIL("The note model item has no tag after tagging several "
+                     "notes at once");
+            }
+        }
+
+        res = model->untagNotes(noteLocalUids, tagLocalUid, errorDescription);
+        if (!res) {
+            FAIL("Can't untag several notes at once: "
+                 << errorDescription.nonLocalizedString());
+        }
+
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            const NoteModelItem * item = model->itemForLocalUid(*it);
+            if (Q_UNLIKELY(!item)) {
+                FAIL("Can't find the untagged note's item in the note model "
+                     "by local uid");
+            }
+
+            if (item->hasTagLocalUid(tagLocalUid)) {
+                FAIL("The note model item still has the tag after untagging "
+                     "several notes at once");
+            }
+        }
+
+        // Should be able to move several notes to another notebook at once
+        QStringList notesToMoveLocalUids = noteLocalUids.mid(0, 2);
+        QString notebookName = QStringLiteral("Second notebook");
+        res = model->moveNotesToNotebook(notesToMoveLocalUids, notebookName,
+                                         errorDescription);
+        if (!res) {
+            FAIL("Can't move several notes to another notebook at once: "
+                 << errorDescription.nonLocalizedString());
+        }
+
+        for(auto it = notesToMoveLocalUids.constBegin(),
+            end = notesToMoveLocalUids.constEnd(); it != end; ++it)
+        {
+            QModelIndex itemIndex = model->indexForLocalUid(*it);
+            if (!itemIndex.isValid()) {
+                FAIL("Can't get the valid note model item index for "
+                     "the moved note");
+            }
+
+            itemIndex = model->index(itemIndex.row(),
+                                     NoteModel::Columns::NotebookName,
+                                     QModelIndex());
+            QVariant data = model->data(itemIndex, Qt::DisplayRole);
+            if (data.toString() != notebookName) {
+                FAIL("Unexpected notebook name of the moved note: "
+                     << data.toString() << ", expected " << notebookName);
+            }
+        }
+
+        // Should be able to delete several notes at once: the rows of deleted
+        // notes should be removed from the model of non-deleted notes right
+        // away, contiguous rows at once
+        qint32 accountNotesCount = model->totalAccountNotesCount();
+        int firstRow = model->indexForLocalUid(noteLocalUids.front()).row();
+        numRows = model->rowCount(QModelIndex());
+
+        QSignalSpy rowsRemovedSpy(
+            model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+        res = model->deleteNotes(noteLocalUids, errorDescription);
+        if (!res) {
+            FAIL("Can't delete several notes at once: "
+                 << errorDescription.nonLocalizedString());
+        }
+
+        if (rowsRemovedSpy.size() != 1) {
+            FAIL("Unexpected number of row removals on deleting notes "
+                 << "occupying contiguous rows: " << rowsRemovedSpy.size()
+                 << ", expected 1");
+        }
+
+        const QList<QVariant> & arguments = rowsRemovedSpy.front();
+        if ((arguments.at(1).toInt() != firstRow) ||
+            (arguments.at(2).toInt() != firstRow + noteLocalUids.size() - 1))
+        {
+            FAIL("Unexpected rows removed on deleting notes: from "
+                 << arguments.at(1).toInt() << " to " << arguments.at(2).toInt()
+                 << ", expected from " << firstRow << " to "
+                 << (firstRow + noteLocalUids.size() - 1));
+        }
+
+        if (model->rowCount(QModelIndex()) != numRows - noteLocalUids.size()) {
+            FAIL("Unexpected number of rows in the note model after "
+                 << "deleting notes: " << model->rowCount(QModelIndex())
+                 << ", expected " << (numRows - noteLocalUids.size()));
+        }
+
+        for(auto it = noteLocalUids.constBegin(),
+            end = noteLocalUids.constEnd(); it != end; ++it)
+        {
+            if (model->indexForLocalUid(*it).isValid()) {
+                FAIL("Was able to get the valid note model item index for "
+                     "the deleted note in the model of non-deleted notes");
+            }
+        }
+
+        if (model->totalAccountNotesCount() !=
+            accountNotesCount - noteLocalUids.size())
+        {
+            FAIL("Unexpected note count per account after deleting notes: "
+                 << model->totalAccountNotesCount() << ", expected "
+                 << (accountNotesCount - noteLocalUids.size()));
+        }
+
+        model->stop(IStartable::StopMode::Forced);
+        model->deleteLater();
+
+        checkMultipleRowsRemoval();
+        return;
+    }
+    CATCH_EXCEPTION()
+
+    Q_EMIT failure(errorDescription);
+}
+
+void NoteModelTestHelper::checkMultipleRowsRemoval()
+{
+    QNDEBUG("NoteModelTestHelper::checkMultipleRowsRemoval");
+
+    ErrorString errorDescription;
+
+    try
+    {
+        Notebook notebook;
+        notebook.setGuid(UidGenerator::Generate());
+        notebook.setName(QStringLiteral("Rows removal notebook"));
+        notebook.setLocal(false);
+        notebook.setDirty(false);
+        m_pLocalStorageManagerAsync->onAddNotebookRequest(notebook, QUuid());
+
+        // The notes modified earlier than any other note occupy the first
+        // rows of the model sorted by modification time: a local note,
+        // a synchronizable note and then two more local notes
+        QStringList noteLocalUids;
+        for(int i = 0; i < 4; ++i)
+        {
+            Note note;
+            note.setTitle(QStringLiteral("Rows removal note %1").arg(i));
+            note.setContent(QStringLiteral("<en-note><h1>Rows removal note "
+                                           "%1</h1></en-note>").arg(i));
+            note.setCreationTimestamp(i + 1);
+            note.setModificationTimestamp(i + 1);
+
+            if (i == 1)
+            {
+                note.setGuid(UidGenerator::Generate());
+                note.setNotebookLocalUid(notebook.localUid());
+                note.setNotebookGuid(notebook.guid());
+                note.setLocal(false);
+            }
+            else
+            {
+                note.setNotebookLocalUid(m_firstNotebook.localUid());
+                note.setLocal(true);
+            }
+
+            m_pLocalStorageManagerAsync->onAddNoteRequest(note, QUuid());
+            noteLocalUids << note.localUid();
+        }
+
+        NoteCache noteCache(20);
+        NotebookCache notebookCache(3);
+        Account account(QStringLiteral("Default name"), Account::Type::Local);
+
+        NoteModel * model = new NoteModel(
+            account, *m_pLocalStorageManagerAsync, noteCache, notebookCache,
+            this, NoteModel::IncludedNotes::NonDeleted,
+            NoteModel::NoteSortingMode::ModifiedAscending);
+        model->start();
+
+        ModelTest t1(model);
+        Q_UNUSED(t1)
+
+        for(int i = 0; i < noteLocalUids.size(); ++i)
+        {
+            if (model->indexForLocalUid(noteLocalUids[i]).row() != i) {
+                FAIL("Unexpected row of the note added for checking "
+                     << "the removal of multiple rows: "
+                     << model->indexForLocalUid(noteLocalUids[i]).row()
+                     << ", expected " << i);
+            }
+        }
+
+        int numRows = model->rowCount(QModelIndex());
+
+        // Should not be able to remove several rows if any of them but
+        // the first one corresponds to a note with non-empty guid
+        bool res = model->removeRows(0, 2, QModelIndex());
+        if (res) {
+            FAIL("Was able to remove several rows including the one "
+                 "corresponding to a note with non-empty guid which is not "
+                 "intended");
+        }
+
+        if (model->rowCount(QModelIndex()) != numRows) {
+            FAIL("The number of rows in the note model has changed after "
+                 "the failed attempt to remove several rows");
+        }
+
+        for(int i = 0; i < noteLocalUids.size(); ++i)
+        {
+            if (model->indexForLocalUid(noteLocalUids[i]).row() != i) {
+                FAIL("Note model returned item index with a different row "
+                     "after the failed attempt to remove several rows");
+            }
+        }
+
+        // Should be able to remove several rows corresponding to local notes
+        res = model->removeRows(2, 2, QModelIndex());
+        if (!res) {
+            FAIL("Can't remove several rows corresponding to local notes");
+        }
+
+        if (model->rowCount(QModelIndex()) != numRows - 2) {
+            FAIL("Unexpected number of rows in the note model after removing "
+                 << "several rows: " << model->rowCount(QModelIndex())
+                 << ", expected " << (numRows - 2));
+        }
+
+        for(int i = 2; i < noteLocalUids.size(); ++i)
+        {
+            if (model->indexForLocalUid(noteLocalUids[i]).isValid()) {
+                FAIL("Was able to get the valid note model item index for "
+                     "the note from the removed row");
+            }
+        }
+
+        model->stop(IStartable::StopMode::Forced);
+        model->deleteLater();
+
+        Q_EMIT success();
+        return;
+    }
+    CATCH_EXCEPTION()
+
+    Q_EMIT failure(errorDescription);
+}
+
 void NoteModelTestHelper::notifyFailureWithStackTrace(
     ErrorString errorDescription)
 {
@@ -83,6 +83,10 @@ private Q_SLOTS:
 
 private:
     void checkSorting(const NoteModel & model);
+    void checkSortingReconciliation();
+    void checkNoteCountsUpdates();
+    void checkBulkNoteOperations();
+    void checkMultipleRowsRemoval();
     void notifyFailureWithStackTrace(ErrorString errorDescription);
 
 private:
@@ -123,6 +123,24 @@ void SavedSearchModelTestHelper::test()
         ModelTest t1(model);
         Q_UNUSED(t1)
 
+        // The queries of listed saved searches should be parsed once loaded
+        int numRows = model->rowCount(QModelIndex());
+        for(int i = 0; i < numRows; ++i)
+        {
+            const SavedSearchModelItem * pItem =
+                model->itemForIndex(model->index(i, 0, QModelIndex()));
+            if (Q_UNLIKELY(!pItem)) {
+                FAIL("Unexpected null pointer to the saved search model item");
+            }
+
+            if (pItem->m_noteSearchQuery.isEmpty() ||
+                (pItem->m_noteSearchQuery.queryString() != pItem->m_query))
+            {
+                FAIL("The query of the listed saved search was not parsed: "
+                     << *pItem);
+            }
+        }
+
         // Should not be able to change the dirty flag manually
         QModelIndex secondIndex = model->indexForLocalUid(second.localUid());
         if (!secondIndex.isValid()) {
@@ -320,6 +338,20 @@ void SavedSearchModelTestHelper::test()
                  << ", expected " << newQuery);
         }
 
+        // The edited query should be parsed again
+        const SavedSearchModelItem * pSecondItem =
+            model->itemForIndex(secondIndex);
+        if (Q_UNLIKELY(!pSecondItem)) {
+            FAIL("Unexpected null pointer to the saved search model item");
+        }
+
+        if (pSecondItem->m_noteSearchQuery.queryString() != newQuery) {
+            FAIL("The parsed query of the saved search item doesn't match "
+                 << "the query just set to this item: "
+                 << pSecondItem->m_noteSearchQuery.queryString()
+                 << ", expected " << newQuery);
+        }
+
         // Should not be able to remove the row with a saved search with non-empty
         // guid
         res = model->removeRow(secondIndex.row(), QModelIndex());
@@ -35,7 +35,10 @@ TagModelTestHelper::TagModelTestHelper(
         LocalStorageManagerAsync * pLocalStorageManagerAsync,
         QObject * parent) :
     QObject(parent),
-    m_pLocalStorageManagerAsync(pLocalStorageManagerAsync)
+    m_pLocalStorageManagerAsync(pLocalStorageManagerAsync),
+    m_trackingTagModelResets(false),
+    m_tagModelResetCount(0),
+    m_tagModelRowCountBeforeListingComplete(-1)
 {
     QObject::connect(pLocalStorageManagerAsync,
                      QNSIGNAL(LocalStorageManagerAsync,addTagFailed,
@@ -75,6 +78,24 @@ TagModelTestHelper::TagModelTestHelper(
                      this,
                      QNSLOT(TagModelTestHelper,onExpungeTagFailed,
                             Tag,ErrorString,QUuid));
+
+    // NOTE: this connection is established before the tag model connects
+    // to the local storage so the helper gets each page of listed tags
+    // before the model
+    QObject::connect(pLocalStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,listTagsComplete,
+                              LocalStorageManager::ListObjectsOptions,
+                              size_t,size_t,
+                              LocalStorageManager::ListTagsOrder,
+                              LocalStorageManager::OrderDirection,
+                              QString,QList<Tag>,QUuid),
+                     this,
+                     QNSLOT(TagModelTestHelper,onListTagsComplete,
+                            LocalStorageManager::ListObjectsOptions,
+                            size_t,size_t,
+                            LocalStorageManager::ListTagsOrder,
+                            LocalStorageManager::OrderDirection,
+                            QString,QList<Tag>,QUuid));
 }
 
 void TagModelTestHelper::test()
@@ -191,6 +212,25 @@ void TagModelTestHelper::test()
 
         TagModel * model = new TagModel(account, *m_pLocalStorageManagerAsync,
                                         cache, this);
+
+        // The listed tags should be published at once after all of them
+        // have been listed
+        if (m_tagModelRowCountBeforeListingComplete != 0) {
+            FAIL("Tag model contained "
+                 << m_tagModelRowCountBeforeListingComplete
+                 << " rows before the listing of tags was complete");
+        }
+
+        if (m_tagModelResetCount != 1) {
+            FAIL("Tag model was reset " << m_tagModelResetCount
+                 << " times while building the tree of listed tags, "
+                 << "expected 1");
+        }
+
+        if (model->rowCount(QModelIndex()) == 0) {
+            FAIL("Tag model contains no rows after the listing of tags");
+        }
+
         ModelTest t1(model);
         Q_UNUSED(t1)
 
@@ -866,6 +906,48 @@ void TagModelTestHelper::onExpungeTagFailed(
     notifyFailureWithStackTrace(errorDescription);
 }
 
+void TagModelTestHelper::onListTagsComplete(
+    LocalStorageManager::ListObjectsOptions flag,
+    size_t limit, size_t offset,
+    LocalStorageManager::ListTagsOrder order,
+    LocalStorageManager::OrderDirection orderDirection,
+    QString linkedNotebookGuid, QList<Tag> tags, QUuid requestId)
+{
+    Q_UNUSED(flag)
+    Q_UNUSED(limit)
+    Q_UNUSED(order)
+    Q_UNUSED(orderDirection)
+    Q_UNUSED(linkedNotebookGuid)
+    Q_UNUSED(requestId)
+
+    // The tag model being constructed is already a child of the helper
+    TagModel * pModel = findChild<TagModel*>();
+    if (!pModel) {
+        return;
+    }
+
+    QNDEBUG("TagModelTestHelper::onListTagsComplete: offset = " << offset
+            << ", num found tags = " << tags.size());
+
+    if (!m_trackingTagModelResets) {
+        m_trackingTagModelResets = true;
+        QObject::connect(pModel, QNSIGNAL(TagModel,modelReset),
+                         this, QNSLOT(TagModelTestHelper,onTagModelReset));
+    }
+
+    // The empty page finishes the listing; the model hasn't got it yet
+    if (tags.isEmpty()) {
+        m_tagModelRowCountBeforeListingComplete =
+            pModel->rowCount(QModelIndex());
+    }
+}
+
+void TagModelTestHelper::onTagModelReset()
+{
+    QNDEBUG("TagModelTestHelper::onTagModelReset");
+    ++m_tagModelResetCount;
+}
+
 bool TagModelTestHelper::checkSorting(
     const TagModel & model, const TagModelItem * rootItem,
     ErrorString & errorDescription) const
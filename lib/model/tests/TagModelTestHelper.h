@@ -60,6 +60,15 @@ private Q_SLOTS:
     void onExpungeTagFailed(
         Tag tag, ErrorString errorDescription, QUuid requestId);
 
+    void onListTagsComplete(
+        LocalStorageManager::ListObjectsOptions flag,
+        size_t limit, size_t offset,
+        LocalStorageManager::ListTagsOrder order,
+        LocalStorageManager::OrderDirection orderDirection,
+        QString linkedNotebookGuid, QList<Tag> tags, QUuid requestId);
+
+    void onTagModelReset();
+
 private:
     bool checkSorting(
         const TagModel & model, const TagModelItem * rootItem,
@@ -81,6 +90,9 @@ private:
 
 private:
     LocalStorageManagerAsync *   m_pLocalStorageManagerAsync;
+    bool                         m_trackingTagModelResets;
+    int                          m_tagModelResetCount;
+    int                          m_tagModelRowCountBeforeListingComplete;
 };
 
 } // namespace quentier
@@ -59,6 +59,14 @@
 
 #define DEFAULT_RUN_SYNC_EACH_NUM_MINUTES (15)
 
+#define DEFAULT_NOTE_CACHE_MAX_SIZE_KB (32768)
+#define DEFAULT_NOTEBOOK_CACHE_MAX_SIZE_KB (1024)
+#define DEFAULT_TAG_CACHE_MAX_SIZE_KB (1024)
+#define DEFAULT_SAVED_SEARCH_CACHE_MAX_SIZE_KB (512)
+
+#define ITEM_CACHE_MIN_SIZE_KB (64)
+#define ITEM_CACHE_MAX_SIZE_KB (1048576)
+
 #ifdef WITH_UPDATE_MANAGER
 #define DEFAULT_CHECK_FOR_UPDATES (false)
 #define DEFAULT_CHECK_FOR_UPDATES_ON_STARTUP (true)
@@ -927,6 +927,33 @@ void PreferencesDialog::onEnableLogViewerInternalLogsCheckboxToggled(
     globalAppSettings.endGroup();
 }
 
+void PreferencesDialog::onNoteCacheMaxSizeChanged(int maxSizeKb)
+{
+    QNDEBUG("PreferencesDialog::onNoteCacheMaxSizeChanged: " << maxSizeKb);
+    saveItemCacheMaxSize(NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY, maxSizeKb);
+}
+
+void PreferencesDialog::onNotebookCacheMaxSizeChanged(int maxSizeKb)
+{
+    QNDEBUG("PreferencesDialog::onNotebookCacheMaxSizeChanged: "
+        << maxSizeKb);
+    saveItemCacheMaxSize(NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY, maxSizeKb);
+}
+
+void PreferencesDialog::onTagCacheMaxSizeChanged(int maxSizeKb)
+{
+    QNDEBUG("PreferencesDialog::onTagCacheMaxSizeChanged: " << maxSizeKb);
+    saveItemCacheMaxSize(TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY, maxSizeKb);
+}
+
+void PreferencesDialog::onSavedSearchCacheMaxSizeChanged(int maxSizeKb)
+{
+    QNDEBUG("PreferencesDialog::onSavedSearchCacheMaxSizeChanged: "
+        << maxSizeKb);
+    saveItemCacheMaxSize(SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY,
+                         maxSizeKb);
+}
+
 void PreferencesDialog::setupCurrentSettingsState(
     ActionsInfo & actionsInfo, ShortcutManager & shortcutManager)
 {
@@ -1029,6 +1056,8 @@ void PreferencesDialog::setupCurrentSettingsState(
 
     m_pUi->enableInternalLogViewerLogsCheckBox->setChecked(
         enableLogViewerInternalLogs);
+
+    setupItemCachesSettingsState();
 }
 
 void PreferencesDialog::setupSystemTraySettings()
@@ -1473,6 +1502,60 @@ void PreferencesDialog::setupNetworkProxySettingsState()
     m_pUi->networkProxyPasswordLineEdit->setText(proxyPassword);
 }
 
+void PreferencesDialog::setupItemCachesSettingsState()
+{
+    QNDEBUG("PreferencesDialog::setupItemCachesSettingsState");
+
+    Account currentAccount = m_accountManager.currentAccount();
+    ApplicationSettings appSettings(currentAccount,
+                                    QUENTIER_AUXILIARY_SETTINGS);
+    appSettings.beginGroup(ITEM_CACHES_SETTINGS_GROUP_NAME);
+
+    QVariant noteCacheMaxSizeData =
+        appSettings.value(NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY);
+    QVariant notebookCacheMaxSizeData =
+        appSettings.value(NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY);
+    QVariant tagCacheMaxSizeData =
+        appSettings.value(TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY);
+    QVariant savedSearchCacheMaxSizeData =
+        appSettings.value(SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY);
+
+    appSettings.endGroup();
+
+    struct SpinBoxData
+    {
+        QSpinBox *  m_pSpinBox;
+        QVariant    m_maxSizeData;
+        int         m_defaultMaxSizeKb;
+    };
+
+    SpinBoxData spinBoxes[] = {
+        { m_pUi->noteCacheMaxSizeSpinBox, noteCacheMaxSizeData,
+          DEFAULT_NOTE_CACHE_MAX_SIZE_KB },
+        { m_pUi->notebookCacheMaxSizeSpinBox, notebookCacheMaxSizeData,
+          DEFAULT_NOTEBOOK_CACHE_MAX_SIZE_KB },
+        { m_pUi->tagCacheMaxSizeSpinBox, tagCacheMaxSizeData,
+          DEFAULT_TAG_CACHE_MAX_SIZE_KB },
+        { m_pUi->savedSearchCacheMaxSizeSpinBox, savedSearchCacheMaxSizeData,
+          DEFAULT_SAVED_SEARCH_CACHE_MAX_SIZE_KB }
+    };
+
+    for(auto & spinBoxData: spinBoxes)
+    {
+        // The same fallback as the one MainWindow uses for invalid values
+        bool conversionResult = false;
+        int maxSizeKb = spinBoxData.m_maxSizeData.toInt(&conversionResult);
+        if (!conversionResult || (maxSizeKb <= 0)) {
+            maxSizeKb = spinBoxData.m_defaultMaxSizeKb;
+        }
+
+        spinBoxData.m_pSpinBox->setMinimum(ITEM_CACHE_MIN_SIZE_KB);
+        spinBoxData.m_pSpinBox->setMaximum(ITEM_CACHE_MAX_SIZE_KB);
+        spinBoxData.m_pSpinBox->setSingleStep(ITEM_CACHE_MIN_SIZE_KB);
+        spinBoxData.m_pSpinBox->setValue(maxSizeKb);
+    }
+}
+
 void PreferencesDialog::setupNoteEditorSettingsState()
 {
     QNDEBUG("PreferencesDialog::setupNoteEditorSettingsState");
@@ -1845,6 +1928,56 @@ void PreferencesDialog::createConnections()
         this,
         &PreferencesDialog::onEnableLogViewerInternalLogsCheckboxToggled);
 
+#if QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
+    QObject::connect(
+        m_pUi->noteCacheMaxSizeSpinBox,
+        qOverload<int>(&QSpinBox::valueChanged),
+        this,
+        &PreferencesDialog::onNoteCacheMaxSizeChanged);
+
+    QObject::connect(
+        m_pUi->notebookCacheMaxSizeSpinBox,
+        qOverload<int>(&QSpinBox::valueChanged),
+        this,
+        &PreferencesDialog::onNotebookCacheMaxSizeChanged);
+
+    QObject::connect(
+        m_pUi->tagCacheMaxSizeSpinBox,
+        qOverload<int>(&QSpinBox::valueChanged),
+        this,
+        &PreferencesDialog::onTagCacheMaxSizeChanged);
+
+    QObject::connect(
+        m_pUi->savedSearchCacheMaxSizeSpinBox,
+        qOverload<int>(&QSpinBox::valueChanged),
+        this,
+        &PreferencesDialog::onSavedSearchCacheMaxSizeChanged);
+#else
+    QObject::connect(
+        m_pUi->noteCacheMaxSizeSpinBox,
+        SIGNAL(valueChanged(int)),
+        this,
+        SLOT(onNoteCacheMaxSizeChanged(int)));
+
+    QObject::connect(
+        m_pUi->notebookCacheMaxSizeSpinBox,
+        SIGNAL(valueChanged(int)),
+        this,
+        SLOT(onNotebookCacheMaxSizeChanged(int)));
+
+    QObject::connect(
+        m_pUi->tagCacheMaxSizeSpinBox,
+        SIGNAL(valueChanged(int)),
+        this,
+        SLOT(onTagCacheMaxSizeChanged(int)));
+
+    QObject::connect(
+        m_pUi->savedSearchCacheMaxSizeSpinBox,
+        SIGNAL(valueChanged(int)),
+        this,
+        SLOT(onSavedSearchCacheMaxSizeChanged(int)));
+#endif
+
     QObject::connect(
         m_pUi->panelColorsHandlerWidget,
         &PanelColorsHandlerWidget::fontColorChanged,
@@ -1886,6 +2019,19 @@ void PreferencesDialog::installEventFilters()
     m_pUi->noteEditorHighlightedTextColorDemoFrame->installEventFilter(this);
 }
 
+void PreferencesDialog::saveItemCacheMaxSize(
+    const QString & settingsKey, const int maxSizeKb)
+{
+    Account currentAccount = m_accountManager.currentAccount();
+    ApplicationSettings appSettings(currentAccount,
+                                    QUENTIER_AUXILIARY_SETTINGS);
+    appSettings.beginGroup(ITEM_CACHES_SETTINGS_GROUP_NAME);
+    appSettings.setValue(settingsKey, maxSizeKb);
+    appSettings.endGroup();
+
+    Q_EMIT itemCachesMaxSizesChanged();
+}
+
 void PreferencesDialog::checkAndSetNetworkProxy()
 {
     QNDEBUG("PreferencesDialog::checkAndSetNetworkProxy");
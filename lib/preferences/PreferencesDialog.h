@@ -71,6 +71,7 @@ Q_SIGNALS:
     void showNoteThumbnailsOptionChanged();
     void disableNativeMenuBarOptionChanged();
     void runSyncPeriodicallyOptionChanged(int runSyncEachNumMinutes);
+    void itemCachesMaxSizesChanged();
 
     void iconThemeChanged(const QString & iconTheme);
 
@@ -154,6 +155,10 @@ private Q_SLOTS:
 
     // Auxiliary tab
     void onEnableLogViewerInternalLogsCheckboxToggled(bool checked);
+    void onNoteCacheMaxSizeChanged(int maxSizeKb);
+    void onNotebookCacheMaxSizeChanged(int maxSizeKb);
+    void onTagCacheMaxSizeChanged(int maxSizeKb);
+    void onSavedSearchCacheMaxSizeChanged(int maxSizeKb);
 
 private:
     virtual bool eventFilter(QObject * pObject, QEvent * pEvent) override;
@@ -170,11 +175,14 @@ private:
     void setupAppearanceSettingsState(const ActionsInfo & actionsInfo);
     void setupNetworkProxySettingsState();
     void setupNoteEditorSettingsState();
+    void setupItemCachesSettingsState();
     void createConnections();
     void installEventFilters();
 
     void checkAndSetNetworkProxy();
 
+    void saveItemCacheMaxSize(const QString & settingsKey, const int maxSizeKb);
+
     bool onNoteEditorColorEnteredImpl(
         const QColor & color, const QColor & prevColor,
         const QString & settingKey, QLineEdit & colorLineEdit,
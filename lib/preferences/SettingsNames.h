@@ -318,4 +318,25 @@
     QStringLiteral("SynchronizationNetworkProxyPassword")                      \
 // SYNCHRONIZATION_NETWORK_PROXY_PASSWORD
 
+////////////////////////////////////////////////////////////////////////////////
+
+// Item caches related settings keys
+#define ITEM_CACHES_SETTINGS_GROUP_NAME QStringLiteral("ItemCaches")
+
+#define NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY                                    \
+    QStringLiteral("NoteCacheMaxSizeKb")                                       \
+// NOTE_CACHE_MAX_SIZE_KB_SETTINGS_KEY
+
+#define NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY                                \
+    QStringLiteral("NotebookCacheMaxSizeKb")                                   \
+// NOTEBOOK_CACHE_MAX_SIZE_KB_SETTINGS_KEY
+
+#define TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY                                     \
+    QStringLiteral("TagCacheMaxSizeKb")                                        \
+// TAG_CACHE_MAX_SIZE_KB_SETTINGS_KEY
+
+#define SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY                            \
+    QStringLiteral("SavedSearchCacheMaxSizeKb")                                \
+// SAVED_SEARCH_CACHE_MAX_SIZE_KB_SETTINGS_KEY
+
 #endif // QUENTIER_LIB_PREFERENCES_SETTINGS_NAMES_H
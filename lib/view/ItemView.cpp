@@ -89,4 +89,32 @@ QModelIndex ItemView::singleRow(
     return model.index(sourceIndex.row(), column, sourceIndex.parent());
 }
 
+void ItemView::setItemsExpanded(const QModelIndexList & indexes)
+{
+    QNDEBUG("ItemView::setItemsExpanded: " << indexes.size() << " indexes");
+
+    if (indexes.isEmpty()) {
+        return;
+    }
+
+    /**
+     * While the delayed layout is pending, QTreeView only records the expanded
+     * indexes instead of laying out the items below each expanded one so
+     * the whole tree is laid out once after all the items have been expanded
+     */
+    scheduleDelayedItemsLayout();
+
+    for(auto it = indexes.constBegin(), end = indexes.constEnd(); it != end; ++it)
+    {
+        const QModelIndex & index = *it;
+        if (Q_UNLIKELY(!index.isValid())) {
+            continue;
+        }
+
+        setExpanded(index, true);
+    }
+
+    executeDelayedItemsLayout();
+}
+
 } // namespace quentier
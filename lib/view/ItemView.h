@@ -58,6 +58,16 @@ protected:
     QModelIndex singleRow(
         const QModelIndexList & indexes, const QAbstractItemModel & model,
         const int column) const;
+
+    /**
+     * @brief setItemsExpanded - expands all the items pointed to by
+     * the indexes with a single layout of the tree instead of laying out
+     * the items after each expansion
+     *
+     * @param indexes       The indexes of the items to be expanded; invalid
+     *                      indexes are skipped
+     */
+    void setItemsExpanded(const QModelIndexList & indexes);
 };
 
 } // namespace quentier
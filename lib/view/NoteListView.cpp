@@ -18,10 +18,12 @@
 
 #include "NoteListView.h"
 #include "NotebookItemView.h"
+#include "TagItemView.h"
 
 #include <lib/model/NoteModel.h>
 #include <lib/model/NotebookModel.h>
 #include <lib/model/NotebookItem.h>
+#include <lib/model/TagModel.h>
 
 #include <quentier/logging/QuentierLogger.h>
 
@@ -29,6 +31,7 @@
 #include <QItemSelectionModel>
 #include <QMenu>
 #include <QMouseEvent>
+#include <QResizeEvent>
 #include <QTimer>
 
 #include <iterator>
@@ -47,6 +50,7 @@ NoteListView::NoteListView(QWidget * parent) :
     QListView(parent),
     m_pNoteItemContextMenu(nullptr),
     m_pNotebookItemView(nullptr),
+    m_pTagItemView(nullptr),
     m_shouldSelectFirstNoteOnNextNoteAddition(false),
     m_currentAccount(),
     m_lastCurrentNoteLocalUid()
@@ -58,6 +62,12 @@ void NoteListView::setNotebookItemView(NotebookItemView * pNotebookItemView)
     m_pNotebookItemView = pNotebookItemView;
 }
 
+void NoteListView::setTagItemView(TagItemView * pTagItemView)
+{
+    QNTRACE("NoteListView::setTagItemView");
+    m_pTagItemView = pTagItemView;
+}
+
 void NoteListView::setAutoSelectNoteOnNextAddition()
 {
     QNTRACE("NoteListView::setAutoSelectNoteOnNextAddition");
@@ -239,6 +249,10 @@ void NoteListView::rowsInserted(const QModelIndex & parent, int start, int end)
 
     QListView::rowsInserted(parent, start, end);
 
+    if (start == 0) {
+        updateNoteModelViewportRowCount();
+    }
+
     if (Q_UNLIKELY(m_shouldSelectFirstNoteOnNextNoteAddition))
     {
         m_shouldSelectFirstNoteOnNextNoteAddition = false;
@@ -421,6 +435,179 @@ void NoteListView::onFavoriteAction()
     }
 }
 
+void NoteListView::onDeleteNotesAction()
+{
+    QNDEBUG("NoteListView::onDeleteNotesAction");
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (Q_UNLIKELY(noteLocalUids.isEmpty())) {
+        REPORT_ERROR(QT_TR_NOOP("Can't delete notes: internal error, "
+                                "the list of local uids of notes to be deleted "
+                                "is empty"));
+        return;
+    }
+
+    ErrorString error;
+    if (!pNoteModel->deleteNotes(noteLocalUids, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't delete notes: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
+void NoteListView::onMoveNotesToOtherNotebookAction()
+{
+    QNTRACE("NoteListView::onMoveNotesToOtherNotebookAction");
+
+    // The last element of action data is the name of the target notebook,
+    // the preceding ones are the local uids of notes to be moved
+    QStringList actionData = actionDataStringList();
+    if (actionData.size() < 2) {
+        REPORT_ERROR(QT_TR_NOOP("Can't move notes to another notebook: "
+                                "internal error, wrong action data"));
+        return;
+    }
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QString notebookName = actionData.takeLast();
+
+    ErrorString error;
+    if (!pNoteModel->moveNotesToNotebook(actionData, notebookName, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't move notes to another "
+                                                "notebook: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
+void NoteListView::onUnfavoriteNotesAction()
+{
+    QNDEBUG("NoteListView::onUnfavoriteNotesAction");
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    ErrorString error;
+    if (!pNoteModel->unfavoriteNotes(noteLocalUids, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't unfavorite notes: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
+void NoteListView::onFavoriteNotesAction()
+{
+    QNDEBUG("NoteListView::onFavoriteNotesAction");
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QStringList noteLocalUids = actionDataStringList();
+    if (noteLocalUids.isEmpty()) {
+        return;
+    }
+
+    ErrorString error;
+    if (!pNoteModel->favoriteNotes(noteLocalUids, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't favorite notes: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
+void NoteListView::onTagNotesAction()
+{
+    QNDEBUG("NoteListView::onTagNotesAction");
+
+    // The last element of action data is the local uid of the tag,
+    // the preceding ones are the local uids of notes to be tagged
+    QStringList actionData = actionDataStringList();
+    if (actionData.size() < 2) {
+        REPORT_ERROR(QT_TR_NOOP("Can't tag notes: internal error, wrong "
+                                "action data"));
+        return;
+    }
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QString tagLocalUid = actionData.takeLast();
+
+    ErrorString error;
+    if (!pNoteModel->tagNotes(actionData, tagLocalUid, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't tag notes: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
+void NoteListView::onUntagNotesAction()
+{
+    QNDEBUG("NoteListView::onUntagNotesAction");
+
+    // The last element of action data is the local uid of the tag,
+    // the preceding ones are the local uids of notes to be untagged
+    QStringList actionData = actionDataStringList();
+    if (actionData.size() < 2) {
+        REPORT_ERROR(QT_TR_NOOP("Can't remove tag from notes: internal error, "
+                                "wrong action data"));
+        return;
+    }
+
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    QString tagLocalUid = actionData.takeLast();
+
+    ErrorString error;
+    if (!pNoteModel->untagNotes(actionData, tagLocalUid, error)) {
+        ErrorString errorDescription(QT_TR_NOOP("Can't remove tag from "
+                                                "notes: "));
+        errorDescription.appendBase(error.base());
+        errorDescription.appendBase(error.additionalBases());
+        errorDescription.details() = error.details();
+        QNWARNING(errorDescription);
+        Q_EMIT notifyError(errorDescription);
+    }
+}
+
 void NoteListView::onShowNoteInfoAction()
 {
     QNDEBUG("NoteListView::onShowNoteInfoAction");
@@ -606,6 +793,43 @@ void NoteListView::showContextMenuAtPoint(
     }
 }
 
+void NoteListView::updateNoteModelViewportRowCount()
+{
+    NoteModel * pNoteModel = qobject_cast<NoteModel*>(model());
+    if (!pNoteModel || (pNoteModel->rowCount() == 0)) {
+        return;
+    }
+
+    int rowHeight = sizeHintForRow(0);
+    if (rowHeight <= 0) {
+        return;
+    }
+
+    int rowCount = viewport()->height() / rowHeight + 1;
+    QNTRACE("NoteListView::updateNoteModelViewportRowCount: " << rowCount);
+    pNoteModel->setViewportRowCount(rowCount);
+}
+
+void NoteListView::updateNoteModelVisibleRowRange()
+{
+    NoteModel * pNoteModel = qobject_cast<NoteModel*>(model());
+    if (!pNoteModel || !pNoteModel->isWindowedMode()) {
+        return;
+    }
+
+    int numRows = pNoteModel->rowCount();
+    if (numRows == 0) {
+        return;
+    }
+
+    QModelIndex firstIndex = indexAt(QPoint(0, 0));
+    QModelIndex lastIndex = indexAt(QPoint(0, viewport()->height() - 1));
+
+    int firstRow = (firstIndex.isValid() ? firstIndex.row() : 0);
+    int lastRow = (lastIndex.isValid() ? lastIndex.row() : (numRows - 1));
+    pNoteModel->setVisibleRowRange(firstRow, lastRow);
+}
+
 #define ADD_CONTEXT_MENU_ACTION(name, menu, slot, data, enabled)               \
     {                                                                          \
         QAction * pAction = new QAction(name, menu);                           \
@@ -691,54 +915,8 @@ void NoteListView::showSingleNoteContextMenu(
         pNotebookItem->linkedNotebookGuid().isEmpty() && canUpdateNotes)
     {
         QStringList otherNotebookNames =
-            pNotebookModel->notebookNames(
-                NotebookModel::NotebookFilters(
-                    NotebookModel::NotebookFilter::CanCreateNotes));
-        const QString & notebookName = pNotebookItem->name();
-        auto it = std::lower_bound(otherNotebookNames.constBegin(),
-                                   otherNotebookNames.constEnd(),
-                                   notebookName);
-        if ((it != otherNotebookNames.constEnd()) && (*it == notebookName))
-        {
-            int offset = static_cast<int>(
-                std::distance(otherNotebookNames.constBegin(), it));
-            QStringList::iterator nit = otherNotebookNames.begin() + offset;
-            Q_UNUSED(otherNotebookNames.erase(nit))
-        }
-
-        // Need to filter out other notebooks which prohibit the creation of
-        // notes in them as moving the note from one notebook to another involves
-        // modifying the original notebook's note and the "creation" of a note
-        // in another notebook
-        for(auto it = otherNotebookNames.begin(); it != otherNotebookNames.end(); )
-        {
-            QModelIndex notebookItemIndex = pNotebookModel->indexForNotebookName(*it);
-            if (Q_UNLIKELY(!notebookItemIndex.isValid())) {
-                it = otherNotebookNames.erase(it);
-                continue;
-            }
-
-            const NotebookModelItem * pNotebookModelItem =
-                pNotebookModel->itemForIndex(notebookItemIndex);
-            if (Q_UNLIKELY(!pNotebookModelItem)) {
-                it = otherNotebookNames.erase(it);
-                continue;
-            }
-
-            const NotebookItem * pOtherNotebookItem =
-                pNotebookModelItem->notebookItem();
-            if (Q_UNLIKELY(!pOtherNotebookItem)) {
-                it = otherNotebookNames.erase(it);
-                continue;
-            }
-
-            if (!pOtherNotebookItem->canCreateNotes()) {
-                it = otherNotebookNames.erase(it);
-                continue;
-            }
-
-            ++it;
-        }
+            targetNotebookNamesForMovingNotes(*pNotebookModel,
+                                              pNotebookItem->name());
 
         if (!otherNotebookNames.isEmpty())
         {
@@ -815,9 +993,183 @@ void NoteListView::showMultipleNotesContextMenu(
 {
     QNDEBUG("NoteListView::showMultipleNotesContextMenu");
 
+    NoteModel * pNoteModel = noteModel();
+    if (Q_UNLIKELY(!pNoteModel)) {
+        return;
+    }
+
+    const NotebookModel * pNotebookModel =
+        (m_pNotebookItemView
+         ? qobject_cast<const NotebookModel*>(m_pNotebookItemView->model())
+         : nullptr);
+
+    const TagModel * pTagModel =
+        (m_pTagItemView
+         ? qobject_cast<const TagModel*>(m_pTagItemView->model())
+         : nullptr);
+
+    bool canUpdateNotes = (pNotebookModel != nullptr);
+    bool fromLinkedNotebook = false;
+    bool hasFavoritedNotes = false;
+    bool hasUnfavoritedNotes = false;
+    QSet<QString> notebookLocalUids;
+    QSet<QString> tagLocalUids;
+
+    for(auto it = noteLocalUids.constBegin(),
+        end = noteLocalUids.constEnd(); it != end; ++it)
+    {
+        const NoteModelItem * pItem = pNoteModel->itemForLocalUid(*it);
+        if (Q_UNLIKELY(!pItem)) {
+            QNWARNING("Can't find the selected note within the model: "
+                      << *it);
+            canUpdateNotes = false;
+            continue;
+        }
+
+        if (pItem->isFavorited()) {
+            hasFavoritedNotes = true;
+        }
+        else {
+            hasUnfavoritedNotes = true;
+        }
+
+        Q_UNUSED(notebookLocalUids.insert(pItem->notebookLocalUid()))
+
+        const QStringList & itemTagLocalUids = pItem->tagLocalUids();
+        for(auto tit = itemTagLocalUids.constBegin(),
+            tend = itemTagLocalUids.constEnd(); tit != tend; ++tit)
+        {
+            Q_UNUSED(tagLocalUids.insert(*tit))
+        }
+    }
+
+    QString commonNotebookName;
+    for(auto it = notebookLocalUids.constBegin(),
+        end = notebookLocalUids.constEnd();
+        canUpdateNotes && (it != end); ++it)
+    {
+        QModelIndex notebookIndex = pNotebookModel->indexForLocalUid(*it);
+        const NotebookModelItem * pNotebookModelItem =
+            pNotebookModel->itemForIndex(notebookIndex);
+        const NotebookItem * pNotebookItem =
+            ((pNotebookModelItem &&
+              (pNotebookModelItem->type() == NotebookModelItem::Type::Notebook))
+             ? pNotebookModelItem->notebookItem()
+             : nullptr);
+        if (!pNotebookItem || !pNotebookItem->canUpdateNotes()) {
+            canUpdateNotes = false;
+            break;
+        }
+
+        if (!pNotebookItem->linkedNotebookGuid().isEmpty()) {
+            fromLinkedNotebook = true;
+        }
+
+        if (notebookLocalUids.size() == 1) {
+            commonNotebookName = pNotebookItem->name();
+        }
+    }
+
     delete m_pNoteItemContextMenu;
     m_pNoteItemContextMenu = new QMenu(this);
 
+    ADD_CONTEXT_MENU_ACTION(tr("Delete"), m_pNoteItemContextMenu,
+                            onDeleteNotesAction, noteLocalUids,
+                            canUpdateNotes);
+
+    if (canUpdateNotes && !fromLinkedNotebook)
+    {
+        QStringList otherNotebookNames =
+            targetNotebookNamesForMovingNotes(*pNotebookModel,
+                                              commonNotebookName);
+        if (!otherNotebookNames.isEmpty())
+        {
+            QMenu * pTargetNotebooksSubMenu =
+                m_pNoteItemContextMenu->addMenu(tr("Move to notebook"));
+            for(auto it = otherNotebookNames.constBegin(),
+                end = otherNotebookNames.constEnd(); it != end; ++it)
+            {
+                QStringList data = noteLocalUids;
+                data << *it;
+                ADD_CONTEXT_MENU_ACTION(*it, pTargetNotebooksSubMenu,
+                                        onMoveNotesToOtherNotebookAction,
+                                        data, true);
+            }
+        }
+    }
+
+    // The tags from linked notebooks can't be assigned to notes from user's
+    // own account and vice versa so the notes from linked notebooks are only
+    // offered the removal of their tags
+    if (canUpdateNotes && pTagModel && !fromLinkedNotebook)
+    {
+        QStringList tagNames = pTagModel->tagNames(QStringLiteral(""));
+        if (!tagNames.isEmpty())
+        {
+            QMenu * pTagsSubMenu =
+                m_pNoteItemContextMenu->addMenu(tr("Add tag"));
+            for(auto it = tagNames.constBegin(),
+                end = tagNames.constEnd(); it != end; ++it)
+            {
+                QString tagLocalUid =
+                    pTagModel->localUidForItemName(*it, QString());
+                if (Q_UNLIKELY(tagLocalUid.isEmpty())) {
+                    continue;
+                }
+
+                QStringList data = noteLocalUids;
+                data << tagLocalUid;
+                ADD_CONTEXT_MENU_ACTION(*it, pTagsSubMenu, onTagNotesAction,
+                                        data, true);
+            }
+        }
+    }
+
+    if (canUpdateNotes && pTagModel && !tagLocalUids.isEmpty())
+    {
+        QStringList tagNames;
+        QHash<QString, QString> tagLocalUidsByName;
+        for(auto it = tagLocalUids.constBegin(),
+            end = tagLocalUids.constEnd(); it != end; ++it)
+        {
+            QString tagName = pTagModel->itemNameForLocalUid(*it);
+            if (tagName.isEmpty()) {
+                continue;
+            }
+
+            tagNames << tagName;
+            tagLocalUidsByName[tagName] = *it;
+        }
+
+        if (!tagNames.isEmpty())
+        {
+            tagNames.sort(Qt::CaseInsensitive);
+
+            QMenu * pTagsSubMenu =
+                m_pNoteItemContextMenu->addMenu(tr("Remove tag"));
+            for(auto it = tagNames.constBegin(),
+                end = tagNames.constEnd(); it != end; ++it)
+            {
+                QStringList data = noteLocalUids;
+                data << tagLocalUidsByName.value(*it);
+                ADD_CONTEXT_MENU_ACTION(*it, pTagsSubMenu, onUntagNotesAction,
+                                        data, true);
+            }
+        }
+    }
+
+    if (hasFavoritedNotes) {
+        ADD_CONTEXT_MENU_ACTION(tr("Unfavorite"), m_pNoteItemContextMenu,
+                                onUnfavoriteNotesAction, noteLocalUids, true);
+    }
+
+    if (hasUnfavoritedNotes) {
+        ADD_CONTEXT_MENU_ACTION(tr("Favorite"), m_pNoteItemContextMenu,
+                                onFavoriteNotesAction, noteLocalUids, true);
+    }
+
+    m_pNoteItemContextMenu->addSeparator();
+
     ADD_CONTEXT_MENU_ACTION(tr("Export to enex") + QStringLiteral("..."),
                             m_pNoteItemContextMenu,
                             onExportSeveralNotesToEnexAction,
@@ -827,6 +1179,66 @@ void NoteListView::showMultipleNotesContextMenu(
     m_pNoteItemContextMenu->exec(globalPos);
 }
 
+QStringList NoteListView::targetNotebookNamesForMovingNotes(
+    const NotebookModel & notebookModel,
+    const QString & excludedNotebookName) const
+{
+    QStringList notebookNames =
+        notebookModel.notebookNames(
+            NotebookModel::NotebookFilters(
+                NotebookModel::NotebookFilter::CanCreateNotes));
+
+    if (!excludedNotebookName.isEmpty())
+    {
+        auto it = std::lower_bound(notebookNames.constBegin(),
+                                   notebookNames.constEnd(),
+                                   excludedNotebookName);
+        if ((it != notebookNames.constEnd()) && (*it == excludedNotebookName))
+        {
+            int offset = static_cast<int>(
+                std::distance(notebookNames.constBegin(), it));
+            QStringList::iterator nit = notebookNames.begin() + offset;
+            Q_UNUSED(notebookNames.erase(nit))
+        }
+    }
+
+    // Need to filter out other notebooks which prohibit the creation of
+    // notes in them as moving the note from one notebook to another involves
+    // modifying the original notebook's note and the "creation" of a note
+    // in another notebook
+    for(auto it = notebookNames.begin(); it != notebookNames.end(); )
+    {
+        QModelIndex notebookItemIndex = notebookModel.indexForNotebookName(*it);
+        if (Q_UNLIKELY(!notebookItemIndex.isValid())) {
+            it = notebookNames.erase(it);
+            continue;
+        }
+
+        const NotebookModelItem * pNotebookModelItem =
+            notebookModel.itemForIndex(notebookItemIndex);
+        if (Q_UNLIKELY(!pNotebookModelItem)) {
+            it = notebookNames.erase(it);
+            continue;
+        }
+
+        const NotebookItem * pOtherNotebookItem =
+            pNotebookModelItem->notebookItem();
+        if (Q_UNLIKELY(!pOtherNotebookItem)) {
+            it = notebookNames.erase(it);
+            continue;
+        }
+
+        if (!pOtherNotebookItem->canCreateNotes()) {
+            it = notebookNames.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+
+    return notebookNames;
+}
+
 void NoteListView::currentChanged(
     const QModelIndex & current, const QModelIndex & previous)
 {
@@ -874,6 +1286,22 @@ void NoteListView::mousePressEvent(QMouseEvent * pEvent)
     }
 }
 
+void NoteListView::resizeEvent(QResizeEvent * pEvent)
+{
+    QListView::resizeEvent(pEvent);
+    updateNoteModelViewportRowCount();
+    updateNoteModelVisibleRowRange();
+}
+
+void NoteListView::scrollContentsBy(int dx, int dy)
+{
+    QListView::scrollContentsBy(dx, dy);
+
+    if (dy != 0) {
+        updateNoteModelVisibleRowRange();
+    }
+}
+
 const NotebookItem * NoteListView::currentNotebookItem()
 {
     QNDEBUG("NoteListView::currentNotebookItem");
@@ -30,8 +30,10 @@ QT_FORWARD_DECLARE_CLASS(QMenu)
 namespace quentier {
 
 QT_FORWARD_DECLARE_CLASS(NotebookItemView)
+QT_FORWARD_DECLARE_CLASS(TagItemView)
 QT_FORWARD_DECLARE_CLASS(NotebookItem)
 QT_FORWARD_DECLARE_CLASS(NoteModel)
+QT_FORWARD_DECLARE_CLASS(NotebookModel)
 
 /**
  * @brief The NoteListView is a simple subclass of QListView which adds some
@@ -44,6 +46,7 @@ public:
     explicit NoteListView(QWidget * parent = nullptr);
 
     void setNotebookItemView(NotebookItemView * pNotebookItemView);
+    void setTagItemView(TagItemView * pTagItemView);
 
     /**
      * After this method is called, NoteListView would automatically select
@@ -135,6 +138,14 @@ protected Q_SLOTS:
     void onUnfavoriteAction();
     void onFavoriteAction();
 
+    // Actions of the context menu for several selected notes
+    void onDeleteNotesAction();
+    void onMoveNotesToOtherNotebookAction();
+    void onUnfavoriteNotesAction();
+    void onFavoriteNotesAction();
+    void onTagNotesAction();
+    void onUntagNotesAction();
+
     void onShowNoteInfoAction();
     void onCopyInAppNoteLinkAction();
 
@@ -158,6 +169,8 @@ protected:
         const QModelIndex & previous) override;
 
     virtual void mousePressEvent(QMouseEvent * pEvent) override;
+    virtual void resizeEvent(QResizeEvent * pEvent) override;
+    virtual void scrollContentsBy(int dx, int dy) override;
 
     const NotebookItem * currentNotebookItem();
 
@@ -171,6 +184,27 @@ protected:
     void showMultipleNotesContextMenu(
         const QPoint & globalPos, const QStringList & noteLocalUids);
 
+    /**
+     * @return      Sorted names of notebooks into which notes can be moved,
+     *              excluding the notebook with the specified name
+     */
+    QStringList targetNotebookNamesForMovingNotes(
+        const NotebookModel & notebookModel,
+        const QString & excludedNotebookName) const;
+
+    /**
+     * Lets the note model know how many rows fit into the viewport so that
+     * the model can size its lazy loading batches accordingly
+     */
+    void updateNoteModelViewportRowCount();
+
+    /**
+     * Lets the note model know which rows are currently visible so that
+     * the model working in the sliding window mode can evict the items far
+     * from the visible ones and rehydrate the ones getting close to them
+     */
+    void updateNoteModelVisibleRowRange();
+
 private:
     /**
      * @return current model as note filter model.
@@ -201,6 +235,7 @@ private:
 protected:
     QMenu *             m_pNoteItemContextMenu;
     NotebookItemView *  m_pNotebookItemView;
+    TagItemView *       m_pTagItemView;
     bool                m_shouldSelectFirstNoteOnNextNoteAddition;
 
     Account             m_currentAccount;
@@ -804,7 +804,10 @@ void NotebookItemView::onNotebookStackRenamed(
         expandedStacks.replace(previousStackIndex, newStackName);
     }
 
-    setStacksExpanded(expandedStacks, *pNotebookModel, linkedNotebookGuid);
+    QModelIndexList indexesToExpand;
+    appendStackIndexes(expandedStacks, *pNotebookModel, linkedNotebookGuid,
+                       indexesToExpand);
+    setItemsExpanded(indexesToExpand);
 
     QModelIndex newStackItemIndex =
         pNotebookModel->indexForNotebookStack(newStackName, linkedNotebookGuid);
@@ -1418,24 +1421,27 @@ void NotebookItemView::restoreNotebookModelItemsState(const NotebookModel & mode
 
     bool wasTrackingNotebookItemsState = m_trackingNotebookModelItemsState;
     m_trackingNotebookModelItemsState = false;
-    setStacksExpanded(expandedStacks, model, QString());
+    QModelIndexList indexesToExpand;
+    appendStackIndexes(expandedStacks, model, QString(), indexesToExpand);
 
     for(auto it = expandedStacksByLinkedNotebookGuid.constBegin(),
         end = expandedStacksByLinkedNotebookGuid.constEnd(); it != end; ++it)
     {
-        setStacksExpanded(it.value(), model, it.key());
+        appendStackIndexes(it.value(), model, it.key(), indexesToExpand);
     }
 
-    setLinkedNotebooksExpanded(expandedLinkedNotebookItemsGuids, model);
+    appendLinkedNotebookIndexes(expandedLinkedNotebookItemsGuids, model,
+                                indexesToExpand);
+    setItemsExpanded(indexesToExpand);
 
     m_trackingNotebookModelItemsState = wasTrackingNotebookItemsState;
 }
 
-void NotebookItemView::setStacksExpanded(
+void NotebookItemView::appendStackIndexes(
     const QStringList & expandedStackNames, const NotebookModel & model,
-    const QString & linkedNotebookGuid)
+    const QString & linkedNotebookGuid, QModelIndexList & indexes) const
 {
-    QNDEBUG("NotebookItemView::setStacksExpanded: "
+    QNDEBUG("NotebookItemView::appendStackIndexes: "
             << "linked notebook guid = " << linkedNotebookGuid);
 
     for(auto it = expandedStackNames.constBegin(),
@@ -1449,14 +1455,15 @@ void NotebookItemView::setStacksExpanded(
             continue;
         }
 
-        setExpanded(index, true);
+        indexes << index;
     }
 }
 
-void NotebookItemView::setLinkedNotebooksExpanded(
-    const QStringList & expandedLinkedNotebookGuids, const NotebookModel & model)
+void NotebookItemView::appendLinkedNotebookIndexes(
+    const QStringList & expandedLinkedNotebookGuids, const NotebookModel & model,
+    QModelIndexList & indexes) const
 {
-    QNDEBUG("NotebookItemView::setLinkedNotebooksExpanded: "
+    QNDEBUG("NotebookItemView::appendLinkedNotebookIndexes: "
             << expandedLinkedNotebookGuids.join(QStringLiteral(", ")));
 
     for(auto it = expandedLinkedNotebookGuids.constBegin(),
@@ -1470,7 +1477,7 @@ void NotebookItemView::setLinkedNotebooksExpanded(
             continue;
         }
 
-        setExpanded(index, true);
+        indexes << index;
     }
 }
 
@@ -119,13 +119,13 @@ private:
     void saveNotebookModelItemsState();
     void restoreNotebookModelItemsState(const NotebookModel & model);
 
-    void setStacksExpanded(
+    void appendStackIndexes(
         const QStringList & expandedStackNames, const NotebookModel & model,
-        const QString & linkedNotebookGuid);
+        const QString & linkedNotebookGuid, QModelIndexList & indexes) const;
 
-    void setLinkedNotebooksExpanded(
+    void appendLinkedNotebookIndexes(
         const QStringList & expandedLinkedNotebookGuids,
-        const NotebookModel & model);
+        const NotebookModel & model, QModelIndexList & indexes) const;
 
     void restoreFilteredNotebook(
         const NotebookModel & model);
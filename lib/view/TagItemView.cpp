@@ -1037,16 +1037,22 @@ void TagItemView::restoreTagItemsState(const TagModel & model)
     bool wasTrackingTagItemsState = m_trackingTagItemsState;
     m_trackingTagItemsState = false;
 
-    setTagsExpanded(expandedTagItemsLocalUids, model);
-    setLinkedNotebooksExpanded(expandedLinkedNotebookItemsGuids, model);
+    QModelIndexList indexesToExpand;
+    indexesToExpand.reserve(expandedTagItemsLocalUids.size() +
+                            expandedLinkedNotebookItemsGuids.size());
+    appendTagIndexes(expandedTagItemsLocalUids, model, indexesToExpand);
+    appendLinkedNotebookIndexes(expandedLinkedNotebookItemsGuids, model,
+                                indexesToExpand);
+    setItemsExpanded(indexesToExpand);
 
     m_trackingTagItemsState = wasTrackingTagItemsState;
 }
 
-void TagItemView::setTagsExpanded(
-    const QStringList & tagLocalUids, const TagModel & model)
+void TagItemView::appendTagIndexes(
+    const QStringList & tagLocalUids, const TagModel & model,
+    QModelIndexList & indexes) const
 {
-    QNDEBUG("TagItemView::setTagsExpanded: " << tagLocalUids.size()
+    QNDEBUG("TagItemView::appendTagIndexes: " << tagLocalUids.size()
             << ", tag local uids: "
             << tagLocalUids.join(QStringLiteral(",")));
 
@@ -1059,14 +1065,15 @@ void TagItemView::setTagsExpanded(
             continue;
         }
 
-        setExpanded(index, true);
+        indexes << index;
     }
 }
 
-void TagItemView::setLinkedNotebooksExpanded(
-    const QStringList & linkedNotebookGuids, const TagModel & model)
+void TagItemView::appendLinkedNotebookIndexes(
+    const QStringList & linkedNotebookGuids, const TagModel & model,
+    QModelIndexList & indexes) const
 {
-    QNDEBUG("TagItemView::setLinkedNotebooksExpanded: "
+    QNDEBUG("TagItemView::appendLinkedNotebookIndexes: "
             << linkedNotebookGuids.size()
             << ", linked notebook guids: "
             << linkedNotebookGuids.join(QStringLiteral(", ")));
@@ -1082,7 +1089,7 @@ void TagItemView::setLinkedNotebooksExpanded(
             continue;
         }
 
-        setExpanded(index, true);
+        indexes << index;
     }
 }
 
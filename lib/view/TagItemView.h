@@ -90,10 +90,14 @@ private:
 
     void saveTagItemsState();
     void restoreTagItemsState(const TagModel & model);
-    void setTagsExpanded(const QStringList & tagLocalUids, const TagModel & model);
 
-    void setLinkedNotebooksExpanded(
-        const QStringList & linkedNotebookGuids, const TagModel & model);
+    void appendTagIndexes(
+        const QStringList & tagLocalUids, const TagModel & model,
+        QModelIndexList & indexes) const;
+
+    void appendLinkedNotebookIndexes(
+        const QStringList & linkedNotebookGuids, const TagModel & model,
+        QModelIndexList & indexes) const;
 
     void restoreLastSavedSelection(const TagModel & model);
 
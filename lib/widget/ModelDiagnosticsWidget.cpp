@@ -0,0 +1,184 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ModelDiagnosticsWidget.h"
+
+#include <quentier/logging/QuentierLogger.h>
+#include <quentier/types/ErrorString.h>
+#include <quentier/utility/StandardPaths.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace quentier {
+
+ModelDiagnosticsWidget::ModelDiagnosticsWidget(QWidget * parent) :
+    QWidget(parent, Qt::Window),
+    m_pTreeWidget(new QTreeWidget(this)),
+    m_pStatusLabel(new QLabel(this)),
+    m_diagnostics()
+{
+    setWindowTitle(tr("Model diagnostics"));
+
+    m_pTreeWidget->setColumnCount(2);
+    m_pTreeWidget->setHeaderLabels(QStringList() << tr("Counter")
+                                   << tr("Value"));
+    m_pTreeWidget->header()->setSectionResizeMode(
+        0, QHeaderView::ResizeToContents);
+
+    m_pStatusLabel->hide();
+
+    QPushButton * pRefreshButton = new QPushButton(tr("Refresh"), this);
+    QPushButton * pResetButton = new QPushButton(tr("Reset"), this);
+    QPushButton * pExportButton =
+        new QPushButton(tr("Export to JSON") + QStringLiteral("..."), this);
+
+    QHBoxLayout * pButtonsLayout = new QHBoxLayout;
+    pButtonsLayout->addWidget(pRefreshButton);
+    pButtonsLayout->addWidget(pResetButton);
+    pButtonsLayout->addStretch();
+    pButtonsLayout->addWidget(pExportButton);
+
+    QVBoxLayout * pLayout = new QVBoxLayout(this);
+    pLayout->addWidget(m_pTreeWidget);
+    pLayout->addWidget(m_pStatusLabel);
+    pLayout->addLayout(pButtonsLayout);
+
+    QObject::connect(pRefreshButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSIGNAL(ModelDiagnosticsWidget,refreshRequested));
+    QObject::connect(pResetButton, QNSIGNAL(QPushButton,clicked),
+                     this, QNSIGNAL(ModelDiagnosticsWidget,resetRequested));
+    QObject::connect(pExportButton, QNSIGNAL(QPushButton,clicked),
+                     this,
+                     QNSLOT(ModelDiagnosticsWidget,onExportButtonPressed));
+}
+
+void ModelDiagnosticsWidget::setDiagnostics(QJsonObject diagnostics)
+{
+    QNDEBUG("ModelDiagnosticsWidget::setDiagnostics");
+
+    m_diagnostics = diagnostics;
+
+    m_pTreeWidget->clear();
+    for(auto it = m_diagnostics.constBegin(),
+        end = m_diagnostics.constEnd(); it != end; ++it)
+    {
+        addJsonValueItems(it.key(), it.value(), nullptr);
+    }
+
+    m_pTreeWidget->expandAll();
+}
+
+void ModelDiagnosticsWidget::onExportButtonPressed()
+{
+    QNDEBUG("ModelDiagnosticsWidget::onExportButtonPressed");
+
+    m_pStatusLabel->clear();
+    m_pStatusLabel->hide();
+
+    QString absoluteFilePath = QFileDialog::getSaveFileName(
+        this, tr("Export to JSON") + QStringLiteral("..."),
+        QDir(documentsPath()).absoluteFilePath(
+            QStringLiteral("quentier-model-diagnostics.json")));
+    if (absoluteFilePath.isEmpty()) {
+        QNDEBUG("No file was selected");
+        return;
+    }
+
+    QFile file(absoluteFilePath);
+    if (Q_UNLIKELY(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)))
+    {
+        ErrorString errorDescription(
+            QT_TR_NOOP("Can't export the model diagnostics: failed to open "
+                       "the file for writing"));
+        errorDescription.details() = file.errorString();
+        QNWARNING(errorDescription);
+        m_pStatusLabel->setText(errorDescription.localizedString());
+        m_pStatusLabel->show();
+        return;
+    }
+
+    QJsonObject diagnostics = m_diagnostics;
+    diagnostics[QStringLiteral("exportedAt")] =
+        QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    QJsonDocument document(diagnostics);
+    Q_UNUSED(file.write(document.toJson(QJsonDocument::Indented)))
+    file.close();
+}
+
+void ModelDiagnosticsWidget::addJsonValueItems(
+    const QString & name, const QJsonValue & value,
+    QTreeWidgetItem * pParentItem)
+{
+    QTreeWidgetItem * pItem = (pParentItem
+                               ? new QTreeWidgetItem(pParentItem)
+                               : new QTreeWidgetItem(m_pTreeWidget));
+    pItem->setText(0, name);
+
+    if (value.isObject())
+    {
+        QJsonObject object = value.toObject();
+        for(auto it = object.constBegin(),
+            end = object.constEnd(); it != end; ++it)
+        {
+            addJsonValueItems(it.key(), it.value(), pItem);
+        }
+
+        return;
+    }
+
+    if (value.isArray())
+    {
+        QJsonArray array = value.toArray();
+        for(int i = 0, size = array.size(); i < size; ++i)
+        {
+            QJsonValue element = array.at(i);
+
+            // Name the elements of arrays of models by the model name
+            QString elementName = QString::number(i);
+            if (element.isObject())
+            {
+                QJsonObject object = element.toObject();
+                QJsonValue modelName = object.value(QStringLiteral("model"));
+                if (modelName.isString()) {
+                    elementName = modelName.toString();
+                }
+            }
+
+            addJsonValueItems(elementName, element, pItem);
+        }
+
+        return;
+    }
+
+    pItem->setText(1, value.toVariant().toString());
+}
+
+} // namespace quentier
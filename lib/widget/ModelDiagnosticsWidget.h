@@ -0,0 +1,70 @@
+/*
+ * Copyright 2016-2019 Dmitry Ivanov
+ *
+ * This file is part of Quentier.
+ *
+ * Quentier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Quentier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Quentier. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef QUENTIER_LIB_WIDGET_MODEL_DIAGNOSTICS_WIDGET_H
+#define QUENTIER_LIB_WIDGET_MODEL_DIAGNOSTICS_WIDGET_H
+
+#include <quentier/utility/Macros.h>
+
+#include <QJsonObject>
+#include <QWidget>
+
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QJsonValue)
+QT_FORWARD_DECLARE_CLASS(QTreeWidget)
+QT_FORWARD_DECLARE_CLASS(QTreeWidgetItem)
+
+namespace quentier {
+
+/**
+ * @brief The ModelDiagnosticsWidget class displays the diagnostics collected
+ * by models (cache hits and misses, local storage requests and their latency)
+ * as a tree and allows to export them as JSON
+ *
+ * The widget doesn't collect the diagnostics itself: it requests them via
+ * signals and displays whatever is passed to setDiagnostics
+ */
+class ModelDiagnosticsWidget: public QWidget
+{
+    Q_OBJECT
+public:
+    explicit ModelDiagnosticsWidget(QWidget * parent = nullptr);
+
+Q_SIGNALS:
+    void refreshRequested();
+    void resetRequested();
+
+public Q_SLOTS:
+    void setDiagnostics(QJsonObject diagnostics);
+
+private Q_SLOTS:
+    void onExportButtonPressed();
+
+private:
+    void addJsonValueItems(const QString & name, const QJsonValue & value,
+                           QTreeWidgetItem * pParentItem);
+
+private:
+    QTreeWidget *   m_pTreeWidget;
+    QLabel *        m_pStatusLabel;
+    QJsonObject     m_diagnostics;
+};
+
+} // namespace quentier
+
+#endif // QUENTIER_LIB_WIDGET_MODEL_DIAGNOSTICS_WIDGET_H
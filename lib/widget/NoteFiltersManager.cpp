@@ -60,6 +60,9 @@ NoteFiltersManager::NoteFiltersManager(
     m_lastSearchString(),
     m_findNoteLocalUidsForSearchStringRequestId(),
     m_findNoteLocalUidsForSavedSearchQueryRequestId(),
+    m_noteLocalUidsBySavedSearchLocalUid(),
+    m_savedSearchQueryResultsCacheGeneration(0),
+    m_findNoteLocalUidsForSavedSearchQueryCacheGeneration(0),
     m_autoFilterNotebookWhenReady(false),
     m_noteSearchQueryValidated(false),
     m_isReady(false)
@@ -414,6 +417,22 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryCompleted(
             << requestId);
     QNTRACE("Note local uids: " << noteLocalUids.join(QStringLiteral(", ")));
 
+    if (isRequestForSavedSearch && !m_filteredSavedSearchLocalUid.isEmpty())
+    {
+        if (m_findNoteLocalUidsForSavedSearchQueryCacheGeneration ==
+            m_savedSearchQueryResultsCacheGeneration)
+        {
+            m_noteLocalUidsBySavedSearchLocalUid.insert(
+                m_filteredSavedSearchLocalUid, noteLocalUids);
+        }
+        else
+        {
+            QNDEBUG("The cache of saved search query results was invalidated "
+                    "while the request was in flight, won't cache the found "
+                    "note local uids");
+        }
+    }
+
     if (Q_UNLIKELY(!isRequestForSearchString &&
                    !m_filterBySavedSearchWidget.isEnabled()))
     {
@@ -491,6 +510,8 @@ void NoteFiltersManager::onFindNoteLocalUidsWithSearchQueryFailed(
 
 void NoteFiltersManager::onAddNoteComplete(Note note, QUuid requestId)
 {
+    clearSavedSearchQueryResultsCache();
+
     if (m_pNoteModel.isNull()) {
         return;
     }
@@ -505,6 +526,8 @@ void NoteFiltersManager::onUpdateNoteComplete(
     Note note, LocalStorageManager::UpdateNoteOptions options,
     QUuid requestId)
 {
+    clearSavedSearchQueryResultsCache();
+
     if (m_pNoteModel.isNull()) {
         return;
     }
@@ -518,12 +541,24 @@ void NoteFiltersManager::onUpdateNoteComplete(
     checkAndRefreshNotesSearchQuery();
 }
 
+void NoteFiltersManager::onExpungeNoteComplete(Note note, QUuid requestId)
+{
+    QNDEBUG("NoteFiltersManager::onExpungeNoteComplete: request id = "
+            << requestId);
+    QNTRACE(note);
+
+    clearSavedSearchQueryResultsCache();
+}
+
 void NoteFiltersManager::onExpungeNotebookComplete(
     Notebook notebook, QUuid requestId)
 {
     QNDEBUG("NoteFiltersManager::onExpungeNotebookComplete: notebook = "
             << notebook << ", request id = " << requestId);
 
+    // The notes from the expunged notebook were expunged as well
+    clearSavedSearchQueryResultsCache();
+
     if (!m_filterByNotebookWidget.isEnabled()) {
         QNDEBUG("Filter by notebook is overridden by either "
                 "search string or saved search filter");
@@ -556,6 +591,9 @@ void NoteFiltersManager::onExpungeTagComplete(
             << expungedChildTagLocalUids.join(QStringLiteral(", "))
             << ", request id = " << requestId);
 
+    // The expunged tags were removed from notes
+    clearSavedSearchQueryResultsCache();
+
     if (!m_filterByTagWidget.isEnabled()) {
         QNDEBUG("The filter by tags is overridden by either "
                 "search string or filter by saved search");
@@ -599,6 +637,9 @@ void NoteFiltersManager::onUpdateSavedSearchComplete(
     QNDEBUG("NoteFiltersManager::onUpdateSavedSearchComplete: search = "
             << search << "\nRequest id = " << requestId);
 
+    Q_UNUSED(m_noteLocalUidsBySavedSearchLocalUid.remove(search.localUid()))
+    ++m_savedSearchQueryResultsCacheGeneration;
+
     QString currentSavedSearchName = m_filterBySavedSearchWidget.currentText();
     if (currentSavedSearchName.isEmpty()) {
         QNDEBUG("No saved search name is set to the filter");
@@ -639,6 +680,9 @@ void NoteFiltersManager::onExpungeSavedSearchComplete(
     QNDEBUG("NoteFiltersManager::onExpungeSavedSearchComplete: search = "
             << search << "\nRequest id = " << requestId);
 
+    Q_UNUSED(m_noteLocalUidsBySavedSearchLocalUid.remove(search.localUid()))
+    ++m_savedSearchQueryResultsCacheGeneration;
+
     QString currentSavedSearchName = m_filterBySavedSearchWidget.currentText();
     if (currentSavedSearchName.isEmpty()) {
         QNDEBUG("No saved search name is set to the filter");
@@ -813,6 +857,13 @@ void NoteFiltersManager::createConnections()
                      QNSLOT(NoteFiltersManager,onUpdateNoteComplete,
                             Note,LocalStorageManager::UpdateNoteOptions,QUuid),
                      Qt::UniqueConnection);
+    QObject::connect(&m_localStorageManagerAsync,
+                     QNSIGNAL(LocalStorageManagerAsync,expungeNoteComplete,
+                              Note,QUuid),
+                     this,
+                     QNSLOT(NoteFiltersManager,onExpungeNoteComplete,
+                            Note,QUuid),
+                     Qt::UniqueConnection);
 }
 
 void NoteFiltersManager::evaluate()
@@ -1000,10 +1051,36 @@ bool NoteFiltersManager::setFilterBySavedSearch()
         return false;
     }
 
-    NoteSearchQuery query;
-    ErrorString errorDescription;
-    bool res = query.setQueryString(pItem->m_query, errorDescription);
-    if (Q_UNLIKELY(!res)) {
+    m_filteredSavedSearchLocalUid = pItem->m_localUid;
+
+    auto cachedResultsIt =
+        m_noteLocalUidsBySavedSearchLocalUid.constFind(pItem->m_localUid);
+    if (cachedResultsIt != m_noteLocalUidsBySavedSearchLocalUid.constEnd())
+    {
+        QNDEBUG("Using the cached note local uids found by the saved "
+                << "search's query: " << *pItem);
+
+        // Invalidate the active request to find note local uids per saved
+        // search's query (if there was any)
+        m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid();
+
+        m_pNoteModel->setFilteredNoteLocalUids(cachedResultsIt.value());
+
+        m_filterByTagWidget.setDisabled(true);
+        m_filterByNotebookWidget.setDisabled(true);
+
+        return true;
+    }
+
+    // The saved search model parses the query when the item is loaded or
+    // updated; if the parsed query is empty, the query is invalid so parse it
+    // here once again only to report the error
+    NoteSearchQuery query = pItem->m_noteSearchQuery;
+    if (Q_UNLIKELY(query.isEmpty()))
+    {
+        ErrorString errorDescription;
+        Q_UNUSED(query.setQueryString(pItem->m_query, errorDescription))
+
         ErrorString error(QT_TR_NOOP("Internal error: can't set the filter by "
                                      "saved search: failed to parse "
                                      "the saved search query"));
@@ -1012,13 +1089,14 @@ bool NoteFiltersManager::setFilterBySavedSearch()
         error.details() = errorDescription.details();
         QNWARNING(error << ", saved search item: " << *pItem);
         Q_EMIT notifyError(error);
+        m_filteredSavedSearchLocalUid.clear();
         m_pNoteModel->clearFilteredNoteLocalUids();
         return false;
     }
 
-    m_filteredSavedSearchLocalUid = pItem->m_localUid;
-
     m_findNoteLocalUidsForSavedSearchQueryRequestId = QUuid::createUuid();
+    m_findNoteLocalUidsForSavedSearchQueryCacheGeneration =
+        m_savedSearchQueryResultsCacheGeneration;
     QNTRACE("Emitting the request to find note local uids "
             << "corresponding to the saved search: request id = "
             << m_findNoteLocalUidsForSavedSearchQueryRequestId
@@ -1200,6 +1278,13 @@ void NoteFiltersManager::checkAndRefreshNotesSearchQuery()
     }
 }
 
+void NoteFiltersManager::clearSavedSearchQueryResultsCache()
+{
+    QNDEBUG("NoteFiltersManager::clearSavedSearchQueryResultsCache");
+    m_noteLocalUidsBySavedSearchLocalUid.clear();
+    ++m_savedSearchQueryResultsCacheGeneration;
+}
+
 bool NoteFiltersManager::setAutomaticFilterByNotebook()
 {
     QNDEBUG("NoteFiltersManager::setAutomaticFilterByNotebook");
@@ -23,6 +23,7 @@
 #include <quentier/local_storage/NoteSearchQuery.h>
 #include <quentier/local_storage/LocalStorageManagerAsync.h>
 
+#include <QHash>
 #include <QObject>
 #include <QPointer>
 #include <QUuid>
@@ -121,7 +122,9 @@ private Q_SLOTS:
         Note note, LocalStorageManager::UpdateNoteOptions options,
         QUuid requestId);
 
-    // NOTE: note model will deal with notes expunges on its own
+    // NOTE: note model will deal with notes expunges on its own, here only
+    // the cached results of saved searches' queries are invalidated
+    void onExpungeNoteComplete(Note note, QUuid requestId);
 
     // NOTE: don't care of notebook updates because the filtering by notebook
     // is done by its local uid anyway
@@ -156,6 +159,8 @@ private:
 
     void checkAndRefreshNotesSearchQuery();
 
+    void clearSavedSearchQueryResultsCache();
+
     bool setAutomaticFilterByNotebook();
 
 private:
@@ -174,6 +179,16 @@ private:
     QUuid           m_findNoteLocalUidsForSearchStringRequestId;
     QUuid           m_findNoteLocalUidsForSavedSearchQueryRequestId;
 
+    // Note local uids found by saved searches' queries by saved search local
+    // uids; any change of notes invalidates all of them
+    QHash<QString, QStringList>     m_noteLocalUidsBySavedSearchLocalUid;
+
+    // Incremented on each invalidation of the cache above; the results of
+    // the request to find note local uids per saved search's query are only
+    // cached if no invalidation occurred while the request was in flight
+    quint64         m_savedSearchQueryResultsCacheGeneration;
+    quint64         m_findNoteLocalUidsForSavedSearchQueryCacheGeneration;
+
     bool            m_autoFilterNotebookWhenReady;
 
     bool            m_noteSearchQueryValidated;